@@ -76,35 +76,52 @@ struct CSRConfiguration {
     
 }
 
-class CSRRequestor: NSObject, ObservableObject, URLSessionDelegate {
+class CSRRequestor: NSObject, ObservableObject {
     @Published var enrollmentStatus: CSREnrollmentStatus = CSREnrollmentStatus.NotStarted;
 
     var derEncodedCertificate: [UInt8] = []
     var derEncodedPrivateKey: Data = Data()
     var config = CSRConfiguration()
+    // Shared by the config and CSR requests so they use one connection
+    var httpClient = EnrollmentHTTPClient()
+    private var currentTask: EnrollmentHTTPTask?
+    // Saved to the keychain for the CSR in flight. It's deleted again unless
+    // a signed certificate comes back for it, so failed attempts don't pile up.
+    private var storedPrivateKey: SecKey?
+    // A background renewal swaps the new identity in without dropping the
+    // current connection; it's used from the next reconnect
+    var isRenewal = false
     
     var tlsConfigPath = TAKConstants.CERT_CONFIG_PATH
     var csrRequestPath = TAKConstants.certificateSigningPath(
         clientUid: AppConstants.getClientID(),
         appVersion: AppConstants.getAppReleaseAndBuildVersion())
     
-    func urlSession(_ session: URLSession, didReceive challenge: URLAuthenticationChallenge, completionHandler: @escaping (URLSession.AuthChallengeDisposition, URLCredential?) -> Void) {
-            if (challenge.protectionSpace.authenticationMethod == NSURLAuthenticationMethodClientCertificate) {
-                TAKLogger.debug("[CSRRequestor] CSR Request recieved a client auth challenge. Rejecting.")
-                completionHandler(.rejectProtectionSpace, nil)
-            }
-            if (challenge.protectionSpace.authenticationMethod == NSURLAuthenticationMethodServerTrust) {
-                TAKLogger.debug("[CSRRequestor] Auth Trust challenge for \(challenge.protectionSpace.host)")
-                guard let serverTrust = challenge.protectionSpace.serverTrust else {
-                    TAKLogger.debug("[CSRRequestor] No Server Trust in Auth Trust Challenge. Using default handling.")
-                    completionHandler(.performDefaultHandling, nil)
-                    return
-                }
-
-                let credential = URLCredential(trust: serverTrust)
-                challenge.sender?.use(credential, for: challenge)
-                completionHandler(.useCredential, credential)
+    // Records what came back, for logEnrollmentError
+    func recordResult(_ result: EnrollmentHTTPResult) {
+        switch result {
+        case .success(let success):
+            config.responseData = success.data
+            config.response = success.response
+            config.error = nil
+        case .failure(.httpStatus(_, let response, let data)):
+            config.responseData = data
+            config.response = response
+            config.error = nil
+        case .failure(let failure):
+            config.responseData = nil
+            config.response = nil
+            if case .transport(let urlError) = failure {
+                config.error = urlError
+            } else {
+                config.error = failure
             }
+        }
+    }
+    
+    func cancelEnrollment() {
+        currentTask?.cancel()
+        currentTask = nil
     }
     
     func generateAuthHeaderString() -> String {
@@ -127,6 +144,7 @@ class CSRRequestor: NSObject, ObservableObject, URLSessionDelegate {
     }
     
     func logEnrollmentError() {
+        discardStoredPrivateKey()
         config.didError = true
         TAKLogger.error("[CSRRequestor] Error: \(config.error.debugDescription)")
         TAKLogger.error("[CSRRequestor] Response: \(String(describing: config.response))")
@@ -211,30 +229,49 @@ class CSRRequestor: NSObject, ObservableObject, URLSessionDelegate {
                 if let certString = dictionary["signedCert"] {
                     let derData = certStringToDER(certString: certString)
                     SettingsStore.global.userCertificate = derData
-                    TAKLogger.debug("[CSRRequestor]: Attemping to add Identity")
-                    try CertificateManager.addIdentity(clientCertificate: derData, label: SettingsStore.global.takServerUrl)
+                    if(isRenewal) {
+                        TAKLogger.debug("[CSRRequestor]: Attemping to replace Identity")
+                        try CertificateManager.replaceIdentity(clientCertificate: derData, label: SettingsStore.global.takServerUrl)
+                    } else {
+                        TAKLogger.debug("[CSRRequestor]: Attemping to add Identity")
+                        try CertificateManager.addIdentity(clientCertificate: derData, label: SettingsStore.global.takServerUrl)
+                        SettingsStore.global.serverCertificate = Data()
+                        SettingsStore.global.takServerChanged = true
+                    }
                     
                     TAKLogger.debug("[CSRRequestor]: Identity Added")
-                    SettingsStore.global.serverCertificate = Data()
-                    SettingsStore.global.takServerChanged = true
+                    storedPrivateKey = nil
                     self.enrollmentStatus = CSREnrollmentStatus.Succeeded
+                } else {
+                    TAKLogger.error("[CSRRequestor] No signed certificate in the CSR response")
+                    discardStoredPrivateKey()
+                    self.enrollmentStatus = CSREnrollmentStatus.Failed
                 }
                 
                 SettingsStore.global.serverCertificateTruststore = trustChain
+            } else {
+                TAKLogger.error("[CSRRequestor] CSR response was not a JSON object")
+                discardStoredPrivateKey()
+                self.enrollmentStatus = CSREnrollmentStatus.Failed
             }
         } catch let error as NSError {
             TAKLogger.error("[CSRRequestor] Could not parse the cert")
             TAKLogger.error(error.debugDescription)
+            discardStoredPrivateKey()
             self.enrollmentStatus = CSREnrollmentStatus.Failed
         }
     }
     
+    func discardStoredPrivateKey() {
+        guard let privateKey = storedPrivateKey else { return }
+        TAKLogger.debug("[CSRRequestor]: Deleting the private key for the failed enrollment")
+        CertificateManager.deletePrivateKey(privateKey)
+        storedPrivateKey = nil
+    }
+    
     func makeCSRRequest() {
         // create the request
         var csrRequest = generateCSRRequest()
-        let session = URLSession(configuration: URLSessionConfiguration.ephemeral,
-                                               delegate: self,
-                                               delegateQueue: OperationQueue.main)
         
         self.generateSigningRequest(
             commonName: SettingsStore.global.takServerUsername,
@@ -251,68 +288,59 @@ class CSRRequestor: NSObject, ObservableObject, URLSessionDelegate {
         
         self.enrollmentStatus = CSREnrollmentStatus.Enrolling
         
-        // TODO: Actually let the user know this failed if it, uh, fails
-        let task = session.dataTask(with: csrRequest) { data, response, error in
-            self.config.responseData = data
-            self.config.response = response
-            self.config.error = error
+        currentTask = httpClient.send(csrRequest) { result in
+            self.currentTask = nil
+            self.recordResult(result)
             
-            if error != nil {
-                self.logEnrollmentError()
-                return
-            }
-            guard let response = response as? HTTPURLResponse,
-                (200...299).contains(response.statusCode) else {
+            switch result {
+            case .failure(.cancelled):
+                TAKLogger.debug("[CSRRequestor] Certificate Enrollment cancelled")
+                self.discardStoredPrivateKey()
+                self.enrollmentStatus = CSREnrollmentStatus.NotStarted
+            case .failure:
                 self.logEnrollmentError()
-                return
-            }
-            if let mimeType = response.mimeType,
-                (mimeType == "application/json" || mimeType == "text/plain"),
-                let data = data,
-                let dataString = String(data: data, encoding: .utf8) {
-                self.storeCSRResponse(data: data, dataString: dataString)
-            } else {
-                TAKLogger.error("Unknown response from server when attempting Certificate Enrollment")
-                self.enrollmentStatus = CSREnrollmentStatus.Failed
+            case .success(let success):
+                if let mimeType = success.response.mimeType,
+                    (mimeType == "application/json" || mimeType == "text/plain"),
+                    let dataString = String(data: success.data, encoding: .utf8) {
+                    self.storeCSRResponse(data: success.data, dataString: dataString)
+                } else {
+                    TAKLogger.error("Unknown response from server when attempting Certificate Enrollment")
+                    self.discardStoredPrivateKey()
+                    self.enrollmentStatus = CSREnrollmentStatus.Failed
+                }
             }
         }
-        task.resume()
     }
     
     func beginEnrollment() {
+        cancelEnrollment()
         enrollmentStatus = CSREnrollmentStatus.Connecting
         
         // Retrieve the TLS Config Variables
         let caConfigRequest = generateConfigRequest()
-        let caConfigSession = URLSession(configuration: URLSessionConfiguration.ephemeral,
-                                               delegate: self,
-                                               delegateQueue: OperationQueue.main)
-        let caConfigTask = caConfigSession.dataTask(with: caConfigRequest) { data, response, error in
-            self.config.responseData = data
-            self.config.response = response
-            self.config.error = error
+        currentTask = httpClient.send(caConfigRequest) { result in
+            self.currentTask = nil
+            self.recordResult(result)
             
-            if error != nil {
-                self.logEnrollmentError()
-                return
-            }
-            guard let response = response as? HTTPURLResponse,
-                (200...299).contains(response.statusCode) else {
-                self.logEnrollmentError()
-                return
-            }
-            if let mimeType = response.mimeType,
-                mimeType == "text/plain",
-                let data = data,
-                let dataString = String(data: data, encoding: .utf8) {
-                self.processConfigResponse(data: data, dataString: dataString)
-                self.makeCSRRequest()
-            } else {
-                TAKLogger.error("[CSRRequestor] Unknown response from server when attempting CA Config")
+            switch result {
+            case .failure(.cancelled):
+                TAKLogger.debug("[CSRRequestor] CA Config request cancelled")
+                self.enrollmentStatus = CSREnrollmentStatus.NotStarted
+            case .failure:
                 self.logEnrollmentError()
+            case .success(let success):
+                if let mimeType = success.response.mimeType,
+                    mimeType == "text/plain",
+                    let dataString = String(data: success.data, encoding: .utf8) {
+                    self.processConfigResponse(data: success.data, dataString: dataString)
+                    self.makeCSRRequest()
+                } else {
+                    TAKLogger.error("[CSRRequestor] Unknown response from server when attempting CA Config")
+                    self.logEnrollmentError()
+                }
             }
         }
-        caConfigTask.resume()
     }
     
     func generateSigningRequest(commonName: String,
@@ -321,11 +349,22 @@ class CSRRequestor: NSObject, ObservableObject, URLSessionDelegate {
                                 organizationUnitName: String) {
         do {
             let privateKeyTag = "tak.flighttactics.com-\(hostName)-pk"
+            let keyType = CertificateKeyType(rawValue: SettingsStore.global.enrollmentKeyType) ?? .rsa2048
             
-            let certData = try CertificateManager.generateTaggedPrivateKey(privateKeyTag: privateKeyTag)
-            let swiftCryptoKey = try _RSA.Signing.PrivateKey(derRepresentation: certData)
+            // Usually generated in the background when the enrollment screen opened
+            let privateKey = try PrivateKeyPool.global.takeKey(keyType: keyType)
+            discardStoredPrivateKey()
+            let keyData = try CertificateManager.storePrivateKey(privateKey, privateKeyTag: privateKeyTag)
+            storedPrivateKey = privateKey
 
-            generateSigningRequest(commonName: commonName, hostName: hostName, organizationName: organizationName, organizationUnitName: organizationUnitName, privateKey: swiftCryptoKey)
+            switch keyType {
+            case .rsa2048:
+                let swiftCryptoKey = try _RSA.Signing.PrivateKey(derRepresentation: keyData)
+                generateSigningRequest(commonName: commonName, hostName: hostName, organizationName: organizationName, organizationUnitName: organizationUnitName, privateKey: swiftCryptoKey)
+            case .ecdsaP256:
+                let swiftCryptoKey = try P256.Signing.PrivateKey(x963Representation: keyData)
+                generateSigningRequest(commonName: commonName, hostName: hostName, organizationName: organizationName, organizationUnitName: organizationUnitName, privateKey: swiftCryptoKey)
+            }
 
         } catch let error as NSError {
             TAKLogger.error("[CSRRequestor] Could not create the CSR")
@@ -338,10 +377,34 @@ class CSRRequestor: NSObject, ObservableObject, URLSessionDelegate {
                                 organizationName: String,
                                 organizationUnitName: String,
                                 privateKey: _RSA.Signing.PrivateKey) {
+        generateSigningRequest(commonName: commonName,
+                               organizationName: organizationName,
+                               organizationUnitName: organizationUnitName,
+                               key: Certificate.PrivateKey(privateKey),
+                               signatureAlgorithm: .sha256WithRSAEncryption,
+                               derEncodedPrivateKey: privateKey.derRepresentation)
+    }
+    
+    func generateSigningRequest(commonName: String,
+                                hostName: String,
+                                organizationName: String,
+                                organizationUnitName: String,
+                                privateKey: P256.Signing.PrivateKey) {
+        generateSigningRequest(commonName: commonName,
+                               organizationName: organizationName,
+                               organizationUnitName: organizationUnitName,
+                               key: Certificate.PrivateKey(privateKey),
+                               signatureAlgorithm: .ecdsaWithSHA256,
+                               derEncodedPrivateKey: privateKey.derRepresentation)
+    }
+    
+    private func generateSigningRequest(commonName: String,
+                                        organizationName: String,
+                                        organizationUnitName: String,
+                                        key: Certificate.PrivateKey,
+                                        signatureAlgorithm: Certificate.SignatureAlgorithm,
+                                        derEncodedPrivateKey: Data) {
         do {
-
-            let key = Certificate.PrivateKey(privateKey)
-
             let subjectName = try DistinguishedName {
                 CommonName(commonName)
                 OrganizationName(organizationName)
@@ -355,14 +418,14 @@ class CSRRequestor: NSObject, ObservableObject, URLSessionDelegate {
                 subject: subjectName,
                 privateKey: key,
                 attributes: CertificateSigningRequest.Attributes(),
-                signatureAlgorithm: .sha256WithRSAEncryption)
+                signatureAlgorithm: signatureAlgorithm)
             
             TAKLogger.debug("[CSRRequestor] Serializing")
             var serializer = DER.Serializer()
             try serializer.serialize(csr)
 
             derEncodedCertificate = serializer.serializedBytes
-            derEncodedPrivateKey = privateKey.derRepresentation
+            self.derEncodedPrivateKey = derEncodedPrivateKey
         } catch let error as NSError {
             TAKLogger.error("[CSRRequestor] Could not create the CSR")
             TAKLogger.error(error.debugDescription)
@@ -36,44 +36,102 @@ enum KeychainError: Error {
     case cannotCreateIdentityPersistentRef(OSStatus)
     
     case cannotAddCertificateToKeychain(OSStatus)
+    
+    case cannotAddPrivateKeyToKeychain(OSStatus)
+    
+    case cannotExportPrivateKey(any Error)
+}
+
+enum CertificateKeyType: String, CaseIterable {
+    case rsa2048
+    // Much faster to generate and sign with, for servers that accept EC client certificates
+    case ecdsaP256
+    
+    var secAttrKeyType: CFString {
+        switch self {
+        case .rsa2048: return kSecAttrKeyTypeRSA
+        case .ecdsaP256: return kSecAttrKeyTypeECSECPrimeRandom
+        }
+    }
+    
+    var keySizeInBits: Int {
+        switch self {
+        case .rsa2048: return 2048
+        case .ecdsaP256: return 256
+        }
+    }
+    
+    var displayName: String {
+        switch self {
+        case .rsa2048: return "RSA 2048"
+        case .ecdsaP256: return "ECDSA P-256"
+        }
+    }
 }
 
 // Code adapted from https://stackoverflow.com/a/50321496
 class CertificateManager {
     // Returns the private key binary data in ASN1 format (DER encoded without the key usage header)
-    static func generateTaggedPrivateKey(privateKeyTag: String) throws -> Data {
+    // for RSA, or the X9.63 representation for EC
+    static func generateTaggedPrivateKey(privateKeyTag: String, keyType: CertificateKeyType = .rsa2048) throws -> Data {
+        let privateKey = try generatePrivateKey(keyType: keyType)
+        return try storePrivateKey(privateKey, privateKeyTag: privateKeyTag)
+    }
+    
+    // Generates a key pair in memory only. It isn't written to the keychain
+    // until storePrivateKey, so a key generated ahead of time and never used
+    // leaves nothing behind.
+    static func generatePrivateKey(keyType: CertificateKeyType) throws -> SecKey {
         var error: Unmanaged<CFError>?
 
-        let privateKeyAttr: [NSString: Any] = [
-            kSecAttrApplicationTag: privateKeyTag.data(using: .utf8)!,
-            kSecAttrAccessible: kSecAttrAccessibleAfterFirstUnlockThisDeviceOnly,
-            kSecAttrIsPermanent: true ]
-
         let keyPairAttr: [NSString: Any] = [
-            kSecAttrKeyType: kSecAttrKeyTypeRSA,
-            kSecAttrKeySizeInBits: 2048,
-            kSecPrivateKeyAttrs: privateKeyAttr ]
+            kSecAttrKeyType: keyType.secAttrKeyType,
+            kSecAttrKeySizeInBits: keyType.keySizeInBits,
+            kSecPrivateKeyAttrs: [kSecAttrIsPermanent: false] ]
         
+        let startedAt = DispatchTime.now()
         guard let privateKey = SecKeyCreateRandomKey(keyPairAttr as CFDictionary, &error) else {
             throw KeychainError.generateKeyPairFailed(error!.takeRetainedValue() as Error)
         }
-
-        let findPrivKeyArgs: [NSString: Any] = [
+        let elapsedMilliseconds = Double(DispatchTime.now().uptimeNanoseconds - startedAt.uptimeNanoseconds) / 1_000_000
+        TAKLogger.debug("[CertificateManager]: Generated \(keyType.displayName) key in \(String(format: "%.1f", elapsedMilliseconds))ms")
+        return privateKey
+    }
+    
+    // Saves the private key under the tag so the certificate later issued for
+    // it pairs with it as an identity, and returns the key's binary data
+    static func storePrivateKey(_ privateKey: SecKey, privateKeyTag: String) throws -> Data {
+        let addArgs: [NSString: Any] = [
             kSecClass: kSecClassKey,
             kSecValueRef: privateKey,
-            kSecAttrKeyType: kSecAttrKeyTypeRSA,
-            kSecReturnData: true ]
-
-        var resultRef:AnyObject?
-        let status = SecItemCopyMatching(findPrivKeyArgs as CFDictionary, &resultRef)
-        guard status == errSecSuccess, let privateKeyData = resultRef as? Data else {
-            TAKLogger.error("Private Key not found: \(status))")
-            throw KeychainError.privateKeyNotFound(status)
+            kSecAttrApplicationTag: privateKeyTag.data(using: .utf8)!,
+            kSecAttrAccessible: kSecAttrAccessibleAfterFirstUnlockThisDeviceOnly ]
+        
+        let status = SecItemAdd(addArgs as CFDictionary, nil)
+        guard status == errSecSuccess else {
+            TAKLogger.error("[CertificateManager]: Failed to add private key to keychain, error: \(status)")
+            throw KeychainError.cannotAddPrivateKeyToKeychain(status)
+        }
+        
+        var error: Unmanaged<CFError>?
+        guard let privateKeyData = SecKeyCopyExternalRepresentation(privateKey, &error) as Data? else {
+            throw KeychainError.cannotExportPrivateKey(error!.takeRetainedValue() as Error)
         }
 
         return privateKeyData
     }
     
+    // Removes a key saved by storePrivateKey that no certificate was issued for
+    static func deletePrivateKey(_ privateKey: SecKey) {
+        let deleteArgs: [NSString: Any] = [
+            kSecClass: kSecClassKey,
+            kSecValueRef: privateKey ]
+        let status = SecItemDelete(deleteArgs as CFDictionary)
+        if(status != errSecSuccess && status != errSecItemNotFound) {
+            TAKLogger.error("[CertificateManager]: Failed to delete private key from keychain, error: \(status)")
+        }
+    }
+    
     static func generatePrivateKeyUsingPublicKeyHash(publicKeyHash: Data) throws {
         var error: Unmanaged<CFError>?
 
@@ -117,7 +175,58 @@ class CertificateManager {
     static func addIdentity(clientCertificate: Data, label: String) throws {
         TAKLogger.debug("[CertificateManager]: Clearing existing certs")
         clearAllCertsAndIdentities()
+        try addCertificate(clientCertificate: clientCertificate, label: label)
+    }
+    
+    // Installs a renewed certificate alongside the identity it replaces and
+    // only then removes the old certificate and its private key, so a
+    // connection made at any point finds a valid identity under the label
+    static func replaceIdentity(clientCertificate: Data, label: String) throws {
+        let previousCertificates = certificatePersistentRefs(label: label)
+        var previousKey: SecKey?
+        if let previousIdentity = getIdentity(label: label) {
+            SecIdentityCopyPrivateKey(previousIdentity, &previousKey)
+        }
+        
+        try addCertificate(clientCertificate: clientCertificate, label: label)
         
+        for persistentRef in previousCertificates {
+            let deleteArgs: [NSString: Any] = [
+                kSecClass: kSecClassCertificate,
+                kSecValuePersistentRef: persistentRef ]
+            SecItemDelete(deleteArgs as CFDictionary)
+        }
+        
+        // The renewed certificate is for a new key, unless the CA reissued for the old one
+        if let previousKey = previousKey,
+           let previousPublicKey = SecKeyCopyPublicKey(previousKey),
+           let newCertificate = SecCertificateCreateWithData(kCFAllocatorDefault, clientCertificate as CFData),
+           let newPublicKey = SecCertificateCopyKey(newCertificate),
+           SecKeyCopyExternalRepresentation(previousPublicKey, nil) as Data? != SecKeyCopyExternalRepresentation(newPublicKey, nil) as Data? {
+            let deleteArgs: [NSString: Any] = [
+                kSecClass: kSecClassKey,
+                kSecValueRef: previousKey ]
+            SecItemDelete(deleteArgs as CFDictionary)
+        }
+        TAKLogger.info("[CertificateManager]: Replaced identity for \(label)")
+    }
+    
+    static func certificatePersistentRefs(label: String) -> [Data] {
+        let copyArgs: [NSString: Any] = [
+            kSecClass: kSecClassCertificate,
+            kSecAttrLabel: label,
+            kSecMatchLimit: kSecMatchLimitAll,
+            kSecReturnPersistentRef: true ]
+        
+        var resultRef: AnyObject?
+        let copyStatus = SecItemCopyMatching(copyArgs as CFDictionary, &resultRef)
+        guard copyStatus == errSecSuccess else {
+            return []
+        }
+        return resultRef as? [Data] ?? []
+    }
+    
+    private static func addCertificate(clientCertificate: Data, label: String) throws {
         TAKLogger.debug("[CertificateManager]: Adding client certificate to keychain with label \(label)")
         guard let certificateRef = SecCertificateCreateWithData(kCFAllocatorDefault, clientCertificate as CFData) else {
             TAKLogger.error("[CertificateManager]: Could not create certificate, data was not valid DER encoded X509 cert")
@@ -0,0 +1,185 @@
+//
+//  CertificateRenewalScheduler.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Combine
+import Foundation
+import X509
+
+// Renews the enrolled client certificate before it expires.
+//
+// Once the stored identity is within the renewal window of its expiry, the
+// CSR flow is run again in the background with the saved enrollment
+// credentials. The key for it starts generating KEY_PREPARE_LEAD ahead of
+// that, so it's ready when the CSR is built. The new identity is installed
+// next to the old one and the old one removed (see
+// CertificateManager.replaceIdentity), so the live connection carries on
+// and the next reconnect picks up the new certificate.
+//
+// A failed renewal is retried every RETRY_INTERVAL for as long as the
+// window lasts. Timers don't fire while the app is suspended, so evaluate
+// is also called when the app comes back to the foreground. Use from the
+// main queue.
+class CertificateRenewalScheduler {
+    static let SECONDS_PER_DAY: TimeInterval = 24 * 60 * 60
+    static let KEY_PREPARE_LEAD: TimeInterval = 5 * 60
+    static let RETRY_INTERVAL: TimeInterval = 15 * 60
+
+    private(set) var isRenewing = false
+    private(set) var nextCheckDate: Date?
+    private(set) var lastRenewalSucceeded: Bool?
+    private var lastAttemptDate: Date?
+
+    private let configuredRenewalWindow: TimeInterval?
+    private let expiryProvider: () -> Date?
+    private let makeRequestor: () -> CSRRequestor
+    private let now: () -> Date
+    private var timer: DispatchSourceTimer?
+    private var requestor: CSRRequestor?
+    private var statusCancellable: AnyCancellable?
+
+    var renewalWindow: TimeInterval {
+        return configuredRenewalWindow ?? SettingsStore.global.certificateRenewalWindowDays * CertificateRenewalScheduler.SECONDS_PER_DAY
+    }
+
+    init(renewalWindow: TimeInterval? = nil,
+         expiryProvider: @escaping () -> Date? = { CertificateRenewalScheduler.identityExpiry(label: SettingsStore.global.takServerUrl) },
+         makeRequestor: @escaping () -> CSRRequestor = { CSRRequestor() },
+         now: @escaping () -> Date = { Date.now }) {
+        self.configuredRenewalWindow = renewalWindow
+        self.expiryProvider = expiryProvider
+        self.makeRequestor = makeRequestor
+        self.now = now
+    }
+
+    deinit {
+        timer?.cancel()
+    }
+
+    // When the certificate behind the identity stops being valid
+    static func identityExpiry(label: String) -> Date? {
+        guard let identity = CertificateManager.getIdentity(label: label) else {
+            return nil
+        }
+        var certificate: SecCertificate?
+        guard SecIdentityCopyCertificate(identity, &certificate) == errSecSuccess, let certificate = certificate else {
+            return nil
+        }
+        let derData = SecCertificateCopyData(certificate) as Data
+        do {
+            return try Certificate(derEncoded: Array(derData)).notValidAfter
+        } catch {
+            TAKLogger.error("[CertificateRenewalScheduler]: Unable to read identity certificate: \(error)")
+            return nil
+        }
+    }
+
+    func start() {
+        evaluate()
+    }
+
+    func stop() {
+        statusCancellable = nil
+        requestor?.cancelEnrollment()
+        requestor = nil
+        isRenewing = false
+        schedule(at: nil)
+    }
+
+    // Renews if the certificate is in its window, otherwise sets a timer
+    // for when there's next something to do
+    func evaluate() {
+        if(isRenewing) {
+            return
+        }
+        guard let expiry = expiryProvider() else {
+            schedule(at: nil)
+            return
+        }
+        let renewAt = expiry.addingTimeInterval(-renewalWindow)
+        let currentTime = now()
+
+        if(currentTime >= renewAt.addingTimeInterval(-CertificateRenewalScheduler.KEY_PREPARE_LEAD)) {
+            PrivateKeyPool.global.prepare(keyType: keyType)
+        }
+        if(currentTime >= renewAt) {
+            // Also keeps a CA that issues certificates shorter than the
+            // window from being asked over and over
+            if let lastAttemptDate = lastAttemptDate,
+               currentTime < lastAttemptDate.addingTimeInterval(CertificateRenewalScheduler.RETRY_INTERVAL) {
+                schedule(at: lastAttemptDate.addingTimeInterval(CertificateRenewalScheduler.RETRY_INTERVAL))
+            } else {
+                renew(expiry: expiry)
+            }
+        } else if(currentTime >= renewAt.addingTimeInterval(-CertificateRenewalScheduler.KEY_PREPARE_LEAD)) {
+            schedule(at: renewAt)
+        } else {
+            schedule(at: renewAt.addingTimeInterval(-CertificateRenewalScheduler.KEY_PREPARE_LEAD))
+        }
+    }
+
+    private var keyType: CertificateKeyType {
+        return CertificateKeyType(rawValue: SettingsStore.global.enrollmentKeyType) ?? .rsa2048
+    }
+
+    private func renew(expiry: Date) {
+        if(SettingsStore.global.takServerUsername.isEmpty) {
+            // Identities from data packages have no enrollment credentials to renew with
+            TAKLogger.info("[CertificateRenewalScheduler]: Certificate expires \(expiry) but there are no enrollment credentials to renew it")
+            schedule(at: nil)
+            return
+        }
+
+        TAKLogger.info("[CertificateRenewalScheduler]: Certificate expires \(expiry), renewing")
+        isRenewing = true
+        lastAttemptDate = now()
+        schedule(at: nil)
+        let requestor = makeRequestor()
+        requestor.isRenewal = true
+        self.requestor = requestor
+        statusCancellable = requestor.$enrollmentStatus
+            .dropFirst()
+            .receive(on: DispatchQueue.main)
+            .sink { [weak self] status in
+                switch status {
+                case .Succeeded: self?.finishRenewal(succeeded: true)
+                case .Failed, .Untrusted, .NotStarted: self?.finishRenewal(succeeded: false)
+                default: return
+                }
+            }
+        requestor.beginEnrollment()
+    }
+
+    private func finishRenewal(succeeded: Bool) {
+        guard isRenewing else { return }
+        isRenewing = false
+        lastRenewalSucceeded = succeeded
+        statusCancellable = nil
+        requestor = nil
+
+        if(succeeded) {
+            TAKLogger.info("[CertificateRenewalScheduler]: Certificate renewed")
+        } else {
+            TAKLogger.error("[CertificateRenewalScheduler]: Certificate renewal failed, retrying in \(CertificateRenewalScheduler.RETRY_INTERVAL)s")
+        }
+        evaluate()
+    }
+
+    private func schedule(at date: Date?) {
+        timer?.cancel()
+        timer = nil
+        nextCheckDate = date
+        guard let date = date else { return }
+
+        let timer = DispatchSource.makeTimerSource(queue: DispatchQueue.main)
+        timer.schedule(deadline: .now() + max(0, date.timeIntervalSince(now())))
+        timer.setEventHandler { [weak self] in
+            self?.evaluate()
+        }
+        self.timer = timer
+        timer.resume()
+    }
+}
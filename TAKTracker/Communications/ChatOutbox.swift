@@ -0,0 +1,99 @@
+//
+//  ChatOutbox.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+// Sends our outgoing GeoChat to the TAK server from the retry queue kept
+// in ChatStore.
+//
+// A message is sent when it's queued and then again only if no delivered
+// or read receipt has come back by its next attempt, with the wait
+// doubling each time (plus jitter) up to MAX_BACKOFF_SECONDS. After
+// MAX_ATTEMPTS unanswered sends it's marked failed.
+//
+// Nothing goes out while there's no connection, and a backlog left by a
+// disconnect (or a restart) drains at MESSAGES_PER_TICK a second rather
+// than all at once. The store is only queried when something is due.
+class ChatOutbox {
+    static let TICK_INTERVAL_SECONDS = 1.0
+    static let MESSAGES_PER_TICK = 10
+    static let MAX_ATTEMPTS = 4
+    static let INITIAL_BACKOFF_SECONDS = 15.0
+    static let MAX_BACKOFF_SECONDS = 300.0
+    static let BACKOFF_JITTER = 0.2
+
+    // Sends one message. Called on the outbox's queue.
+    var onTransmit: ((MessageData) -> Void)?
+    // Whether there's a connection to send on
+    var canTransmit: () -> Bool = { true }
+
+    private let chatStore: ChatStore
+    private let queue = DispatchQueue(label: "com.flighttactics.TAKTracker.ChatOutbox", qos: .utility)
+    private var timer: DispatchSourceTimer?
+    // When the store next has something due. Starts in the past so the
+    // first tick picks up whatever was queued before a restart.
+    private var nextDue: Date? = Date.distantPast
+
+    init(chatStore: ChatStore) {
+        self.chatStore = chatStore
+    }
+
+    deinit {
+        timer?.cancel()
+    }
+
+    func start() {
+        queue.async {
+            guard self.timer == nil else { return }
+            let timer = DispatchSource.makeTimerSource(queue: self.queue)
+            timer.schedule(deadline: .now(), repeating: ChatOutbox.TICK_INTERVAL_SECONDS)
+            timer.setEventHandler { [weak self] in
+                self?.drain(now: Date.now)
+            }
+            self.timer = timer
+            timer.resume()
+        }
+    }
+
+    func stop() {
+        queue.async {
+            self.timer?.cancel()
+            self.timer = nil
+        }
+    }
+
+    // Something was queued or the connection came back
+    func wake() {
+        queue.async {
+            self.nextDue = Date.distantPast
+            self.drain(now: Date.now)
+        }
+    }
+
+    // Sends whatever is due at `now`, up to MESSAGES_PER_TICK, and returns
+    // how many went out
+    @discardableResult
+    func drain(now: Date) -> Int {
+        guard let due = nextDue, due <= now, canTransmit() else { return 0 }
+        let claim = chatStore.claimDueOutgoing(
+            now: now,
+            limit: ChatOutbox.MESSAGES_PER_TICK,
+            maxAttempts: ChatOutbox.MAX_ATTEMPTS,
+            backoff: ChatOutbox.backoff
+        )
+        for message in claim.messages {
+            onTransmit?(message)
+        }
+        nextDue = claim.nextDue
+        return claim.messages.count
+    }
+
+    static func backoff(attempt: Int) -> TimeInterval {
+        let base = min(MAX_BACKOFF_SECONDS, INITIAL_BACKOFF_SECONDS * pow(2.0, Double(max(0, attempt - 1))))
+        return base * Double.random(in: (1.0 - BACKOFF_JITTER)...(1.0 + BACKOFF_JITTER))
+    }
+}
@@ -0,0 +1,226 @@
+//
+//  EnrollmentHTTPClient.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+enum EnrollmentHTTPError: Error {
+    case transport(URLError)
+    // The server's response and body are kept for logging
+    case httpStatus(Int, response: HTTPURLResponse, data: Data)
+    case invalidResponse
+    case cancelled
+}
+
+typealias EnrollmentHTTPResult = Result<(data: Data, response: HTTPURLResponse), EnrollmentHTTPError>
+
+// One request, through all of its attempts. Use from the main queue.
+final class EnrollmentHTTPTask: NSObject, URLSessionTaskDelegate {
+    fileprivate(set) var attempts = 0
+    fileprivate(set) var isCancelled = false
+    // For the latest attempt. Can arrive just after completion is called.
+    private(set) var metrics: URLSessionTaskMetrics?
+    fileprivate var dataTask: URLSessionDataTask?
+    fileprivate var pendingRetry: DispatchWorkItem?
+    fileprivate var completion: ((EnrollmentHTTPResult) -> Void)?
+
+    func cancel() {
+        if(isCancelled) {
+            return
+        }
+        isCancelled = true
+        if let pendingRetry = pendingRetry {
+            // Between attempts there's no data task to report the cancel
+            pendingRetry.cancel()
+            self.pendingRetry = nil
+            finish(.failure(.cancelled))
+        } else {
+            dataTask?.cancel()
+        }
+    }
+
+    func urlSession(_ session: URLSession, task: URLSessionTask, didFinishCollecting metrics: URLSessionTaskMetrics) {
+        self.metrics = metrics
+        let reused = metrics.transactionMetrics.last?.isReusedConnection ?? false
+        TAKLogger.debug("[EnrollmentHTTPClient]: \(task.originalRequest?.url?.path ?? "") took \(metrics.taskInterval.duration)s, reused connection: \(reused)")
+    }
+
+    fileprivate func finish(_ result: EnrollmentHTTPResult) {
+        // The data task holds us as its delegate
+        dataTask = nil
+        completion?(result)
+        completion = nil
+    }
+}
+
+// The HTTP side of certificate enrollment.
+//
+// Every request goes through one URLSession, so the CSR POST rides the TLS
+// connection the CA config GET opened instead of doing a second handshake.
+// Requests time out after REQUEST_TIMEOUT without data, and transient
+// failures (dropped connections, timeouts, 502/503/504 and the like) are
+// retried up to MAX_ATTEMPTS times with a doubling delay. Anything else,
+// including TLS trust failures and 401s, is reported straight away.
+//
+// A POST isn't safe to repeat once the server may have seen it: a signing
+// request that timed out may still have been signed. So a POST is only
+// retried when it never left (it couldn't connect) or the server said it
+// didn't act on it (429/503).
+class EnrollmentHTTPClient {
+    static let REQUEST_TIMEOUT: TimeInterval = 15.0
+    static let RESOURCE_TIMEOUT: TimeInterval = 60.0
+    static let MAX_ATTEMPTS = 3
+    static let RETRY_BASE_DELAY: TimeInterval = 1.0
+    static let RETRYABLE_STATUS_CODES: Set<Int> = [408, 429, 502, 503, 504]
+    static let RETRYABLE_URL_ERRORS: Set<URLError.Code> = [
+        .timedOut,
+        .networkConnectionLost,
+        .cannotConnectToHost,
+        .notConnectedToInternet,
+        .dnsLookupFailed,
+        .cannotFindHost
+    ]
+    static let IDEMPOTENT_METHODS: Set<String> = ["GET", "HEAD", "OPTIONS", "PUT", "DELETE"]
+    // Failures that mean the server never received the request
+    static let UNSENT_URL_ERRORS: Set<URLError.Code> = [
+        .cannotConnectToHost,
+        .notConnectedToInternet,
+        .dnsLookupFailed,
+        .cannotFindHost
+    ]
+    // Statuses that mean the server received the request but didn't act on it
+    static let UNPROCESSED_STATUS_CODES: Set<Int> = [429, 503]
+
+    let session: URLSession
+    private let retryBaseDelay: TimeInterval
+
+    static func defaultConfiguration() -> URLSessionConfiguration {
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.timeoutIntervalForRequest = REQUEST_TIMEOUT
+        configuration.timeoutIntervalForResource = RESOURCE_TIMEOUT
+        configuration.httpMaximumConnectionsPerHost = 1
+        configuration.waitsForConnectivity = false
+        return configuration
+    }
+
+    init(configuration: URLSessionConfiguration = EnrollmentHTTPClient.defaultConfiguration(),
+         retryBaseDelay: TimeInterval = EnrollmentHTTPClient.RETRY_BASE_DELAY) {
+        self.retryBaseDelay = retryBaseDelay
+        session = URLSession(configuration: configuration,
+                             delegate: EnrollmentSessionDelegate(),
+                             delegateQueue: OperationQueue.main)
+    }
+
+    deinit {
+        session.finishTasksAndInvalidate()
+    }
+
+    // Calls completion once, on the main queue
+    @discardableResult
+    func send(_ request: URLRequest, completion: @escaping (EnrollmentHTTPResult) -> Void) -> EnrollmentHTTPTask {
+        let task = EnrollmentHTTPTask()
+        task.completion = completion
+        start(request, task: task)
+        return task
+    }
+
+    static func isTransient(_ error: EnrollmentHTTPError) -> Bool {
+        switch error {
+        case .transport(let urlError): return RETRYABLE_URL_ERRORS.contains(urlError.code)
+        case .httpStatus(let statusCode, _, _): return RETRYABLE_STATUS_CODES.contains(statusCode)
+        case .invalidResponse, .cancelled: return false
+        }
+    }
+
+    static func isRetryable(_ error: EnrollmentHTTPError, for request: URLRequest) -> Bool {
+        if(IDEMPOTENT_METHODS.contains(request.httpMethod ?? "GET")) {
+            return isTransient(error)
+        }
+        switch error {
+        case .transport(let urlError): return UNSENT_URL_ERRORS.contains(urlError.code)
+        case .httpStatus(let statusCode, _, _): return UNPROCESSED_STATUS_CODES.contains(statusCode)
+        case .invalidResponse, .cancelled: return false
+        }
+    }
+
+    static func result(data: Data?, response: URLResponse?, error: Error?) -> EnrollmentHTTPResult {
+        if let error = error {
+            guard let urlError = error as? URLError else {
+                return .failure(.transport(URLError(.unknown)))
+            }
+            return .failure(urlError.code == .cancelled ? .cancelled : .transport(urlError))
+        }
+        guard let response = response as? HTTPURLResponse else {
+            return .failure(.invalidResponse)
+        }
+        guard (200...299).contains(response.statusCode) else {
+            return .failure(.httpStatus(response.statusCode, response: response, data: data ?? Data()))
+        }
+        return .success((data: data ?? Data(), response: response))
+    }
+
+    private func start(_ request: URLRequest, task: EnrollmentHTTPTask) {
+        task.attempts += 1
+        let dataTask = session.dataTask(with: request) { [weak self] data, response, error in
+            if(task.isCancelled) {
+                task.finish(.failure(.cancelled))
+                return
+            }
+            let result = EnrollmentHTTPClient.result(data: data, response: response, error: error)
+            if case .failure(let failure) = result,
+               let self = self,
+               EnrollmentHTTPClient.isRetryable(failure, for: request),
+               task.attempts < EnrollmentHTTPClient.MAX_ATTEMPTS {
+                self.retry(request, task: task, after: failure)
+                return
+            }
+            task.finish(result)
+        }
+        dataTask.delegate = task
+        task.dataTask = dataTask
+        dataTask.resume()
+    }
+
+    private func retry(_ request: URLRequest, task: EnrollmentHTTPTask, after failure: EnrollmentHTTPError) {
+        let delay = retryBaseDelay * pow(2.0, Double(task.attempts - 1))
+        TAKLogger.debug("[EnrollmentHTTPClient]: Attempt \(task.attempts) to \(request.url?.path ?? "") failed with \(failure), retrying in \(delay)s")
+        let retry = DispatchWorkItem { [weak self] in
+            task.pendingRetry = nil
+            guard let self = self else {
+                task.finish(.failure(failure))
+                return
+            }
+            self.start(request, task: task)
+        }
+        task.dataTask = nil
+        task.pendingRetry = retry
+        DispatchQueue.main.asyncAfter(deadline: .now() + delay, execute: retry)
+    }
+}
+
+// TAK servers commonly use a private CA that isn't in the system trust
+// store yet at enrollment time, so the server certificate is accepted
+// here. Client certificate challenges are refused; enrollment
+// authenticates with the username and password.
+private class EnrollmentSessionDelegate: NSObject, URLSessionDelegate {
+    func urlSession(_ session: URLSession, didReceive challenge: URLAuthenticationChallenge, completionHandler: @escaping (URLSession.AuthChallengeDisposition, URLCredential?) -> Void) {
+        switch challenge.protectionSpace.authenticationMethod {
+        case NSURLAuthenticationMethodClientCertificate:
+            TAKLogger.debug("[EnrollmentHTTPClient]: Received a client auth challenge. Rejecting.")
+            completionHandler(.rejectProtectionSpace, nil)
+        case NSURLAuthenticationMethodServerTrust:
+            TAKLogger.debug("[EnrollmentHTTPClient]: Auth Trust challenge for \(challenge.protectionSpace.host)")
+            guard let serverTrust = challenge.protectionSpace.serverTrust else {
+                TAKLogger.debug("[EnrollmentHTTPClient]: No Server Trust in Auth Trust Challenge. Using default handling.")
+                completionHandler(.performDefaultHandling, nil)
+                return
+            }
+            completionHandler(.useCredential, URLCredential(trust: serverTrust))
+        default:
+            completionHandler(.performDefaultHandling, nil)
+        }
+    }
+}
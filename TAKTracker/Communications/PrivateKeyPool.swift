@@ -0,0 +1,65 @@
+//
+//  PrivateKeyPool.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+// Key pairs generated ahead of time, so certificate enrollment doesn't sit
+// waiting on RSA key generation, which can take seconds on older devices.
+//
+// The enrollment screen calls prepare when it opens and the key is built on
+// a background queue while the form is filled in. takeKey hands it over when
+// the CSR is built, and only generates one on the spot if none was prepared.
+// Keys stay in memory until CertificateManager.storePrivateKey.
+class PrivateKeyPool {
+    static let global = PrivateKeyPool()
+
+    private let queue = DispatchQueue(label: "com.flighttactics.TAKTracker.PrivateKeyPool", qos: .utility)
+    // Only touched on queue
+    private var keys: [CertificateKeyType: SecKey] = [:]
+    private var generationTimes: [CertificateKeyType: TimeInterval] = [:]
+
+    func prepare(keyType: CertificateKeyType) {
+        queue.async {
+            if(self.keys[keyType] != nil) {
+                return
+            }
+            do {
+                self.keys[keyType] = try self.generate(keyType: keyType)
+            } catch {
+                TAKLogger.error("[PrivateKeyPool]: Unable to pre-generate \(keyType.displayName) key: \(error)")
+            }
+        }
+    }
+
+    // A prepared key if there is one, waiting for it if it's still being
+    // generated. Each key is handed out once.
+    func takeKey(keyType: CertificateKeyType) throws -> SecKey {
+        return try queue.sync {
+            if let key = keys.removeValue(forKey: keyType) {
+                TAKLogger.debug("[PrivateKeyPool]: Using pre-generated \(keyType.displayName) key")
+                return key
+            }
+            return try generate(keyType: keyType)
+        }
+    }
+
+    func hasPreparedKey(keyType: CertificateKeyType) -> Bool {
+        return queue.sync { keys[keyType] != nil }
+    }
+
+    // How long the last key of this type took to generate
+    func lastGenerationTime(keyType: CertificateKeyType) -> TimeInterval? {
+        return queue.sync { generationTimes[keyType] }
+    }
+
+    private func generate(keyType: CertificateKeyType) throws -> SecKey {
+        let startedAt = Date()
+        let key = try CertificateManager.generatePrivateKey(keyType: keyType)
+        generationTimes[keyType] = Date().timeIntervalSince(startedAt)
+        return key
+    }
+}
@@ -25,8 +25,15 @@ enum ConnectionStatus : String, CustomStringConvertible {
 }
 
 class TCPMessage: NSObject, ObservableObject {
+    static let MAX_RECEIVE_LENGTH = 65_536
+
     var connection: NWConnection?
     var pendingPayload: Data
+    // Called on the connection's queue with each complete CoT event from the server
+    var onEvent: ((Data) -> Void)?
+    // Called on the connection's queue each time the connection is ready
+    var onReady: (() -> Void)?
+    private var framer = COTStreamFramer()
     
     init(initialPayload: Data) {
         TAKLogger.debug("[TCPMessage]: Init")
@@ -200,6 +207,27 @@ class TCPMessage: NSObject, ObservableObject {
         connection!.start(queue: .global())
     }
     
+    func receive() {
+        guard let connection = connection else { return }
+        connection.receive(minimumIncompleteLength: 1, maximumLength: TCPMessage.MAX_RECEIVE_LENGTH) { [weak self] data, _, isComplete, error in
+            guard let self = self, connection === self.connection else { return }
+            if let data = data, !data.isEmpty {
+                for event in self.framer.append(data) {
+                    self.onEvent?(event)
+                }
+            }
+            if let error = error {
+                TAKLogger.debug("[TCPMessage]: Error receiving: \(error)")
+                return
+            }
+            if(isComplete) {
+                TAKLogger.debug("[TCPMessage]: Server closed the connection")
+                return
+            }
+            self.receive()
+        }
+    }
+    
     func connectionFailed() {
         DispatchQueue.main.async {
             SettingsStore.global.isConnectingToServer = false
@@ -250,6 +278,9 @@ class TCPMessage: NSObject, ObservableObject {
                 SettingsStore.global.connectionStatus = ConnectionStatus.Connected.description
             }
             send(pendingPayload)
+            framer = COTStreamFramer()
+            receive()
+            onReady?()
         case .setup:
             TAKLogger.debug("[TCPMessage]: Entered state: setup")
             DispatchQueue.main.async {
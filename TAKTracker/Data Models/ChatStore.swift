@@ -0,0 +1,452 @@
+//
+//  ChatStore.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Combine
+import CoreData
+import Foundation
+
+struct ChatDeliveryUpdate: Equatable {
+    var id: String
+    var status: ChatDeliveryStatus
+}
+
+// GeoChat history, persisted in the MessageModel Core Data store.
+//
+// Nothing here runs on the main queue. Sent and received messages are
+// buffered on a background context and written together with one
+// NSBatchInsertRequest, once BATCH_SIZE messages are waiting or
+// FLUSH_INTERVAL_SECONDS after the first one arrived. Batch inserts go
+// straight to SQLite without creating managed objects, so a busy channel
+// costs one write per batch rather than one save per message.
+//
+// Reads are paged fetches returning plain MessageData values, newest page
+// first and oldest message first within it, keyed on (createdAt, id) so
+// paging never skips messages that share a timestamp.
+//
+// Message ids are unique in the store, so a batch insert of a message we
+// already have updates it in place. Only messages that weren't already
+// stored are published. Expired messages are purged with a batch delete
+// every PURGE_INTERVAL_SECONDS.
+//
+// Outgoing messages double as ChatOutbox's retry queue: their delivery
+// status, attempt count and next attempt time live on the row, so the
+// queue survives restarts, and receipts are applied with batch updates.
+class ChatStore {
+    static let MODEL_NAME = "MessageModel"
+    static let ENTITY_NAME = "Message"
+    static let BATCH_SIZE = 200
+    static let FLUSH_INTERVAL_SECONDS = 0.25
+    static let DEFAULT_PAGE_SIZE = 50
+    // How long chat history is kept
+    static let RETENTION_SECONDS: TimeInterval = 7 * 24 * 60 * 60
+    static let PURGE_INTERVAL_SECONDS: TimeInterval = 15 * 60
+    static let LOOKUP_CHUNK_SIZE = 500
+
+    // Loaded once, since two models claiming the same entity classes
+    // confuse Core Data when more than one store is open
+    private static let model: NSManagedObjectModel = {
+        let bundle = Bundle(for: ChatStore.self)
+        guard let url = bundle.url(forResource: MODEL_NAME, withExtension: "momd"),
+              let model = NSManagedObjectModel(contentsOf: url) else {
+            TAKLogger.error("[ChatStore]: Unable to load \(MODEL_NAME)")
+            return NSManagedObjectModel()
+        }
+        return model
+    }()
+
+    // Messages as they're written, delivered on the main queue
+    let inserted = PassthroughSubject<[MessageData], Never>()
+    // Outgoing message status changes, delivered on the main queue
+    let deliveryChanged = PassthroughSubject<ChatDeliveryUpdate, Never>()
+
+    private let container: NSPersistentContainer
+    private let context: NSManagedObjectContext
+    // Only touched on the context's queue
+    private var pending: [MessageData] = []
+    private var flushScheduled = false
+    private var purgeTimer: DispatchSourceTimer?
+
+    // An in-memory store is SQLite at /dev/null, which unlike
+    // NSInMemoryStoreType still supports batch requests
+    convenience init(inMemory: Bool = false) {
+        self.init(storeURL: inMemory ? URL(fileURLWithPath: "/dev/null") : nil)
+    }
+
+    // A nil URL uses the container's default location
+    init(storeURL: URL?) {
+        container = NSPersistentContainer(name: ChatStore.MODEL_NAME, managedObjectModel: ChatStore.model)
+        if let storeURL = storeURL {
+            container.persistentStoreDescriptions.first?.url = storeURL
+        }
+        container.loadPersistentStores { description, error in
+            if let error = error {
+                TAKLogger.error("[ChatStore]: Unable to load \(description.url?.lastPathComponent ?? ChatStore.MODEL_NAME): \(error)")
+            }
+        }
+        context = container.newBackgroundContext()
+        context.undoManager = nil
+    }
+
+    deinit {
+        purgeTimer?.cancel()
+    }
+
+    func insert(_ message: MessageData) {
+        insert([message])
+    }
+
+    func insert(_ messages: [MessageData]) {
+        if(messages.isEmpty) {
+            return
+        }
+        context.perform {
+            self.pending.append(contentsOf: messages)
+            if(self.pending.count >= ChatStore.BATCH_SIZE) {
+                self.flushPending()
+            } else if(!self.flushScheduled) {
+                self.flushScheduled = true
+                DispatchQueue.global(qos: .utility).asyncAfter(deadline: .now() + ChatStore.FLUSH_INTERVAL_SECONDS) { [weak self] in
+                    guard let self = self else { return }
+                    self.context.perform {
+                        self.flushPending()
+                    }
+                }
+            }
+        }
+    }
+
+    // Writes anything still buffered before returning
+    func flush() {
+        context.performAndWait {
+            flushPending()
+        }
+    }
+
+    func count() -> Int {
+        var result = 0
+        context.performAndWait {
+            flushPending()
+            let request = NSFetchRequest<NSNumber>(entityName: ChatStore.ENTITY_NAME)
+            result = (try? context.count(for: request)) ?? 0
+        }
+        return result
+    }
+
+    func containsMessage(id: String) -> Bool {
+        return !existingIDs(among: [id]).isEmpty
+    }
+
+    // Which of these message ids are already stored
+    func existingIDs(among ids: [String]) -> Set<String> {
+        var result = Set<String>()
+        context.performAndWait {
+            flushPending()
+            result = fetchExistingIDs(among: ids)
+        }
+        return result
+    }
+
+    // Deletes every message that expired by `now` and returns how many
+    @discardableResult
+    func purgeExpired(now: Date = Date.now) -> Int {
+        var purged = 0
+        context.performAndWait {
+            flushPending()
+            purged = deleteExpired(now: now)
+        }
+        return purged
+    }
+
+    func startExpiring() {
+        context.perform {
+            guard self.purgeTimer == nil else { return }
+            let timer = DispatchSource.makeTimerSource(queue: DispatchQueue.global(qos: .utility))
+            timer.schedule(deadline: .now() + ChatStore.PURGE_INTERVAL_SECONDS, repeating: ChatStore.PURGE_INTERVAL_SECONDS)
+            timer.setEventHandler { [weak self] in
+                guard let self = self else { return }
+                self.context.perform {
+                    let purged = self.deleteExpired(now: Date.now)
+                    if(purged > 0) {
+                        TAKLogger.debug("[ChatStore]: Purged \(purged) expired messages")
+                    }
+                }
+            }
+            self.purgeTimer = timer
+            timer.resume()
+        }
+    }
+
+    func stopExpiring() {
+        context.perform {
+            self.purgeTimer?.cancel()
+            self.purgeTimer = nil
+        }
+    }
+
+    // Claims up to `limit` outgoing messages due an attempt at `now`. Each
+    // is marked sent, its attempt counted and its next attempt pushed out
+    // by backoff(attempt), or marked failed once maxAttempts have gone
+    // unanswered. Returns the messages to send and when the next one is
+    // due, nil when nothing is waiting on a receipt.
+    func claimDueOutgoing(now: Date, limit: Int, maxAttempts: Int, backoff: (Int) -> TimeInterval) -> (messages: [MessageData], nextDue: Date?) {
+        var claimed: [MessageData] = []
+        var updates: [ChatDeliveryUpdate] = []
+        var nextDue: Date? = nil
+        let awaiting = ChatDeliveryStatus.AWAITING_RECEIPT.map { NSNumber(value: $0.rawValue) }
+
+        context.performAndWait {
+            flushPending()
+            let request = NSFetchRequest<NSManagedObject>(entityName: ChatStore.ENTITY_NAME)
+            request.predicate = NSPredicate(format: "deliveryStatus IN %@ AND nextAttemptAt <= %@", awaiting, now as NSDate)
+            request.sortDescriptors = [NSSortDescriptor(key: "nextAttemptAt", ascending: true)]
+            request.fetchLimit = limit
+
+            do {
+                for object in try context.fetch(request) {
+                    guard let id = object.value(forKey: "id") as? String else { continue }
+                    let attempts = (object.value(forKey: "sendAttempts") as? NSNumber)?.intValue ?? 0
+                    let status = (object.value(forKey: "deliveryStatus") as? NSNumber)?.int16Value
+
+                    if(attempts >= maxAttempts) {
+                        object.setValue(NSNumber(value: ChatDeliveryStatus.failed.rawValue), forKey: "deliveryStatus")
+                        object.setValue(nil, forKey: "nextAttemptAt")
+                        updates.append(ChatDeliveryUpdate(id: id, status: .failed))
+                        continue
+                    }
+
+                    object.setValue(NSNumber(value: ChatDeliveryStatus.sent.rawValue), forKey: "deliveryStatus")
+                    object.setValue(NSNumber(value: attempts + 1), forKey: "sendAttempts")
+                    object.setValue(now.addingTimeInterval(backoff(attempts + 1)), forKey: "nextAttemptAt")
+                    if(status != ChatDeliveryStatus.sent.rawValue) {
+                        updates.append(ChatDeliveryUpdate(id: id, status: .sent))
+                    }
+                    let keys = Array(object.entity.attributesByName.keys)
+                    if let message = MessageData(attributes: object.dictionaryWithValues(forKeys: keys)) {
+                        claimed.append(message)
+                    }
+                }
+                if(context.hasChanges) {
+                    try context.save()
+                }
+            } catch {
+                TAKLogger.error("[ChatStore]: Unable to claim outgoing messages: \(error)")
+                context.rollback()
+                claimed.removeAll()
+                updates.removeAll()
+            }
+            context.reset()
+
+            let next = NSFetchRequest<NSDictionary>(entityName: ChatStore.ENTITY_NAME)
+            next.resultType = .dictionaryResultType
+            next.propertiesToFetch = ["nextAttemptAt"]
+            next.predicate = NSPredicate(format: "deliveryStatus IN %@ AND nextAttemptAt != nil", awaiting)
+            next.sortDescriptors = [NSSortDescriptor(key: "nextAttemptAt", ascending: true)]
+            next.fetchLimit = 1
+            nextDue = (try? context.fetch(next))?.first?["nextAttemptAt"] as? Date
+        }
+
+        publish(updates)
+        return (claimed, nextDue)
+    }
+
+    // Applies a delivered or read receipt. Returns whether it moved the
+    // message on; receipts for unknown or already further along messages
+    // are ignored.
+    @discardableResult
+    func applyReceipt(messageID: String, status: ChatDeliveryStatus) -> Bool {
+        let from = status.supersedes.map { NSNumber(value: $0.rawValue) }
+        if(from.isEmpty) {
+            return false
+        }
+        var updated = false
+        context.performAndWait {
+            flushPending()
+            let request = NSBatchUpdateRequest(entityName: ChatStore.ENTITY_NAME)
+            request.predicate = NSPredicate(format: "id == %@ AND deliveryStatus IN %@", messageID, from)
+            request.propertiesToUpdate = [
+                "deliveryStatus": NSNumber(value: status.rawValue),
+                "nextAttemptAt": NSExpression(forConstantValue: nil)
+            ]
+            request.resultType = .updatedObjectsCountResultType
+            do {
+                let result = try context.execute(request) as? NSBatchUpdateResult
+                updated = (result?.result as? Int ?? 0) > 0
+            } catch {
+                TAKLogger.error("[ChatStore]: Unable to apply receipt for \(messageID): \(error)")
+            }
+        }
+        if(updated) {
+            publish([ChatDeliveryUpdate(id: messageID, status: status)])
+        }
+        return updated
+    }
+
+    // The page of up to `limit` messages just older than `cursor` (the
+    // newest page when nil), oldest first
+    func messages(olderThan cursor: MessageData? = nil, limit: Int = ChatStore.DEFAULT_PAGE_SIZE) -> [MessageData] {
+        var page: [MessageData] = []
+        context.performAndWait {
+            flushPending()
+            page = fetchPage(from: cursor, older: true, limit: limit)
+        }
+        return page
+    }
+
+    // The page of up to `limit` messages just newer than `cursor`, oldest first
+    func messages(newerThan cursor: MessageData, limit: Int = ChatStore.DEFAULT_PAGE_SIZE) -> [MessageData] {
+        var page: [MessageData] = []
+        context.performAndWait {
+            flushPending()
+            page = fetchPage(from: cursor, older: false, limit: limit)
+        }
+        return page
+    }
+
+    func loadMessages(olderThan cursor: MessageData? = nil, limit: Int = ChatStore.DEFAULT_PAGE_SIZE, completion: @escaping ([MessageData]) -> Void) {
+        loadPage(from: cursor, older: true, limit: limit, completion: completion)
+    }
+
+    func loadMessages(newerThan cursor: MessageData, limit: Int = ChatStore.DEFAULT_PAGE_SIZE, completion: @escaping ([MessageData]) -> Void) {
+        loadPage(from: cursor, older: false, limit: limit, completion: completion)
+    }
+
+    private func loadPage(from cursor: MessageData?, older: Bool, limit: Int, completion: @escaping ([MessageData]) -> Void) {
+        context.perform {
+            self.flushPending()
+            let page = self.fetchPage(from: cursor, older: older, limit: limit)
+            DispatchQueue.main.async {
+                completion(page)
+            }
+        }
+    }
+
+    private func fetchPage(from cursor: MessageData?, older: Bool, limit: Int) -> [MessageData] {
+        let request = NSFetchRequest<NSDictionary>(entityName: ChatStore.ENTITY_NAME)
+        request.resultType = .dictionaryResultType
+        // Walk away from the cursor, then put the page back in time order
+        request.sortDescriptors = [
+            NSSortDescriptor(key: "createdAt", ascending: !older),
+            NSSortDescriptor(key: "id", ascending: !older)
+        ]
+        request.fetchLimit = limit
+        if let cursor = cursor {
+            let comparison = older ? "<" : ">"
+            request.predicate = NSPredicate(
+                format: "createdAt \(comparison) %@ OR (createdAt == %@ AND id \(comparison) %@)",
+                cursor.createAt as NSDate, cursor.createAt as NSDate, cursor.id
+            )
+        }
+
+        do {
+            let rows = try context.fetch(request)
+            let page = rows.compactMap { row in
+                (row as? [String: Any]).flatMap { MessageData(attributes: $0) }
+            }
+            return older ? page.reversed() : page
+        } catch {
+            TAKLogger.error("[ChatStore]: Unable to fetch messages: \(error)")
+            return []
+        }
+    }
+
+    private func publish(_ updates: [ChatDeliveryUpdate]) {
+        if(updates.isEmpty) {
+            return
+        }
+        DispatchQueue.main.async {
+            for update in updates {
+                self.deliveryChanged.send(update)
+            }
+        }
+    }
+
+    // Call on the context's queue
+    private func fetchExistingIDs(among ids: [String]) -> Set<String> {
+        var existing = Set<String>()
+        // Chunked to stay under SQLite's limit on bound variables
+        var start = 0
+        while(start < ids.count) {
+            let chunk = Array(ids[start..<min(start + ChatStore.LOOKUP_CHUNK_SIZE, ids.count)])
+            start += ChatStore.LOOKUP_CHUNK_SIZE
+
+            let request = NSFetchRequest<NSDictionary>(entityName: ChatStore.ENTITY_NAME)
+            request.resultType = .dictionaryResultType
+            request.propertiesToFetch = ["id"]
+            request.predicate = NSPredicate(format: "id IN %@", chunk)
+            do {
+                for row in try context.fetch(request) {
+                    if let id = row["id"] as? String {
+                        existing.insert(id)
+                    }
+                }
+            } catch {
+                TAKLogger.error("[ChatStore]: Unable to look up message ids: \(error)")
+            }
+        }
+        return existing
+    }
+
+    // Call on the context's queue
+    private func deleteExpired(now: Date) -> Int {
+        let fetch = NSFetchRequest<NSFetchRequestResult>(entityName: ChatStore.ENTITY_NAME)
+        fetch.predicate = NSPredicate(format: "expiresAt <= %@", now as NSDate)
+        let request = NSBatchDeleteRequest(fetchRequest: fetch)
+        request.resultType = .resultTypeCount
+        do {
+            let result = try context.execute(request) as? NSBatchDeleteResult
+            return result?.result as? Int ?? 0
+        } catch {
+            TAKLogger.error("[ChatStore]: Unable to purge expired messages: \(error)")
+            return 0
+        }
+    }
+
+    // Call on the context's queue
+    private func flushPending() {
+        flushScheduled = false
+        if(pending.isEmpty) {
+            return
+        }
+        // Last copy of each id wins, like the upsert the store does
+        var positions: [String: Int] = [:]
+        var batch: [MessageData] = []
+        batch.reserveCapacity(pending.count)
+        for message in pending {
+            if let position = positions[message.id] {
+                batch[position] = message
+            } else {
+                positions[message.id] = batch.count
+                batch.append(message)
+            }
+        }
+        pending.removeAll(keepingCapacity: true)
+        let existing = fetchExistingIDs(among: batch.map { $0.id })
+
+        var index = 0
+        let request = NSBatchInsertRequest(entityName: ChatStore.ENTITY_NAME, dictionaryHandler: { dictionary in
+            guard index < batch.count else { return true }
+            dictionary.addEntries(from: batch[index].attributes)
+            index += 1
+            return false
+        })
+
+        do {
+            try context.execute(request)
+        } catch {
+            TAKLogger.error("[ChatStore]: Unable to write \(batch.count) messages: \(error)")
+            return
+        }
+
+        let new = existing.isEmpty ? batch : batch.filter { !existing.contains($0.id) }
+        if(new.isEmpty) {
+            return
+        }
+        DispatchQueue.main.async {
+            self.inserted.send(new)
+        }
+    }
+}
@@ -0,0 +1,231 @@
+//
+//  ContactStore.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import CoreLocation
+import Foundation
+
+// Last known situational awareness report for another TAK user
+struct ContactRecord: Equatable {
+    var uid: String
+    var type: String
+    var callsign: String
+    var group: String
+    var role: String
+    var latitude: Double
+    var longitude: Double
+    var heightAboveEllipsoid: Double
+    var speed: Double
+    var course: Double
+    var time: Date
+    var stale: Date
+
+    var coordinate: CLLocationCoordinate2D {
+        CLLocationCoordinate2D(latitude: latitude, longitude: longitude)
+    }
+}
+
+struct ContactSnapshot {
+    // Increments on every change, so readers can skip unchanged snapshots
+    var version: Int
+    var contacts: ContiguousArray<ContactRecord>
+}
+
+// Contacts received from the TAK server, keyed by CoT uid.
+//
+// Records are kept densely packed with a uid -> index map, so an upsert
+// is a dictionary lookup plus an in-place write and a removal is a swap
+// with the last record. Stale times are tracked in a timing wheel rather
+// than by scanning every contact, and each contact has at most one live
+// wheel entry: an update that pushes stale later just leaves the existing
+// entry, which reschedules itself when it fires early.
+//
+// A spatial grid mirrors the record array (same indices, same swaps) so
+// viewport queries only touch contacts near the visible area.
+//
+// All mutation happens on a private serial queue. Readers get a
+// copy-on-write snapshot, which is cheap to take and never changes
+// underneath them.
+final class ContactStore {
+    static let EXPIRY_INTERVAL: TimeInterval = 1.0
+
+    private let queue = DispatchQueue(label: "com.flighttactics.TAKTracker.ContactStore", qos: .utility)
+    private var records = ContiguousArray<ContactRecord>()
+    private var indexByUID: [String: Int] = [:]
+    private var grid: SpatialGrid
+    // Deadline of the wheel entry currently standing for each uid
+    private var scheduledStale: [String: Date] = [:]
+    private var wheel: TimingWheel<String>
+    private var currentVersion = 0
+    private var expiryTimer: DispatchSourceTimer?
+
+    init(start: Date = Date(), cellSize: Double = SpatialGrid.DEFAULT_CELL_SIZE) {
+        grid = SpatialGrid(cellSize: cellSize)
+        wheel = TimingWheel<String>(start: start, resolution: ContactStore.EXPIRY_INTERVAL)
+    }
+
+    deinit {
+        expiryTimer?.cancel()
+    }
+
+    var count: Int {
+        queue.sync { records.count }
+    }
+
+    // Cheap way for readers to tell whether anything has changed
+    var version: Int {
+        queue.sync { currentVersion }
+    }
+
+    func snapshot() -> ContactSnapshot {
+        queue.sync { ContactSnapshot(version: currentVersion, contacts: records) }
+    }
+
+    func contact(uid: String) -> ContactRecord? {
+        queue.sync {
+            indexByUID[uid].map { records[$0] }
+        }
+    }
+
+    // Contacts inside a map viewport
+    func contacts(in bounds: CoordinateBounds) -> [ContactRecord] {
+        queue.sync {
+            grid.query(bounds).map { records[$0] }
+        }
+    }
+
+    func upsert(_ record: ContactRecord) {
+        queue.async {
+            self.performUpsert(record)
+            self.changed()
+        }
+    }
+
+    func upsert(_ batch: [ContactRecord]) {
+        queue.async {
+            for record in batch {
+                self.performUpsert(record)
+            }
+            self.changed()
+        }
+    }
+
+    func remove(uid: String) {
+        queue.async {
+            if(self.performRemove(uid: uid)) {
+                self.changed()
+            }
+        }
+    }
+
+    func removeAll() {
+        queue.async {
+            self.records.removeAll()
+            self.indexByUID.removeAll()
+            self.grid.removeAll()
+            self.scheduledStale.removeAll()
+            self.wheel.removeAll()
+            self.changed()
+        }
+    }
+
+    // Drops every contact whose stale time has passed and returns their uids
+    @discardableResult
+    func expire(now: Date = Date()) -> [String] {
+        queue.sync {
+            let removed = performExpire(now: now)
+            if(!removed.isEmpty) {
+                changed()
+            }
+            return removed
+        }
+    }
+
+    // Runs expiry on the store's queue once per wheel tick
+    func startExpiring() {
+        queue.async {
+            guard self.expiryTimer == nil else { return }
+            let timer = DispatchSource.makeTimerSource(queue: self.queue)
+            timer.schedule(deadline: .now() + ContactStore.EXPIRY_INTERVAL, repeating: ContactStore.EXPIRY_INTERVAL, leeway: .milliseconds(250))
+            timer.setEventHandler { [weak self] in
+                guard let self = self else { return }
+                if(!self.performExpire(now: Date()).isEmpty) {
+                    self.changed()
+                }
+            }
+            self.expiryTimer = timer
+            timer.resume()
+        }
+    }
+
+    func stopExpiring() {
+        queue.async {
+            self.expiryTimer?.cancel()
+            self.expiryTimer = nil
+        }
+    }
+
+    private func performUpsert(_ record: ContactRecord) {
+        if let index = indexByUID[record.uid] {
+            // Ignore reports older than the one we have
+            if(record.time < records[index].time) {
+                return
+            }
+            records[index] = record
+            grid.move(index, latitude: record.latitude, longitude: record.longitude)
+        } else {
+            indexByUID[record.uid] = grid.append(latitude: record.latitude, longitude: record.longitude)
+            records.append(record)
+        }
+
+        // A later stale time is picked up when the existing entry fires
+        if let scheduled = scheduledStale[record.uid], scheduled <= record.stale {
+            return
+        }
+        scheduledStale[record.uid] = record.stale
+        wheel.schedule(record.uid, at: record.stale)
+    }
+
+    @discardableResult
+    private func performRemove(uid: String) -> Bool {
+        guard let index = indexByUID.removeValue(forKey: uid) else {
+            return false
+        }
+        scheduledStale.removeValue(forKey: uid)
+        let last = records.count - 1
+        if(index != last) {
+            records.swapAt(index, last)
+            indexByUID[records[index].uid] = index
+        }
+        records.removeLast()
+        grid.swapRemove(index)
+        return true
+    }
+
+    private func performExpire(now: Date) -> [String] {
+        var removed: [String] = []
+        for entry in wheel.advance(to: now) {
+            // Entries left behind by a removal or an earlier reschedule
+            guard scheduledStale[entry.key] == entry.deadline,
+                  let index = indexByUID[entry.key] else {
+                continue
+            }
+            let stale = records[index].stale
+            if(stale <= now) {
+                performRemove(uid: entry.key)
+                removed.append(entry.key)
+            } else {
+                scheduledStale[entry.key] = stale
+                wheel.schedule(entry.key, at: stale)
+            }
+        }
+        return removed
+    }
+
+    private func changed() {
+        currentVersion += 1
+    }
+}
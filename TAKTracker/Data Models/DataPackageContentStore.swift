@@ -0,0 +1,160 @@
+//
+//  DataPackageContentStore.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+enum DataPackageContentType: String, Codable {
+    case kml
+    case kmz
+    case image
+    case video
+    case document
+    case other
+
+    // Goes by the manifest's contentType when there is one, then the extension
+    static func of(path: String, manifestType: String? = nil) -> DataPackageContentType {
+        switch manifestType?.lowercased() ?? "" {
+        case "kml": return .kml
+        case "kmz": return .kmz
+        default: break
+        }
+        switch (path as NSString).pathExtension.lowercased() {
+        case "kml": return .kml
+        case "kmz": return .kmz
+        case "png", "jpg", "jpeg", "gif", "tif", "tiff", "bmp", "heic", "sid", "ntf", "nitf", "jp2": return .image
+        case "mp4", "mov", "m4v", "ts", "mpg", "mpeg": return .video
+        case "pdf", "txt", "doc", "docx", "xls", "xlsx", "ppt", "pptx", "html", "htm", "csv": return .document
+        default: return .other
+        }
+    }
+}
+
+struct DataPackageContentEntry: Codable, Equatable {
+    // Path inside the zip
+    var path: String
+    // Path under the package's directory in the store
+    var storedPath: String
+    var type: DataPackageContentType
+    var size: UInt64
+    // Hex SHA-256 of the uncompressed bytes
+    var sha256: String
+}
+
+struct DataPackageContentIndex: Codable, Equatable {
+    var uid: String
+    var name: String
+    var importedAt: Date
+    var entries: [DataPackageContentEntry]
+
+    func entries(ofType type: DataPackageContentType) -> [DataPackageContentEntry] {
+        return entries.filter { $0.type == type }
+    }
+}
+
+// Overlays, imagery and attachments imported from data packages.
+//
+// Each package gets a directory named for its manifest uid holding the
+// unpacked files and an index.json describing them. Only the index is read
+// to find out what a package holds. The files themselves are opened when
+// needed, memory-mapped, so a 500MB image costs address space rather than
+// RAM.
+class DataPackageContentStore {
+    static let INDEX_FILE_NAME = "index.json"
+    static let STAGING_SUFFIX = ".partial"
+    // Posted after a package is stored or removed
+    static let DID_CHANGE_NOTIFICATION = Notification.Name("DataPackageContentStoreDidChange")
+
+    static let global = DataPackageContentStore()
+
+    let rootURL: URL
+
+    static func defaultRootURL() -> URL {
+        let supportDirectory = FileManager.default.urls(for: .applicationSupportDirectory, in: .userDomainMask).first!
+        return supportDirectory.appendingPathComponent("DataPackages", isDirectory: true)
+    }
+
+    init(rootURL: URL = DataPackageContentStore.defaultRootURL()) {
+        self.rootURL = rootURL
+    }
+
+    func packageDirectory(uid: String) -> URL {
+        return rootURL.appendingPathComponent(DataPackageContentStore.safeComponent(uid), isDirectory: true)
+    }
+
+    // Where an import writes before it's complete, so a half-written
+    // package never replaces a good one
+    func stagingDirectory(uid: String) -> URL {
+        return rootURL.appendingPathComponent(DataPackageContentStore.safeComponent(uid) + DataPackageContentStore.STAGING_SUFFIX, isDirectory: true)
+    }
+
+    func index(uid: String) -> DataPackageContentIndex? {
+        let indexURL = packageDirectory(uid: uid).appendingPathComponent(DataPackageContentStore.INDEX_FILE_NAME)
+        guard let data = try? Data(contentsOf: indexURL) else { return nil }
+        do {
+            return try JSONDecoder().decode(DataPackageContentIndex.self, from: data)
+        } catch {
+            TAKLogger.error("[DataPackageContentStore]: Unable to read index for \(uid): \(error)")
+            return nil
+        }
+    }
+
+    func indexes() -> [DataPackageContentIndex] {
+        let directories = (try? FileManager.default.contentsOfDirectory(at: rootURL, includingPropertiesForKeys: nil)) ?? []
+        return directories
+            .filter { !$0.lastPathComponent.hasSuffix(DataPackageContentStore.STAGING_SUFFIX) }
+            .compactMap { index(uid: $0.lastPathComponent) }
+            .sorted { $0.importedAt < $1.importedAt }
+    }
+
+    func url(for entry: DataPackageContentEntry, in index: DataPackageContentIndex) -> URL {
+        return packageDirectory(uid: index.uid).appendingPathComponent(entry.storedPath)
+    }
+
+    func mappedData(for entry: DataPackageContentEntry, in index: DataPackageContentIndex) throws -> Data {
+        return try Data(contentsOf: url(for: entry, in: index), options: .alwaysMapped)
+    }
+
+    // Writes the index into the staging directory and swaps it in for
+    // whatever was imported under the same uid before
+    func commit(_ index: DataPackageContentIndex) throws {
+        let staging = stagingDirectory(uid: index.uid)
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+        try encoder.encode(index).write(to: staging.appendingPathComponent(DataPackageContentStore.INDEX_FILE_NAME), options: .atomic)
+
+        let destination = packageDirectory(uid: index.uid)
+        if(FileManager.default.fileExists(atPath: destination.path)) {
+            _ = try FileManager.default.replaceItemAt(destination, withItemAt: staging)
+        } else {
+            try FileManager.default.moveItem(at: staging, to: destination)
+        }
+        TAKLogger.debug("[DataPackageContentStore]: Stored \(index.entries.count) item(s) for \(index.uid)")
+        NotificationCenter.default.post(name: DataPackageContentStore.DID_CHANGE_NOTIFICATION, object: self)
+    }
+
+    func remove(uid: String) throws {
+        let directory = packageDirectory(uid: uid)
+        if(FileManager.default.fileExists(atPath: directory.path)) {
+            try FileManager.default.removeItem(at: directory)
+            NotificationCenter.default.post(name: DataPackageContentStore.DID_CHANGE_NOTIFICATION, object: self)
+        }
+    }
+
+    // A zip path as a relative path that stays inside the package directory
+    static func storedPath(forEntryPath path: String) -> String {
+        let components = path
+            .replacingOccurrences(of: "\\", with: "/")
+            .components(separatedBy: "/")
+            .filter { !$0.isEmpty && $0 != "." && $0 != ".." }
+        return components.isEmpty ? "unnamed" : components.joined(separator: "/")
+    }
+
+    static func safeComponent(_ name: String) -> String {
+        let cleaned = name.replacingOccurrences(of: "/", with: "_").replacingOccurrences(of: "\\", with: "_")
+        return (cleaned.isEmpty || cleaned == "." || cleaned == "..") ? "package" : cleaned
+    }
+}
@@ -7,8 +7,33 @@
 
 import Foundation
 
-struct MessageData: Decodable, Identifiable {
-    let id: UUID
+// Where one of our outgoing messages has got to. Received messages are .incoming.
+enum ChatDeliveryStatus: Int16, Codable {
+    case incoming = 0
+    case pending = 1
+    case sent = 2
+    case delivered = 3
+    case read = 4
+    case failed = 5
+
+    // Outgoing messages the retry queue still owns
+    static let AWAITING_RECEIPT: [ChatDeliveryStatus] = [.pending, .sent]
+
+    // The statuses a receipt of this kind moves a message on from
+    var supersedes: [ChatDeliveryStatus] {
+        switch self {
+        case .delivered: return [.pending, .sent, .failed]
+        case .read: return [.pending, .sent, .delivered, .failed]
+        default: return []
+        }
+    }
+}
+
+struct MessageData: Decodable, Identifiable, Equatable {
+    // Our own UID, as sent in the uid of our position CoT
+    static let CURRENT_USER_UID = AppConstants.getClientID()
+    
+    let id: String
     let userUId: String
     let callSign: String
     let message: String
@@ -16,16 +41,60 @@ struct MessageData: Decodable, Identifiable {
     let expiresAt: Date
     var dateSent: Date = Date.now
     var dateReceived = Date.now
+    var deliveryStatus = ChatDeliveryStatus.incoming
+    var sendAttempts = 0
+    var nextAttemptAt: Date? = nil
     
-    static var defaultIncomingMessage1 = Self(id: UUID(), userUId: "incoming", callSign: "TXDPS Vandenheuvel 606", message: "get an Android", createAt: Date.now, expiresAt: Date.now)
-    static var defaultIncomingMessage2 = Self(id: UUID(), userUId: "incoming", callSign: "TXDPS Ross 622", message: "Howdy", createAt: Date.now, expiresAt: Date.now)
-    static var defaultIncomingMessage3 = Self(id: UUID(), userUId: "incoming", callSign: "TXDPS Ross 622", message: "Donec sed odio dui. Sed posuere consectetur est at lobortis. Integer posuere erat a ante venenatis dapibus posuere velit aliquet. Nulla vitae elit libero, a pharetra augue.", createAt: Date.now, expiresAt: Date.now)
-    static var defaultOutgoingMessage1 = Self(id: UUID(), userUId: "outgoing", callSign: "", message: "Hello from iTAK", createAt: Date.now, expiresAt: Date.now)
-    static var defaultOutgoingMessage2 = Self(id: UUID(), userUId: "outgoing", callSign: "", message: "Test", createAt: Date.now, expiresAt: Date.now)
-    static var defaultOutgoingMessage3 = Self(id: UUID(), userUId: "outgoing", callSign: "", message: "Sed posuere consectetur est at lobortis. Etiam porta sem malesuada magna mollis euismod. Morbi leo risus, porta ac consectetur ac, vestibulum at eros.", createAt: Date.now, expiresAt: Date.now)
+    static var defaultIncomingMessage1 = Self(id: UUID().uuidString, userUId: "incoming", callSign: "TXDPS Vandenheuvel 606", message: "get an Android", createAt: Date.now, expiresAt: Date.now)
+    static var defaultIncomingMessage2 = Self(id: UUID().uuidString, userUId: "incoming", callSign: "TXDPS Ross 622", message: "Howdy", createAt: Date.now, expiresAt: Date.now)
+    static var defaultIncomingMessage3 = Self(id: UUID().uuidString, userUId: "incoming", callSign: "TXDPS Ross 622", message: "Donec sed odio dui. Sed posuere consectetur est at lobortis. Integer posuere erat a ante venenatis dapibus posuere velit aliquet. Nulla vitae elit libero, a pharetra augue.", createAt: Date.now, expiresAt: Date.now)
+    static var defaultOutgoingMessage1 = Self(id: UUID().uuidString, userUId: CURRENT_USER_UID, callSign: "", message: "Hello from iTAK", createAt: Date.now, expiresAt: Date.now)
+    static var defaultOutgoingMessage2 = Self(id: UUID().uuidString, userUId: CURRENT_USER_UID, callSign: "", message: "Test", createAt: Date.now, expiresAt: Date.now)
+    static var defaultOutgoingMessage3 = Self(id: UUID().uuidString, userUId: CURRENT_USER_UID, callSign: "", message: "Sed posuere consectetur est at lobortis. Etiam porta sem malesuada magna mollis euismod. Morbi leo risus, porta ac consectetur ac, vestibulum at eros.", createAt: Date.now, expiresAt: Date.now)
     
     func isFromCurrentUser() -> Bool {
-        if userUId == "incoming" { return false }
-        else { return true }
+        return userUId == MessageData.CURRENT_USER_UID
+    }
+}
+
+// Conversion to and from the attributes of the Message entity
+extension MessageData {
+    init?(attributes: [String: Any]) {
+        guard let id = attributes["id"] as? String,
+              let createdAt = attributes["createdAt"] as? Date else {
+            return nil
+        }
+        self.init(
+            id: id,
+            userUId: attributes["userUId"] as? String ?? "",
+            callSign: attributes["callSign"] as? String ?? "",
+            message: attributes["message"] as? String ?? "",
+            createAt: createdAt,
+            expiresAt: attributes["expiresAt"] as? Date ?? createdAt,
+            dateSent: attributes["dateSent"] as? Date ?? createdAt,
+            dateReceived: attributes["dateReceived"] as? Date ?? createdAt,
+            deliveryStatus: (attributes["deliveryStatus"] as? NSNumber).flatMap { ChatDeliveryStatus(rawValue: $0.int16Value) } ?? .incoming,
+            sendAttempts: (attributes["sendAttempts"] as? NSNumber)?.intValue ?? 0,
+            nextAttemptAt: attributes["nextAttemptAt"] as? Date
+        )
+    }
+    
+    var attributes: [String: Any] {
+        var attributes: [String: Any] = [
+            "id": id,
+            "userUId": userUId,
+            "callSign": callSign,
+            "message": message,
+            "createdAt": createAt,
+            "expiresAt": expiresAt,
+            "dateSent": dateSent,
+            "dateReceived": dateReceived,
+            "deliveryStatus": NSNumber(value: deliveryStatus.rawValue),
+            "sendAttempts": NSNumber(value: sendAttempts)
+        ]
+        if let nextAttemptAt = nextAttemptAt {
+            attributes["nextAttemptAt"] = nextAttemptAt
+        }
+        return attributes
     }
 }
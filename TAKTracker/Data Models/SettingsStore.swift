@@ -124,6 +124,20 @@ class SettingsStore: ObservableObject {
         }
     }
     
+    // A CertificateKeyType raw value
+    @Published var enrollmentKeyType: String {
+        didSet {
+            UserDefaults.standard.set(enrollmentKeyType, forKey: "enrollmentKeyType")
+        }
+    }
+    
+    // How long before the client certificate expires to renew it
+    @Published var certificateRenewalWindowDays: Double {
+        didSet {
+            UserDefaults.standard.set(certificateRenewalWindowDays, forKey: "certificateRenewalWindowDays")
+        }
+    }
+    
     @Published var takServerSecureAPIPort: String {
         didSet {
             UserDefaults.standard.set(takServerSecureAPIPort, forKey: "takServerSecureAPIPort")
@@ -312,6 +326,10 @@ class SettingsStore: ObservableObject {
 
         self.takServerCSRPort = (UserDefaults.standard.object(forKey: "takServerCSRPort") == nil ? TAKConstants.DEFAULT_CSR_PORT : UserDefaults.standard.object(forKey: "takServerCSRPort") as! String)
         
+        self.enrollmentKeyType = (UserDefaults.standard.object(forKey: "enrollmentKeyType") == nil ? CertificateKeyType.rsa2048.rawValue : UserDefaults.standard.object(forKey: "enrollmentKeyType") as! String)
+        
+        self.certificateRenewalWindowDays = (UserDefaults.standard.object(forKey: "certificateRenewalWindowDays") == nil ? 7.0 : UserDefaults.standard.object(forKey: "certificateRenewalWindowDays") as! Double)
+        
         self.takServerSecureAPIPort = (UserDefaults.standard.object(forKey: "takServerSecureAPIPort") == nil ? TAKConstants.DEFAULT_SECURE_API_PORT : UserDefaults.standard.object(forKey: "takServerSecureAPIPort") as! String)
         
         self.takServerProtocol = (UserDefaults.standard.object(forKey: "takServerProtocol") == nil ? "ssl" : UserDefaults.standard.object(forKey: "takServerProtocol") as! String)
@@ -0,0 +1,294 @@
+//
+//  TrackStore.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import CoreLocation
+import Foundation
+
+enum TrackStoreError: Error {
+    case cannotOpenFile(Int32)
+    case cannotResizeFile(Int32)
+    case cannotMapFile(Int32)
+}
+
+struct TrackFix: Equatable {
+    // Seconds since 1970
+    var time: TimeInterval
+    var latitude: Double
+    var longitude: Double
+    var heightAboveEllipsoid: Double
+    var speed: Double
+    var course: Double
+    var horizontalAccuracy: Double
+
+    init(time: TimeInterval, latitude: Double, longitude: Double, heightAboveEllipsoid: Double = 0, speed: Double = -1, course: Double = -1, horizontalAccuracy: Double = -1) {
+        self.time = time
+        self.latitude = latitude
+        self.longitude = longitude
+        self.heightAboveEllipsoid = heightAboveEllipsoid
+        self.speed = speed
+        self.course = course
+        self.horizontalAccuracy = horizontalAccuracy
+    }
+
+    init(location: CLLocation) {
+        self.init(
+            time: location.timestamp.timeIntervalSince1970,
+            latitude: location.coordinate.latitude,
+            longitude: location.coordinate.longitude,
+            heightAboveEllipsoid: location.ellipsoidalAltitude,
+            speed: location.speed,
+            course: location.course,
+            horizontalAccuracy: location.horizontalAccuracy
+        )
+    }
+}
+
+// Breadcrumb trail of our own positions, kept in a memory-mapped file.
+//
+// The file is a small header followed by one fixed-size column of Doubles
+// per field, so appending is a handful of stores into mapped memory and
+// nothing is held on the heap. Fixes live in a ring: once capacity is
+// reached the oldest fix is overwritten. Opening an existing file is just
+// a map of it - there is nothing to parse at launch.
+//
+// Not thread safe. LocationManager appends from the main thread.
+final class TrackStore {
+    enum Column: Int, CaseIterable {
+        case time
+        case latitude
+        case longitude
+        case heightAboveEllipsoid
+        case speed
+        case course
+        case horizontalAccuracy
+    }
+
+    // 18 hours of 1 Hz fixes in a little over 7MB
+    static let DEFAULT_CAPACITY = 65_536
+    static let DEFAULT_MINIMUM_INTERVAL: TimeInterval = 1.0
+
+    private static let MAGIC: UInt32 = 0x544B_5452 // "TKTR"
+    private static let VERSION: UInt32 = 1
+    private static let HEADER_SIZE = 64
+    private static let CAPACITY_OFFSET = 8
+    private static let START_OFFSET = 16
+    private static let COUNT_OFFSET = 24
+    private static let APPENDS_PER_SYNC = 60
+
+    let fileURL: URL
+    let capacity: Int
+    // Fixes closer together than this are dropped
+    var minimumInterval: TimeInterval
+
+    private let fileDescriptor: Int32
+    private let mappedSize: Int
+    private let base: UnsafeMutableRawPointer
+    private let columns: [UnsafeMutablePointer<Double>]
+    private var appendsSinceSync = 0
+
+    private(set) var count: Int {
+        get { Int(base.load(fromByteOffset: TrackStore.COUNT_OFFSET, as: UInt64.self)) }
+        set { base.storeBytes(of: UInt64(newValue), toByteOffset: TrackStore.COUNT_OFFSET, as: UInt64.self) }
+    }
+
+    private var start: Int {
+        get { Int(base.load(fromByteOffset: TrackStore.START_OFFSET, as: UInt64.self)) }
+        set { base.storeBytes(of: UInt64(newValue), toByteOffset: TrackStore.START_OFFSET, as: UInt64.self) }
+    }
+
+    static func defaultFileURL() -> URL {
+        let supportDirectory = FileManager.default.urls(for: .applicationSupportDirectory, in: .userDomainMask).first!
+        return supportDirectory.appendingPathComponent("Track", isDirectory: true).appendingPathComponent("track.bin")
+    }
+
+    static func fileSize(capacity: Int) -> Int {
+        return HEADER_SIZE + Column.allCases.count * capacity * MemoryLayout<Double>.stride
+    }
+
+    init(fileURL: URL = TrackStore.defaultFileURL(),
+         capacity: Int = TrackStore.DEFAULT_CAPACITY,
+         minimumInterval: TimeInterval = TrackStore.DEFAULT_MINIMUM_INTERVAL) throws {
+        self.fileURL = fileURL
+        self.minimumInterval = minimumInterval
+
+        try FileManager.default.createDirectory(at: fileURL.deletingLastPathComponent(), withIntermediateDirectories: true)
+
+        let fd = open(fileURL.path, O_RDWR | O_CREAT, 0o600)
+        guard fd >= 0 else {
+            throw TrackStoreError.cannotOpenFile(errno)
+        }
+
+        // An existing track keeps the capacity it was created with
+        var existingCapacity: Int? = nil
+        var fileStat = stat()
+        if(fstat(fd, &fileStat) == 0 && Int(fileStat.st_size) >= TrackStore.HEADER_SIZE) {
+            var header = [UInt8](repeating: 0, count: TrackStore.HEADER_SIZE)
+            if(pread(fd, &header, TrackStore.HEADER_SIZE, 0) == TrackStore.HEADER_SIZE) {
+                header.withUnsafeBytes { bytes in
+                    let magic = bytes.load(fromByteOffset: 0, as: UInt32.self)
+                    let version = bytes.load(fromByteOffset: 4, as: UInt32.self)
+                    let storedCapacity = Int(bytes.load(fromByteOffset: TrackStore.CAPACITY_OFFSET, as: UInt64.self))
+                    if(magic == TrackStore.MAGIC && version == TrackStore.VERSION && storedCapacity > 0
+                       && Int(fileStat.st_size) == TrackStore.fileSize(capacity: storedCapacity)) {
+                        existingCapacity = storedCapacity
+                    }
+                }
+            }
+        }
+
+        let resolvedCapacity = existingCapacity ?? max(capacity, 1)
+        let size = TrackStore.fileSize(capacity: resolvedCapacity)
+
+        if(existingCapacity == nil) {
+            TAKLogger.debug("[TrackStore]: Creating new track file with capacity \(resolvedCapacity)")
+            guard ftruncate(fd, 0) == 0, ftruncate(fd, off_t(size)) == 0 else {
+                let error = errno
+                close(fd)
+                throw TrackStoreError.cannotResizeFile(error)
+            }
+        }
+
+        guard let mapped = mmap(nil, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0),
+              mapped != MAP_FAILED else {
+            let error = errno
+            close(fd)
+            throw TrackStoreError.cannotMapFile(error)
+        }
+
+        fileDescriptor = fd
+        mappedSize = size
+        base = mapped
+        self.capacity = resolvedCapacity
+        columns = Column.allCases.map { column in
+            mapped.advanced(by: TrackStore.HEADER_SIZE + column.rawValue * resolvedCapacity * MemoryLayout<Double>.stride)
+                .bindMemory(to: Double.self, capacity: resolvedCapacity)
+        }
+
+        if(existingCapacity == nil) {
+            base.storeBytes(of: TrackStore.MAGIC, toByteOffset: 0, as: UInt32.self)
+            base.storeBytes(of: TrackStore.VERSION, toByteOffset: 4, as: UInt32.self)
+            base.storeBytes(of: UInt64(resolvedCapacity), toByteOffset: TrackStore.CAPACITY_OFFSET, as: UInt64.self)
+            start = 0
+            count = 0
+        }
+    }
+
+    deinit {
+        msync(base, mappedSize, MS_SYNC)
+        munmap(base, mappedSize)
+        close(fileDescriptor)
+    }
+
+    private func physicalIndex(_ index: Int) -> Int {
+        return (start + index) % capacity
+    }
+
+    var lastTime: TimeInterval? {
+        guard count > 0 else { return nil }
+        return columns[Column.time.rawValue][physicalIndex(count - 1)]
+    }
+
+    // Returns false if the fix was dropped for being out of order or too soon
+    @discardableResult
+    func append(_ fix: TrackFix) -> Bool {
+        if let lastTime = lastTime, fix.time < lastTime + minimumInterval {
+            return false
+        }
+
+        let slot: Int
+        if(count < capacity) {
+            slot = physicalIndex(count)
+        } else {
+            slot = start
+        }
+
+        columns[Column.time.rawValue][slot] = fix.time
+        columns[Column.latitude.rawValue][slot] = fix.latitude
+        columns[Column.longitude.rawValue][slot] = fix.longitude
+        columns[Column.heightAboveEllipsoid.rawValue][slot] = fix.heightAboveEllipsoid
+        columns[Column.speed.rawValue][slot] = fix.speed
+        columns[Column.course.rawValue][slot] = fix.course
+        columns[Column.horizontalAccuracy.rawValue][slot] = fix.horizontalAccuracy
+
+        // Only publish the fix in the header once its values are written
+        if(count < capacity) {
+            count += 1
+        } else {
+            start = (start + 1) % capacity
+        }
+
+        appendsSinceSync += 1
+        if(appendsSinceSync >= TrackStore.APPENDS_PER_SYNC) {
+            flush(waitForCompletion: false)
+        }
+        return true
+    }
+
+    @discardableResult
+    func append(location: CLLocation) -> Bool {
+        return append(TrackFix(location: location))
+    }
+
+    subscript(index: Int) -> TrackFix {
+        precondition(index >= 0 && index < count, "TrackStore index out of range")
+        let slot = physicalIndex(index)
+        return TrackFix(
+            time: columns[Column.time.rawValue][slot],
+            latitude: columns[Column.latitude.rawValue][slot],
+            longitude: columns[Column.longitude.rawValue][slot],
+            heightAboveEllipsoid: columns[Column.heightAboveEllipsoid.rawValue][slot],
+            speed: columns[Column.speed.rawValue][slot],
+            course: columns[Column.course.rawValue][slot],
+            horizontalAccuracy: columns[Column.horizontalAccuracy.rawValue][slot]
+        )
+    }
+
+    // First index whose time is >= the given time
+    private func lowerBound(_ time: TimeInterval) -> Int {
+        let times = columns[Column.time.rawValue]
+        var low = 0
+        var high = count
+        while(low < high) {
+            let mid = (low + high) / 2
+            if(times[physicalIndex(mid)] < time) {
+                low = mid + 1
+            } else {
+                high = mid
+            }
+        }
+        return low
+    }
+
+    // Indexes of fixes with from <= time <= to
+    func indices(from: Date, to: Date) -> Range<Int> {
+        guard from <= to else { return 0..<0 }
+        let lower = lowerBound(from.timeIntervalSince1970)
+        let upper = lowerBound(to.timeIntervalSince1970.nextUp)
+        return lower..<upper
+    }
+
+    func forEachFix(from: Date, to: Date, _ body: (TrackFix) -> Void) {
+        for index in indices(from: from, to: to) {
+            body(self[index])
+        }
+    }
+
+    func fixes(from: Date, to: Date) -> [TrackFix] {
+        return indices(from: from, to: to).map { self[$0] }
+    }
+
+    func removeAll() {
+        count = 0
+        start = 0
+        flush(waitForCompletion: true)
+    }
+
+    func flush(waitForCompletion: Bool = true) {
+        appendsSinceSync = 0
+        msync(base, mappedSize, waitForCompletion ? MS_SYNC : MS_ASYNC)
+    }
+}
@@ -0,0 +1,125 @@
+//
+//  EnvelopeRTree.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+// Static R-tree over envelopes, bulk loaded with Sort-Tile-Recursive.
+// Fences change rarely and are looked up constantly, so the tree is built
+// in one go and rebuilt when the set changes rather than supporting
+// inserts. Nodes are stored level by level in flat arrays.
+struct EnvelopeRTree {
+    static let NODE_CAPACITY = 16
+
+    private var minX = ContiguousArray<Double>()
+    private var minY = ContiguousArray<Double>()
+    private var maxX = ContiguousArray<Double>()
+    private var maxY = ContiguousArray<Double>()
+    // For leaves, the item index. For branches, the first child node.
+    private var firstChild = ContiguousArray<Int32>()
+    private var childCount = ContiguousArray<Int32>()
+    private var isLeaf = ContiguousArray<Bool>()
+    private var root = -1
+
+    let count: Int
+
+    init(envelopes: [GeofenceEnvelope]) {
+        count = envelopes.count
+        guard !envelopes.isEmpty else { return }
+
+        // Leaf entries: one per item
+        var level: [Int] = []
+        for (index, envelope) in envelopes.enumerated() {
+            level.append(addNode(envelope, firstChild: index, childCount: 0, isLeaf: true))
+        }
+
+        while(level.count > 1) {
+            level = pack(level)
+        }
+        root = level[0]
+    }
+
+    // Indices of every envelope containing the point
+    func query(x: Double, y: Double, into results: inout [Int]) {
+        results.removeAll(keepingCapacity: true)
+        guard root >= 0 else { return }
+        var stack: [Int] = [root]
+        while let node = stack.popLast() {
+            if(x < minX[node] || x > maxX[node] || y < minY[node] || y > maxY[node]) {
+                continue
+            }
+            if(isLeaf[node]) {
+                results.append(Int(firstChild[node]))
+                continue
+            }
+            let first = Int(firstChild[node])
+            for child in first..<(first + Int(childCount[node])) {
+                stack.append(child)
+            }
+        }
+    }
+
+    func query(x: Double, y: Double) -> [Int] {
+        var results: [Int] = []
+        query(x: x, y: y, into: &results)
+        return results
+    }
+
+    // Groups one level of nodes into parents: sort by x into vertical
+    // slices, sort each slice by y, and fill parents in order. Children of
+    // each parent are laid out contiguously.
+    private mutating func pack(_ nodes: [Int]) -> [Int] {
+        let capacity = EnvelopeRTree.NODE_CAPACITY
+        let parentCount = (nodes.count + capacity - 1) / capacity
+        let sliceCount = Int(ceil(Double(parentCount).squareRoot()))
+        let sliceSize = sliceCount * capacity
+
+        let byX = nodes.sorted { centerX($0) < centerX($1) }
+        var parents: [Int] = []
+        var sliceStart = 0
+        while(sliceStart < byX.count) {
+            let slice = byX[sliceStart..<min(sliceStart + sliceSize, byX.count)].sorted { centerY($0) < centerY($1) }
+            var groupStart = 0
+            while(groupStart < slice.count) {
+                let group = slice[groupStart..<min(groupStart + capacity, slice.count)]
+                // Copy the children so they sit next to each other
+                let first = minX.count
+                var envelope = GeofenceEnvelope(minX: .greatestFiniteMagnitude, minY: .greatestFiniteMagnitude, maxX: -.greatestFiniteMagnitude, maxY: -.greatestFiniteMagnitude)
+                for child in group {
+                    let childEnvelope = GeofenceEnvelope(minX: minX[child], minY: minY[child], maxX: maxX[child], maxY: maxY[child])
+                    envelope.minX = min(envelope.minX, childEnvelope.minX)
+                    envelope.minY = min(envelope.minY, childEnvelope.minY)
+                    envelope.maxX = max(envelope.maxX, childEnvelope.maxX)
+                    envelope.maxY = max(envelope.maxY, childEnvelope.maxY)
+                    _ = addNode(childEnvelope, firstChild: Int(firstChild[child]), childCount: Int(childCount[child]), isLeaf: isLeaf[child])
+                }
+                parents.append(addNode(envelope, firstChild: first, childCount: group.count, isLeaf: false))
+                groupStart += capacity
+            }
+            sliceStart += sliceSize
+        }
+        return parents
+    }
+
+    private mutating func addNode(_ envelope: GeofenceEnvelope, firstChild first: Int, childCount children: Int, isLeaf leaf: Bool) -> Int {
+        minX.append(envelope.minX)
+        minY.append(envelope.minY)
+        maxX.append(envelope.maxX)
+        maxY.append(envelope.maxY)
+        firstChild.append(Int32(first))
+        childCount.append(Int32(children))
+        isLeaf.append(leaf)
+        return minX.count - 1
+    }
+
+    private func centerX(_ node: Int) -> Double {
+        return (minX[node] + maxX[node]) * 0.5
+    }
+
+    private func centerY(_ node: Int) -> Double {
+        return (minY[node] + maxY[node]) * 0.5
+    }
+}
@@ -0,0 +1,207 @@
+//
+//  GeofenceEngine.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import sf_ios
+
+struct Geofence {
+    var id: String
+    var name: String
+    var polygon: PreparedPolygon
+
+    init(id: String, name: String, polygon: PreparedPolygon) {
+        self.id = id
+        self.name = name
+        self.polygon = polygon
+    }
+
+    init(id: String, name: String, polygon: SFPolygon) {
+        self.init(id: id, name: name, polygon: PreparedPolygon(polygon: polygon))
+    }
+
+    // A fence for each placemark with polygons in it. The polygons of a
+    // MultiGeometry make one fence between them.
+    static func fences(from placemarks: [KMLPlacemark]) -> [Geofence] {
+        return placemarks.compactMap { placemark in
+            let rings = Geofence.rings(in: placemark.geometry)
+            guard !rings.isEmpty else { return nil }
+            return Geofence(id: placemark.id, name: placemark.name, polygon: PreparedPolygon(rings: rings))
+        }
+    }
+
+    // Every polygon in the KML and KMZ files of imported data packages
+    static func fences(from store: DataPackageContentStore) -> [Geofence] {
+        var fences: [Geofence] = []
+        for index in store.indexes() {
+            for entry in index.entries where entry.type == .kml || entry.type == .kmz {
+                fences.append(contentsOf: Geofence.fences(from: KMLParser.parse(url: store.url(for: entry, in: index))))
+            }
+        }
+        return fences
+    }
+
+    // Polygon rings only; lines and points can't contain anything
+    private static func rings(in geometry: SFGeometry) -> [[(x: Double, y: Double)]] {
+        if let polygon = geometry as? SFPolygon {
+            return polygon.rings.compactMap { ring -> [(x: Double, y: Double)]? in
+                guard let ring = ring as? SFLineString else { return nil }
+                return ring.points.compactMap { point -> (x: Double, y: Double)? in
+                    guard let point = point as? SFPoint else { return nil }
+                    return (point.x.doubleValue, point.y.doubleValue)
+                }
+            }
+        }
+        if let collection = geometry as? SFGeometryCollection {
+            return collection.geometries.flatMap { member -> [[(x: Double, y: Double)]] in
+                guard let member = member as? SFGeometry else { return [] }
+                return rings(in: member)
+            }
+        }
+        return []
+    }
+}
+
+enum GeofenceTransition {
+    case entered
+    case exited
+}
+
+struct GeofenceEvent: Equatable {
+    var subject: String
+    var fenceID: String
+    var transition: GeofenceTransition
+}
+
+// Tracks which fences each subject (our own unit or a contact uid) is
+// inside and reports entries and exits.
+//
+// Candidate fences come from an R-tree over fence envelopes, then each
+// candidate's prepared polygon decides containment. A transition is only
+// reported after HYSTERESIS_SAMPLES consecutive samples agree, so a
+// position jittering along an edge doesn't flap in and out.
+//
+// State is only kept for fences a subject is inside or about to change
+// for, so 10k subjects cost nothing for the fences they're nowhere near.
+//
+// Not thread safe. Owners serialize access.
+struct GeofenceEngine {
+    static let DEFAULT_HYSTERESIS_SAMPLES = 2
+
+    private struct SubjectState {
+        var inside = Set<Int>()
+        // Fence -> consecutive samples disagreeing with `inside`
+        var pending: [Int: Int] = [:]
+    }
+
+    let hysteresisSamples: Int
+    private(set) var fences: [Geofence] = []
+    private var tree = EnvelopeRTree(envelopes: [])
+    private var subjects: [String: SubjectState] = [:]
+    private var candidates: [Int] = []
+
+    init(fences: [Geofence] = [], hysteresisSamples: Int = GeofenceEngine.DEFAULT_HYSTERESIS_SAMPLES) {
+        self.hysteresisSamples = max(1, hysteresisSamples)
+        setFences(fences)
+    }
+
+    var isEmpty: Bool {
+        fences.isEmpty
+    }
+
+    // Fences are matched to the previous set by id, so a subject stays
+    // inside a fence that survives the reload and no entry is reported
+    // again. State is only dropped for fences that went away.
+    mutating func setFences(_ newFences: [Geofence]) {
+        var newIndexes: [String: Int] = [:]
+        for (index, fence) in newFences.enumerated() where newIndexes[fence.id] == nil {
+            newIndexes[fence.id] = index
+        }
+        let remap = fences.map { newIndexes[$0.id] }
+
+        fences = newFences
+        tree = EnvelopeRTree(envelopes: newFences.map { $0.polygon.envelope })
+
+        for (subject, state) in subjects {
+            var remapped = SubjectState()
+            for fence in state.inside {
+                if let index = remap[fence] {
+                    remapped.inside.insert(index)
+                }
+            }
+            for (fence, samples) in state.pending {
+                if let index = remap[fence] {
+                    remapped.pending[index] = samples
+                }
+            }
+            if(remapped.inside.isEmpty && remapped.pending.isEmpty) {
+                subjects.removeValue(forKey: subject)
+            } else {
+                subjects[subject] = remapped
+            }
+        }
+    }
+
+    func fences(containingLatitude latitude: Double, longitude: Double) -> [Int] {
+        return tree.query(x: longitude, y: latitude).filter {
+            fences[$0].polygon.contains(x: longitude, y: latitude)
+        }
+    }
+
+    mutating func update(subject: String, latitude: Double, longitude: Double) -> [GeofenceEvent] {
+        var events: [GeofenceEvent] = []
+        update(subject: subject, latitude: latitude, longitude: longitude, events: &events)
+        return events
+    }
+
+    mutating func update(subject: String, latitude: Double, longitude: Double, events: inout [GeofenceEvent]) {
+        tree.query(x: longitude, y: latitude, into: &candidates)
+        var state = subjects.removeValue(forKey: subject) ?? SubjectState()
+        if(candidates.isEmpty && state.inside.isEmpty && state.pending.isEmpty) {
+            return
+        }
+
+        var current = Set<Int>()
+        for fence in candidates where fences[fence].polygon.contains(x: longitude, y: latitude) {
+            current.insert(fence)
+        }
+
+        // Fences that disagree with what we last reported
+        let changed = current.symmetricDifference(state.inside)
+        for fence in state.pending.keys where !changed.contains(fence) {
+            state.pending.removeValue(forKey: fence)
+        }
+        for fence in changed {
+            let samples = (state.pending[fence] ?? 0) + 1
+            if(samples < hysteresisSamples) {
+                state.pending[fence] = samples
+                continue
+            }
+            state.pending.removeValue(forKey: fence)
+            if(current.contains(fence)) {
+                state.inside.insert(fence)
+                events.append(GeofenceEvent(subject: subject, fenceID: fences[fence].id, transition: .entered))
+            } else {
+                state.inside.remove(fence)
+                events.append(GeofenceEvent(subject: subject, fenceID: fences[fence].id, transition: .exited))
+            }
+        }
+
+        if(!state.inside.isEmpty || !state.pending.isEmpty) {
+            subjects[subject] = state
+        }
+    }
+
+    // Forgets a subject without reporting exits, e.g. when a contact goes stale
+    mutating func removeSubject(_ subject: String) {
+        subjects.removeValue(forKey: subject)
+    }
+
+    func isInside(subject: String, fenceID: String) -> Bool {
+        guard let state = subjects[subject] else { return false }
+        return state.inside.contains { fences[$0].id == fenceID }
+    }
+}
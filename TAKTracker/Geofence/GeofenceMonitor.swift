@@ -0,0 +1,169 @@
+//
+//  GeofenceMonitor.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Combine
+import CoreLocation
+import Foundation
+
+// A fence transition with the names needed to show it
+struct GeofenceAlert: Equatable {
+    var event: GeofenceEvent
+    var fenceName: String
+    // Our callsign for SELF_SUBJECT, the contact's callsign otherwise
+    var subjectName: String
+
+    var isSelf: Bool {
+        event.subject == GeofenceMonitor.SELF_SUBJECT
+    }
+
+    var message: String {
+        "\(subjectName) \(event.transition == .entered ? "entered" : "left") \(fenceName)"
+    }
+}
+
+// Runs the GeofenceEngine once a second over our own position and every
+// received contact, on a background queue, and publishes transitions on
+// the main queue.
+//
+// The fences are the polygons in imported data packages, reloaded when a
+// package is imported. Our position is pushed onto the monitor's queue
+// from the location source's updates rather than read across threads.
+class GeofenceMonitor {
+    static let SELF_SUBJECT = "self"
+    static let UPDATE_INTERVAL_SECONDS = 1.0
+
+    let alerts = PassthroughSubject<GeofenceAlert, Never>()
+
+    private let queue = DispatchQueue(label: "com.flighttactics.TAKTracker.GeofenceMonitor", qos: .utility)
+    private var engine = GeofenceEngine()
+    private var fenceNames: [String: String] = [:]
+    private var timer: DispatchSourceTimer?
+    private weak var contactStore: ContactStore?
+    private var latestLocation: CLLocation?
+    private var locationCancellable: AnyCancellable?
+    private var fenceStoreObserver: NSObjectProtocol?
+    private var trackedContacts = Set<String>()
+
+    deinit {
+        timer?.cancel()
+        if let observer = fenceStoreObserver {
+            NotificationCenter.default.removeObserver(observer)
+        }
+    }
+
+    func setFences(_ fences: [Geofence]) {
+        queue.async {
+            self.performSetFences(fences)
+        }
+    }
+
+    // Call on the main queue, where the location source publishes
+    func start(contactStore: ContactStore, locationSource: LocationSource, fenceStore: DataPackageContentStore? = nil) {
+        let currentLocation = locationSource.currentLocation
+        locationCancellable = locationSource.locationUpdates.sink { [weak self] location in
+            self?.queue.async {
+                self?.latestLocation = location
+            }
+        }
+
+        if let fenceStore = fenceStore {
+            if let observer = fenceStoreObserver {
+                NotificationCenter.default.removeObserver(observer)
+            }
+            fenceStoreObserver = NotificationCenter.default.addObserver(
+                forName: DataPackageContentStore.DID_CHANGE_NOTIFICATION,
+                object: fenceStore,
+                queue: nil
+            ) { [weak self] _ in
+                self?.reloadFences(from: fenceStore)
+            }
+            reloadFences(from: fenceStore)
+        }
+
+        queue.async {
+            self.contactStore = contactStore
+            if(self.latestLocation == nil) {
+                self.latestLocation = currentLocation
+            }
+            guard self.timer == nil else { return }
+            let timer = DispatchSource.makeTimerSource(queue: self.queue)
+            timer.schedule(deadline: .now() + GeofenceMonitor.UPDATE_INTERVAL_SECONDS, repeating: GeofenceMonitor.UPDATE_INTERVAL_SECONDS)
+            timer.setEventHandler { [weak self] in
+                self?.evaluate()
+            }
+            self.timer = timer
+            timer.resume()
+        }
+    }
+
+    func stop() {
+        locationCancellable?.cancel()
+        locationCancellable = nil
+        queue.async {
+            self.timer?.cancel()
+            self.timer = nil
+        }
+    }
+
+    private func reloadFences(from store: DataPackageContentStore) {
+        queue.async {
+            let fences = Geofence.fences(from: store)
+            TAKLogger.debug("[GeofenceMonitor]: Monitoring \(fences.count) fence(s)")
+            self.performSetFences(fences)
+        }
+    }
+
+    private func performSetFences(_ fences: [Geofence]) {
+        engine.setFences(fences)
+        fenceNames = Dictionary(fences.map { ($0.id, $0.name) }, uniquingKeysWith: { first, _ in first })
+    }
+
+    private func evaluate() {
+        if(engine.isEmpty) {
+            return
+        }
+        var newEvents: [GeofenceEvent] = []
+
+        if let location = latestLocation {
+            engine.update(subject: GeofenceMonitor.SELF_SUBJECT, latitude: location.coordinate.latitude, longitude: location.coordinate.longitude, events: &newEvents)
+        }
+
+        var callsigns: [String: String] = [:]
+        if let store = contactStore {
+            var seen = Set<String>()
+            for contact in store.snapshot().contacts {
+                seen.insert(contact.uid)
+                let eventCount = newEvents.count
+                engine.update(subject: contact.uid, latitude: contact.latitude, longitude: contact.longitude, events: &newEvents)
+                if(newEvents.count != eventCount) {
+                    callsigns[contact.uid] = contact.callsign
+                }
+            }
+            for uid in trackedContacts.subtracting(seen) {
+                engine.removeSubject(uid)
+            }
+            trackedContacts = seen
+        }
+
+        if(newEvents.isEmpty) {
+            return
+        }
+        let newAlerts = newEvents.map { event in
+            GeofenceAlert(event: event, fenceName: fenceNames[event.fenceID] ?? event.fenceID, subjectName: callsigns[event.subject] ?? event.subject)
+        }
+        DispatchQueue.main.async {
+            for var alert in newAlerts {
+                // SettingsStore belongs to the main queue
+                if(alert.isSelf) {
+                    alert.subjectName = SettingsStore.global.callSign
+                }
+                TAKLogger.info("[GeofenceMonitor]: \(alert.message)")
+                self.alerts.send(alert)
+            }
+        }
+    }
+}
@@ -0,0 +1,151 @@
+//
+//  PreparedPolygon.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import sf_ios
+
+struct GeofenceEnvelope: Equatable {
+    var minX: Double
+    var minY: Double
+    var maxX: Double
+    var maxY: Double
+
+    func contains(x: Double, y: Double) -> Bool {
+        return x >= minX && x <= maxX && y >= minY && y <= maxY
+    }
+}
+
+// A polygon converted once into a form that's cheap to test points
+// against, in x = longitude, y = latitude degrees.
+//
+// Every ring's edges are packed into flat Double arrays, and the
+// envelope is split into horizontal bands with each band listing the
+// edges that cross it. A containment test is an envelope check, then a
+// crossing count (even-odd, so holes work) over the edges in the point's
+// band only.
+struct PreparedPolygon {
+    // Aim for about this many edges per band
+    static let EDGES_PER_BAND = 4
+    static let MAX_BANDS = 1024
+
+    let envelope: GeofenceEnvelope
+
+    private var x1 = ContiguousArray<Double>()
+    private var y1 = ContiguousArray<Double>()
+    private var x2 = ContiguousArray<Double>()
+    private var y2 = ContiguousArray<Double>()
+    private var bandStarts = ContiguousArray<Int32>()
+    private var bandEdges = ContiguousArray<Int32>()
+    private let bandCount: Int
+    private let bandHeight: Double
+
+    var edgeCount: Int {
+        x1.count
+    }
+
+    // Each ring is a list of (x, y) vertices; closing the ring is optional
+    init(rings: [[(x: Double, y: Double)]]) {
+        var minX = Double.greatestFiniteMagnitude
+        var minY = Double.greatestFiniteMagnitude
+        var maxX = -Double.greatestFiniteMagnitude
+        var maxY = -Double.greatestFiniteMagnitude
+
+        for ring in rings where ring.count >= 3 {
+            for index in 0..<ring.count {
+                let start = ring[index]
+                let end = ring[(index + 1) % ring.count]
+                minX = min(minX, start.x)
+                maxX = max(maxX, start.x)
+                minY = min(minY, start.y)
+                maxY = max(maxY, start.y)
+                // Skip the closing duplicate and horizontal edges, which never cross a ray
+                if(start.y == end.y) {
+                    continue
+                }
+                x1.append(start.x)
+                y1.append(start.y)
+                x2.append(end.x)
+                y2.append(end.y)
+            }
+        }
+
+        if(x1.isEmpty) {
+            envelope = GeofenceEnvelope(minX: 0, minY: 0, maxX: -1, maxY: -1)
+            bandCount = 0
+            bandHeight = 1
+            return
+        }
+        envelope = GeofenceEnvelope(minX: minX, minY: minY, maxX: maxX, maxY: maxY)
+
+        let bands = max(1, min(PreparedPolygon.MAX_BANDS, x1.count / PreparedPolygon.EDGES_PER_BAND))
+        bandCount = bands
+        bandHeight = max((maxY - minY) / Double(bands), Double.leastNormalMagnitude)
+
+        // Two passes to lay the buckets out contiguously
+        var counts = [Int32](repeating: 0, count: bands + 1)
+        for edge in 0..<x1.count {
+            let (first, last) = bandRange(edge)
+            for band in first...last {
+                counts[band + 1] += 1
+            }
+        }
+        for band in 0..<bands {
+            counts[band + 1] += counts[band]
+        }
+        bandStarts = ContiguousArray(counts)
+        bandEdges = ContiguousArray(repeating: 0, count: Int(counts[bands]))
+        var next = counts
+        for edge in 0..<x1.count {
+            let (first, last) = bandRange(edge)
+            for band in first...last {
+                bandEdges[Int(next[band])] = Int32(edge)
+                next[band] += 1
+            }
+        }
+    }
+
+    init(polygon: SFPolygon) {
+        var rings: [[(x: Double, y: Double)]] = []
+        for case let ring as SFLineString in polygon.rings {
+            var vertices: [(x: Double, y: Double)] = []
+            vertices.reserveCapacity(Int(ring.numPoints()))
+            for case let point as SFPoint in ring.points {
+                vertices.append((point.x.doubleValue, point.y.doubleValue))
+            }
+            rings.append(vertices)
+        }
+        self.init(rings: rings)
+    }
+
+    func contains(x: Double, y: Double) -> Bool {
+        guard envelope.contains(x: x, y: y) else { return false }
+        let band = self.band(y: y)
+        var inside = false
+        for slot in Int(bandStarts[band])..<Int(bandStarts[band + 1]) {
+            let edge = Int(bandEdges[slot])
+            let startY = y1[edge]
+            let endY = y2[edge]
+            if((startY > y) != (endY > y)) {
+                let crossingX = x1[edge] + (y - startY) * (x2[edge] - x1[edge]) / (endY - startY)
+                if(x < crossingX) {
+                    inside.toggle()
+                }
+            }
+        }
+        return inside
+    }
+
+    private func band(y: Double) -> Int {
+        return min(max(Int((y - envelope.minY) / bandHeight), 0), bandCount - 1)
+    }
+
+    private func bandRange(_ edge: Int) -> (Int, Int) {
+        let first = band(y: min(y1[edge], y2[edge]))
+        let last = band(y: max(y1[edge], y2[edge]))
+        return (first, last)
+    }
+}
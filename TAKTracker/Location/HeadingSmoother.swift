@@ -0,0 +1,131 @@
+//
+//  HeadingSmoother.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import CoreLocation
+import Foundation
+
+// A smoothed compass reading. Unlike CLHeading we can construct these
+// ourselves, which lets the smoother (and tests) produce them.
+struct HeadingReading: Equatable {
+    // Negative when true north is unavailable, matching CLHeading
+    var trueHeading: CLLocationDirection
+    var magneticHeading: CLLocationDirection
+    var headingAccuracy: CLLocationDirection
+    var timestamp: Date
+
+    var hasTrueHeading: Bool {
+        trueHeading >= 0
+    }
+
+    func direction(unit: DirectionUnit) -> CLLocationDirection {
+        switch unit {
+        case DirectionUnit.TN:
+            return trueHeading
+        case DirectionUnit.MN:
+            return magneticHeading
+        }
+    }
+
+    // Best available bearing in degrees true, for CoT course
+    var course: CLLocationDirection {
+        hasTrueHeading ? trueHeading : magneticHeading
+    }
+}
+
+// Exponential smoothing of compass headings. Headings are averaged as
+// unit vectors so that readings either side of north (359° and 1°)
+// average to 0° rather than 180°.
+//
+// Core Location stops calling back once the raw heading moves less than
+// its headingFilter, which would leave the smoothed heading stuck partway
+// through a turn. settle() keeps blending in the last raw reading until
+// the smoothed one catches up.
+struct HeadingSmoother {
+    // Close enough to the raw reading to stop settling
+    static let SETTLED_DEGREES = 0.1
+
+    // Weight given to each new sample, 0 < smoothingFactor <= 1
+    var smoothingFactor: Double = 0.3
+
+    private var trueVector: (x: Double, y: Double)?
+    private var magneticVector: (x: Double, y: Double)?
+    private var lastSample: (trueHeading: CLLocationDirection, magneticHeading: CLLocationDirection, headingAccuracy: CLLocationDirection)?
+
+    init(smoothingFactor: Double = 0.3) {
+        self.smoothingFactor = min(max(smoothingFactor, 0.01), 1.0)
+    }
+
+    mutating func reset() {
+        trueVector = nil
+        magneticVector = nil
+        lastSample = nil
+    }
+
+    mutating func add(trueHeading: CLLocationDirection,
+                      magneticHeading: CLLocationDirection,
+                      headingAccuracy: CLLocationDirection,
+                      timestamp: Date) -> HeadingReading {
+        lastSample = (trueHeading, magneticHeading, headingAccuracy)
+        let smoothedMagnetic = HeadingSmoother.angle(of: blend(&magneticVector, degrees: magneticHeading))
+
+        var smoothedTrue = trueHeading
+        if(trueHeading >= 0) {
+            smoothedTrue = HeadingSmoother.angle(of: blend(&trueVector, degrees: trueHeading))
+        } else {
+            trueVector = nil
+        }
+
+        return HeadingReading(
+            trueHeading: smoothedTrue,
+            magneticHeading: smoothedMagnetic,
+            headingAccuracy: headingAccuracy,
+            timestamp: timestamp
+        )
+    }
+
+    // The last raw reading blended in again, or nil once the smoothed
+    // heading is within SETTLED_DEGREES of it
+    mutating func settle(timestamp: Date) -> HeadingReading? {
+        guard let sample = lastSample, let magneticVector = magneticVector else {
+            return nil
+        }
+        var isSettled = HeadingSmoother.angularDifference(HeadingSmoother.angle(of: magneticVector), sample.magneticHeading) < HeadingSmoother.SETTLED_DEGREES
+        if let trueVector = trueVector {
+            isSettled = isSettled && HeadingSmoother.angularDifference(HeadingSmoother.angle(of: trueVector), sample.trueHeading) < HeadingSmoother.SETTLED_DEGREES
+        }
+        if(isSettled) {
+            return nil
+        }
+        return add(trueHeading: sample.trueHeading, magneticHeading: sample.magneticHeading, headingAccuracy: sample.headingAccuracy, timestamp: timestamp)
+    }
+
+    private func blend(_ vector: inout (x: Double, y: Double)?, degrees: Double) -> (x: Double, y: Double) {
+        let radians = degrees * Double.pi / 180.0
+        let sample = (x: sin(radians), y: cos(radians))
+        guard let previous = vector else {
+            vector = sample
+            return sample
+        }
+        let blended = (
+            x: previous.x + smoothingFactor * (sample.x - previous.x),
+            y: previous.y + smoothingFactor * (sample.y - previous.y)
+        )
+        vector = blended
+        return blended
+    }
+
+    static func angle(of vector: (x: Double, y: Double)) -> Double {
+        let degrees = atan2(vector.x, vector.y) * 180.0 / Double.pi
+        return degrees < 0 ? degrees + 360.0 : degrees
+    }
+
+    // Smallest angle between two headings, 0...180
+    static func angularDifference(_ first: CLLocationDirection, _ second: CLLocationDirection) -> CLLocationDirection {
+        let difference = abs(first - second).truncatingRemainder(dividingBy: 360.0)
+        return difference > 180.0 ? 360.0 - difference : difference
+    }
+}
@@ -0,0 +1,98 @@
+//
+//  LocationAccuracyGovernor.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import CoreLocation
+import Foundation
+
+struct LocationAccuracySettings: Equatable {
+    var desiredAccuracy: CLLocationAccuracy
+    var distanceFilter: CLLocationDistance
+}
+
+// Picks the cheapest GPS settings that still keep up with what we send.
+// There is no point running the GPS at full power for a fix every second
+// when we only broadcast once a minute, or when we're barely moving.
+struct LocationAccuracyGovernor {
+    static let LOW_BATTERY_LEVEL: Float = 0.2
+    static let CRITICAL_BATTERY_LEVEL: Float = 0.1
+
+    // Below this we treat the device as stationary
+    static let MOVING_SPEED: CLLocationSpeed = 0.5
+    // Roughly vehicle speed, where position changes quickly between broadcasts
+    static let FAST_SPEED: CLLocationSpeed = 10.0
+    // With no fix for this long the distance filter is holding them back,
+    // so we've moved less than it since and count as stationary
+    static let STATIONARY_AFTER_SECONDS: TimeInterval = 60.0
+
+    static let MIN_DISTANCE_FILTER: CLLocationDistance = 5.0
+    static let MAX_DISTANCE_FILTER: CLLocationDistance = 100.0
+
+    // Ordered from most to least power hungry
+    static let ACCURACY_TIERS: [CLLocationAccuracy] = [
+        kCLLocationAccuracyBest,
+        kCLLocationAccuracyNearestTenMeters,
+        kCLLocationAccuracyHundredMeters,
+        kCLLocationAccuracyKilometer
+    ]
+
+    // Settings for now, given the last fix we got. A fix's speed goes stale
+    // once the fixes stop, e.g. when parked after a drive.
+    static func settings(broadcastInterval: TimeInterval,
+                         lastFix: CLLocation?,
+                         now: Date,
+                         batteryLevel: Float) -> LocationAccuracySettings {
+        var speed = lastFix?.speed ?? 0
+        if let lastFix = lastFix,
+           now.timeIntervalSince(lastFix.timestamp) >= STATIONARY_AFTER_SECONDS {
+            speed = 0
+        }
+        return settings(broadcastInterval: broadcastInterval, speed: speed, batteryLevel: batteryLevel)
+    }
+
+    // batteryLevel is 0.0 - 1.0 as returned by AppConstants.getPhoneBatteryStatus
+    // Anything at or below zero means the level is unknown and is ignored
+    static func settings(broadcastInterval: TimeInterval,
+                         speed: CLLocationSpeed,
+                         batteryLevel: Float) -> LocationAccuracySettings {
+        let groundSpeed = max(speed, 0)
+        let isMoving = groundSpeed >= MOVING_SPEED
+
+        var tier: Int
+        if(broadcastInterval <= 5 || groundSpeed >= FAST_SPEED) {
+            tier = 0
+        } else if(broadcastInterval <= 30) {
+            tier = 1
+        } else {
+            tier = 2
+        }
+
+        // A stationary device doesn't need a sharper fix than a walking one
+        if(!isMoving) {
+            tier = max(tier, 1)
+        }
+
+        let batteryKnown = batteryLevel > 0
+        if(batteryKnown && batteryLevel <= CRITICAL_BATTERY_LEVEL) {
+            tier += 2
+        } else if(batteryKnown && batteryLevel <= LOW_BATTERY_LEVEL) {
+            tier += 1
+        }
+        tier = min(tier, ACCURACY_TIERS.count - 1)
+
+        // Ask for roughly two fixes per broadcast interval worth of travel
+        var distanceFilter = groundSpeed * broadcastInterval / 2.0
+        distanceFilter = min(max(distanceFilter, MIN_DISTANCE_FILTER), MAX_DISTANCE_FILTER)
+        if(batteryKnown && batteryLevel <= LOW_BATTERY_LEVEL) {
+            distanceFilter *= 2
+        }
+
+        return LocationAccuracySettings(
+            desiredAccuracy: ACCURACY_TIERS[tier],
+            distanceFilter: distanceFilter
+        )
+    }
+}
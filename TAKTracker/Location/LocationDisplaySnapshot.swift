@@ -0,0 +1,39 @@
+//
+//  LocationDisplaySnapshot.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import CoreLocation
+import Foundation
+
+// A location/heading pair as the main screen would render it.
+// Two snapshots are equal when nothing on screen would change
+// between them, so the UI only redraws for visible differences.
+//
+// Equality is on the formatted readout in the units being shown, not
+// on a fixed precision: DMS shows a thousandth of an arc second (about
+// 3cm), but MGRS only shows whole meters and decimal degrees about 11m,
+// so GPS jitter on a stationary device only redraws in DMS.
+struct LocationDisplaySnapshot: Equatable {
+    let location: CLLocation?
+    let heading: HeadingReading?
+
+    private let readout: [String]
+
+    init(location: CLLocation?, heading: HeadingReading?, units: DisplayUIState = DisplayUIState()) {
+        self.location = location
+        self.heading = heading
+
+        var readout = units.coordinateValue(location: location).lines.map { $0.lineTitle + " " + $0.lineContents }
+        readout.append(units.speedValue(location: location))
+        readout.append(units.headingValue(unit: units.currentHeadingUnit, heading: heading))
+        readout.append(units.headingValue(unit: units.currentCompassUnit, heading: heading))
+        self.readout = readout
+    }
+
+    static func == (lhs: LocationDisplaySnapshot, rhs: LocationDisplaySnapshot) -> Bool {
+        return lhs.readout == rhs.readout
+    }
+}
@@ -0,0 +1,216 @@
+//
+//  LocationReplaySource.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Combine
+import CoreLocation
+import Foundation
+
+// Time as seen by a replay. Only moves when advanced, so a replay can be
+// stepped deterministically in tests or driven from a real timer.
+final class VirtualClock {
+    private(set) var now: Date
+
+    init(start: Date = Date(timeIntervalSince1970: 0)) {
+        now = start
+    }
+
+    func advance(by seconds: TimeInterval) {
+        now = now.addingTimeInterval(max(seconds, 0))
+    }
+
+    func advance(to date: Date) {
+        if(date > now) {
+            now = date
+        }
+    }
+}
+
+// Plays a recorded track (GPX or NMEA) through the same interface as
+// LocationManager so everything downstream of location can be run
+// without real movement. Fix timestamps are rebased onto the virtual
+// clock, and rate scales virtual time against wall time when running
+// from a timer (1 = real time, 100 = one hundred times faster).
+final class LocationReplaySource: ObservableObject, LocationSource {
+    @Published private(set) var lastLocation: CLLocation?
+    @Published private(set) var lastHeading: HeadingReading?
+
+    private(set) var currentLocation: CLLocation?
+    private(set) var currentHeading: HeadingReading?
+    let locationUpdates = PassthroughSubject<CLLocation, Never>()
+    let significantHeadingChanges = PassthroughSubject<HeadingReading, Never>()
+
+    var lastLocationPublisher: AnyPublisher<CLLocation?, Never> {
+        $lastLocation.eraseToAnyPublisher()
+    }
+
+    var lastHeadingPublisher: AnyPublisher<HeadingReading?, Never> {
+        $lastHeading.eraseToAnyPublisher()
+    }
+
+    let clock: VirtualClock
+    var rate: Double
+    var headingChangeThreshold: CLLocationDegrees = 30.0
+
+    private let fixes: [CLLocation]
+    private let replayStart: Date
+    private var nextFixIndex = 0
+    private var lastSignificantHeading: HeadingReading?
+    private var timer: DispatchSourceTimer?
+
+    var isFinished: Bool {
+        nextFixIndex >= fixes.count
+    }
+
+    var emittedFixCount: Int {
+        nextFixIndex
+    }
+
+    // Virtual time covered by the whole track
+    var duration: TimeInterval {
+        guard let first = fixes.first, let last = fixes.last else { return 0 }
+        return last.timestamp.timeIntervalSince(first.timestamp)
+    }
+
+    init(locations: [CLLocation], rate: Double = 1.0, clock: VirtualClock = VirtualClock()) {
+        self.clock = clock
+        self.rate = rate
+        self.replayStart = clock.now
+        self.fixes = LocationReplaySource.fillingMotion(
+            locations.sorted { $0.timestamp < $1.timestamp }
+        )
+    }
+
+    convenience init(gpxData: Data, rate: Double = 1.0, clock: VirtualClock = VirtualClock()) {
+        self.init(locations: GPXTrackParser.parse(data: gpxData), rate: rate, clock: clock)
+    }
+
+    convenience init(nmeaData: Data, rate: Double = 1.0, clock: VirtualClock = VirtualClock()) {
+        self.init(locations: NMEATrackParser.parse(data: nmeaData), rate: rate, clock: clock)
+    }
+
+    // Recorded tracks often omit speed and course, so derive them from
+    // the previous point when they're missing
+    static func fillingMotion(_ locations: [CLLocation]) -> [CLLocation] {
+        guard locations.count > 1 else { return locations }
+        var filled: [CLLocation] = [locations[0]]
+        filled.reserveCapacity(locations.count)
+
+        for index in 1..<locations.count {
+            let previous = locations[index - 1]
+            let location = locations[index]
+            if(location.speed >= 0 && location.course >= 0) {
+                filled.append(location)
+                continue
+            }
+
+            let elapsed = location.timestamp.timeIntervalSince(previous.timestamp)
+            let distance = location.distance(from: previous)
+            let speed = location.speed >= 0 ? location.speed : (elapsed > 0 ? distance / elapsed : -1)
+            let course = location.course >= 0 ? location.course : (distance > 0 ? bearing(from: previous.coordinate, to: location.coordinate) : -1)
+
+            filled.append(CLLocation(
+                coordinate: location.coordinate,
+                altitude: location.altitude,
+                horizontalAccuracy: location.horizontalAccuracy,
+                verticalAccuracy: location.verticalAccuracy,
+                course: course,
+                speed: speed,
+                timestamp: location.timestamp
+            ))
+        }
+        return filled
+    }
+
+    static func bearing(from start: CLLocationCoordinate2D, to end: CLLocationCoordinate2D) -> CLLocationDirection {
+        let lat1 = start.latitude * Double.pi / 180.0
+        let lat2 = end.latitude * Double.pi / 180.0
+        let deltaLon = (end.longitude - start.longitude) * Double.pi / 180.0
+        let y = sin(deltaLon) * cos(lat2)
+        let x = cos(lat1) * sin(lat2) - sin(lat1) * cos(lat2) * cos(deltaLon)
+        let degrees = atan2(y, x) * 180.0 / Double.pi
+        return degrees < 0 ? degrees + 360.0 : degrees
+    }
+
+    // Advances virtual time and emits every fix that has come due
+    func advance(by seconds: TimeInterval) {
+        clock.advance(by: seconds)
+        emitDueFixes()
+    }
+
+    // Emits the rest of the track as fast as possible
+    func runToEnd() {
+        guard let first = fixes.first, let last = fixes.last else { return }
+        clock.advance(to: replayStart.addingTimeInterval(last.timestamp.timeIntervalSince(first.timestamp)))
+        emitDueFixes()
+    }
+
+    // Drives the replay from a wall clock timer at the configured rate
+    func start(queue: DispatchQueue = .main, tickInterval: TimeInterval = 0.05) {
+        stop()
+        let newTimer = DispatchSource.makeTimerSource(queue: queue)
+        newTimer.schedule(deadline: .now(), repeating: tickInterval)
+        newTimer.setEventHandler { [weak self] in
+            guard let self = self else { return }
+            self.advance(by: tickInterval * self.rate)
+            if(self.isFinished) {
+                self.stop()
+            }
+        }
+        timer = newTimer
+        newTimer.resume()
+    }
+
+    func stop() {
+        timer?.cancel()
+        timer = nil
+    }
+
+    private func emitDueFixes() {
+        guard let first = fixes.first else { return }
+        let elapsed = clock.now.timeIntervalSince(replayStart)
+
+        while(nextFixIndex < fixes.count) {
+            let fix = fixes[nextFixIndex]
+            let offset = fix.timestamp.timeIntervalSince(first.timestamp)
+            if(offset > elapsed) {
+                break
+            }
+            nextFixIndex += 1
+            emit(fix: fix, at: replayStart.addingTimeInterval(offset))
+        }
+    }
+
+    private func emit(fix: CLLocation, at timestamp: Date) {
+        let location = CLLocation(
+            coordinate: fix.coordinate,
+            altitude: fix.altitude,
+            horizontalAccuracy: fix.horizontalAccuracy,
+            verticalAccuracy: fix.verticalAccuracy,
+            course: fix.course,
+            speed: fix.speed,
+            timestamp: timestamp
+        )
+        currentLocation = location
+        lastLocation = location
+        locationUpdates.send(location)
+
+        // Recorded tracks have no compass, so course over ground stands in
+        guard fix.course >= 0 else { return }
+        let heading = HeadingReading(trueHeading: fix.course, magneticHeading: fix.course, headingAccuracy: 0, timestamp: timestamp)
+        currentHeading = heading
+        lastHeading = heading
+
+        if let previous = lastSignificantHeading {
+            if(HeadingSmoother.angularDifference(previous.course, heading.course) >= headingChangeThreshold) {
+                lastSignificantHeading = heading
+                significantHeadingChanges.send(heading)
+            }
+        } else {
+            lastSignificantHeading = heading
+        }
+    }
+}
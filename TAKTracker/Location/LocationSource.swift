@@ -0,0 +1,26 @@
+//
+//  LocationSource.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Combine
+import CoreLocation
+import Foundation
+
+// Anything that can drive the app's position: the device GPS through
+// LocationManager, or a recorded track through LocationReplaySource.
+protocol LocationSource: AnyObject {
+    // Latest fix and heading, updated on every callback
+    var currentLocation: CLLocation? { get }
+    var currentHeading: HeadingReading? { get }
+
+    // Every fix as it arrives
+    var locationUpdates: PassthroughSubject<CLLocation, Never> { get }
+    var significantHeadingChanges: PassthroughSubject<HeadingReading, Never> { get }
+
+    // Display values as the UI sees them
+    var lastLocationPublisher: AnyPublisher<CLLocation?, Never> { get }
+    var lastHeadingPublisher: AnyPublisher<HeadingReading?, Never> { get }
+}
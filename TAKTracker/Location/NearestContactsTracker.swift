@@ -0,0 +1,255 @@
+//
+//  NearestContactsTracker.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+struct ContactRangeBearing: Equatable {
+    var uid: String
+    // Meters
+    var range: Double
+    // Degrees true
+    var bearing: Double
+}
+
+// Keeps the k nearest contacts to our own position without measuring
+// every contact on every fix.
+//
+// A full pass over all contacts (the batch kernel) records an origin, the
+// k-th nearest range R there, and a band of every contact within
+// R + 2 * slack of the origin. As long as we've drifted less than slack
+// from the origin, nobody outside the band can be nearer than
+// R + 2 * slack - drift, so only band members need measuring. Contacts
+// that move are re-measured from the origin and moved in or out of the
+// band. A full pass happens again once we've drifted past slack, or if
+// the band can no longer prove its answer.
+//
+// Not thread safe. Owners serialize access.
+struct NearestContactsTracker {
+    static let DEFAULT_COUNT = 10
+    static let DEFAULT_SLACK_METERS = 250.0
+
+    let k: Int
+    let slack: Double
+
+    private var kernel = RangeBearingKernel()
+    private var uids: [String] = []
+    private var indexByUID: [String: Int] = [:]
+    private var inBand: [Bool] = []
+    private var band = Set<Int>()
+
+    private var selfLatitude: Double?
+    private var selfLongitude: Double?
+    private var originLatitude = 0.0
+    private var originLongitude = 0.0
+    private var bandRadius = -1.0
+    private var hasOrigin = false
+
+    private var ranges: [Double] = []
+    private var cached: [ContactRangeBearing]?
+
+    private(set) var fullPassCount = 0
+
+    init(k: Int = NearestContactsTracker.DEFAULT_COUNT, slack: Double = NearestContactsTracker.DEFAULT_SLACK_METERS) {
+        self.k = k
+        self.slack = slack
+    }
+
+    var count: Int {
+        uids.count
+    }
+
+    mutating func updateSelf(latitude: Double, longitude: Double) {
+        if(latitude == selfLatitude && longitude == selfLongitude) {
+            return
+        }
+        selfLatitude = latitude
+        selfLongitude = longitude
+        cached = nil
+    }
+
+    mutating func upsertContact(uid: String, latitude: Double, longitude: Double) {
+        if let index = indexByUID[uid] {
+            let latitudeRadians = latitude * RangeBearingKernel.DEGREES_TO_RADIANS
+            let longitudeRadians = longitude * RangeBearingKernel.DEGREES_TO_RADIANS
+            if(kernel.latitudes[index] == latitudeRadians && kernel.longitudes[index] == longitudeRadians) {
+                return
+            }
+            kernel.set(index, latitude: latitude, longitude: longitude)
+            placeInBand(index)
+        } else {
+            let index = uids.count
+            indexByUID[uid] = index
+            uids.append(uid)
+            inBand.append(false)
+            kernel.append(latitude: latitude, longitude: longitude)
+            placeInBand(index)
+        }
+        cached = nil
+    }
+
+    mutating func removeContact(uid: String) {
+        guard let index = indexByUID.removeValue(forKey: uid) else { return }
+        if(inBand[index]) {
+            band.remove(index)
+        }
+        let last = uids.count - 1
+        if(index != last) {
+            uids[index] = uids[last]
+            inBand[index] = inBand[last]
+            indexByUID[uids[index]] = index
+            if(inBand[last]) {
+                band.remove(last)
+                band.insert(index)
+            }
+        }
+        uids.removeLast()
+        inBand.removeLast()
+        kernel.swapRemove(index)
+        cached = nil
+    }
+
+    mutating func removeAll() {
+        kernel.removeAll()
+        uids.removeAll()
+        indexByUID.removeAll()
+        inBand.removeAll()
+        band.removeAll()
+        hasOrigin = false
+        cached = nil
+    }
+
+    // Nearest contacts first
+    mutating func nearest() -> [ContactRangeBearing] {
+        if let cached = cached {
+            return cached
+        }
+        guard let latitude = selfLatitude, let longitude = selfLongitude else {
+            return []
+        }
+
+        var result: [ContactRangeBearing]? = nil
+        if(hasOrigin) {
+            let drift = RangeBearingKernel.range(fromLatitude: originLatitude, longitude: originLongitude, toLatitude: latitude, longitude: longitude)
+            if(drift <= slack) {
+                result = nearestInBand(latitude: latitude, longitude: longitude, drift: drift)
+            }
+        }
+        if(result == nil) {
+            fullPass(latitude: latitude, longitude: longitude)
+            result = nearestInBand(latitude: latitude, longitude: longitude, drift: 0)
+        }
+        cached = result ?? []
+        return cached!
+    }
+
+    // Ranges and bearings for every contact, straight from the batch kernel
+    func table() -> [ContactRangeBearing] {
+        guard let latitude = selfLatitude, let longitude = selfLongitude else {
+            return []
+        }
+        var allRanges: [Double] = []
+        var allBearings: [Double] = []
+        kernel.ranges(fromLatitude: latitude, longitude: longitude, into: &allRanges)
+        kernel.bearings(fromLatitude: latitude, longitude: longitude, into: &allBearings)
+        return (0..<uids.count).map {
+            ContactRangeBearing(uid: uids[$0], range: allRanges[$0], bearing: allBearings[$0])
+        }
+    }
+
+    private mutating func fullPass(latitude: Double, longitude: Double) {
+        fullPassCount += 1
+        originLatitude = latitude
+        originLongitude = longitude
+        hasOrigin = true
+
+        kernel.ranges(fromLatitude: latitude, longitude: longitude, into: &ranges)
+        let kthRange: Double
+        if(ranges.count <= k) {
+            kthRange = ranges.max() ?? 0
+        } else {
+            var sorted = ranges
+            let kthIndex = k - 1
+            sorted.withUnsafeMutableBufferPointer { buffer in
+                NearestContactsTracker.select(buffer, kthIndex)
+            }
+            kthRange = sorted[kthIndex]
+        }
+        bandRadius = kthRange + 2.0 * slack
+
+        band.removeAll(keepingCapacity: true)
+        for index in 0..<ranges.count {
+            inBand[index] = ranges[index] <= bandRadius
+            if(inBand[index]) {
+                band.insert(index)
+            }
+        }
+    }
+
+    // nil when the band can't prove it holds the k nearest
+    private func nearestInBand(latitude: Double, longitude: Double, drift: Double) -> [ContactRangeBearing]? {
+        var measured: [(index: Int, range: Double)] = band.map {
+            (index: $0, range: kernel.range(fromLatitude: latitude, longitude: longitude, to: $0))
+        }
+        measured.sort { $0.range < $1.range }
+        let nearest = measured.prefix(k)
+
+        // Everyone outside the band is at least this far away
+        let outsideBound = bandRadius - drift
+        let hasOutsiders = band.count < uids.count
+        if(hasOutsiders && (nearest.count < k || (nearest.last?.range ?? 0) > outsideBound)) {
+            return nil
+        }
+
+        return nearest.map {
+            ContactRangeBearing(
+                uid: uids[$0.index],
+                range: $0.range,
+                bearing: kernel.bearing(fromLatitude: latitude, longitude: longitude, to: $0.index)
+            )
+        }
+    }
+
+    private mutating func placeInBand(_ index: Int) {
+        guard hasOrigin else { return }
+        let isInside = kernel.range(fromLatitude: originLatitude, longitude: originLongitude, to: index) <= bandRadius
+        if(isInside != inBand[index]) {
+            inBand[index] = isInside
+            if(isInside) {
+                band.insert(index)
+            } else {
+                band.remove(index)
+            }
+        }
+    }
+
+    // Quickselect: puts the k-th smallest value at index k
+    private static func select(_ values: UnsafeMutableBufferPointer<Double>, _ k: Int) {
+        var low = 0
+        var high = values.count - 1
+        while(low < high) {
+            let pivot = values[(low + high) / 2]
+            var i = low
+            var j = high
+            while(i <= j) {
+                while(values[i] < pivot) { i += 1 }
+                while(values[j] > pivot) { j -= 1 }
+                if(i <= j) {
+                    values.swapAt(i, j)
+                    i += 1
+                    j -= 1
+                }
+            }
+            if(k <= j) {
+                high = j
+            } else if(k >= i) {
+                low = i
+            } else {
+                return
+            }
+        }
+    }
+}
@@ -0,0 +1,134 @@
+//
+//  RangeBearing.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+// Batch great-circle range and bearing from one origin to many points.
+//
+// Points are stored as parallel arrays of radians with their sines and
+// cosines precomputed, so a pass over them is straight-line arithmetic
+// over contiguous Doubles with no boxing and no per-point trig on the
+// point's own latitude.
+struct RangeBearingKernel {
+    static let EARTH_RADIUS_METERS = 6_371_008.8
+    static let DEGREES_TO_RADIANS = Double.pi / 180.0
+    static let RADIANS_TO_DEGREES = 180.0 / Double.pi
+
+    private(set) var latitudes = ContiguousArray<Double>()
+    private(set) var longitudes = ContiguousArray<Double>()
+    private var sinLatitudes = ContiguousArray<Double>()
+    private var cosLatitudes = ContiguousArray<Double>()
+
+    var count: Int {
+        latitudes.count
+    }
+
+    mutating func reserveCapacity(_ capacity: Int) {
+        latitudes.reserveCapacity(capacity)
+        longitudes.reserveCapacity(capacity)
+        sinLatitudes.reserveCapacity(capacity)
+        cosLatitudes.reserveCapacity(capacity)
+    }
+
+    mutating func append(latitude: Double, longitude: Double) {
+        let latitudeRadians = latitude * RangeBearingKernel.DEGREES_TO_RADIANS
+        latitudes.append(latitudeRadians)
+        longitudes.append(longitude * RangeBearingKernel.DEGREES_TO_RADIANS)
+        sinLatitudes.append(sin(latitudeRadians))
+        cosLatitudes.append(cos(latitudeRadians))
+    }
+
+    mutating func set(_ index: Int, latitude: Double, longitude: Double) {
+        let latitudeRadians = latitude * RangeBearingKernel.DEGREES_TO_RADIANS
+        latitudes[index] = latitudeRadians
+        longitudes[index] = longitude * RangeBearingKernel.DEGREES_TO_RADIANS
+        sinLatitudes[index] = sin(latitudeRadians)
+        cosLatitudes[index] = cos(latitudeRadians)
+    }
+
+    mutating func swapRemove(_ index: Int) {
+        let last = latitudes.count - 1
+        if(index != last) {
+            latitudes[index] = latitudes[last]
+            longitudes[index] = longitudes[last]
+            sinLatitudes[index] = sinLatitudes[last]
+            cosLatitudes[index] = cosLatitudes[last]
+        }
+        latitudes.removeLast()
+        longitudes.removeLast()
+        sinLatitudes.removeLast()
+        cosLatitudes.removeLast()
+    }
+
+    mutating func removeAll() {
+        latitudes.removeAll()
+        longitudes.removeAll()
+        sinLatitudes.removeAll()
+        cosLatitudes.removeAll()
+    }
+
+    // Haversine distance in meters from the origin to every point
+    func ranges(fromLatitude latitude: Double, longitude: Double, into output: inout [Double]) {
+        let originLatitude = latitude * RangeBearingKernel.DEGREES_TO_RADIANS
+        let originLongitude = longitude * RangeBearingKernel.DEGREES_TO_RADIANS
+        let originCos = cos(originLatitude)
+        let diameter = 2.0 * RangeBearingKernel.EARTH_RADIUS_METERS
+
+        output.removeAll(keepingCapacity: true)
+        output.reserveCapacity(latitudes.count)
+        latitudes.withUnsafeBufferPointer { lat in
+            longitudes.withUnsafeBufferPointer { lon in
+                cosLatitudes.withUnsafeBufferPointer { cosLat in
+                    for index in 0..<lat.count {
+                        let halfDeltaLatitude = sin((lat[index] - originLatitude) * 0.5)
+                        let halfDeltaLongitude = sin((lon[index] - originLongitude) * 0.5)
+                        let a = halfDeltaLatitude * halfDeltaLatitude
+                            + originCos * cosLat[index] * halfDeltaLongitude * halfDeltaLongitude
+                        output.append(diameter * asin(min(1.0, a.squareRoot())))
+                    }
+                }
+            }
+        }
+    }
+
+    func range(fromLatitude latitude: Double, longitude: Double, to index: Int) -> Double {
+        let originLatitude = latitude * RangeBearingKernel.DEGREES_TO_RADIANS
+        let halfDeltaLatitude = sin((latitudes[index] - originLatitude) * 0.5)
+        let halfDeltaLongitude = sin((longitudes[index] - longitude * RangeBearingKernel.DEGREES_TO_RADIANS) * 0.5)
+        let a = halfDeltaLatitude * halfDeltaLatitude
+            + cos(originLatitude) * cosLatitudes[index] * halfDeltaLongitude * halfDeltaLongitude
+        return 2.0 * RangeBearingKernel.EARTH_RADIUS_METERS * asin(min(1.0, a.squareRoot()))
+    }
+
+    static func range(fromLatitude latitude: Double, longitude: Double, toLatitude otherLatitude: Double, longitude otherLongitude: Double) -> Double {
+        let latitude1 = latitude * DEGREES_TO_RADIANS
+        let latitude2 = otherLatitude * DEGREES_TO_RADIANS
+        let halfDeltaLatitude = sin((latitude2 - latitude1) * 0.5)
+        let halfDeltaLongitude = sin((otherLongitude - longitude) * DEGREES_TO_RADIANS * 0.5)
+        let a = halfDeltaLatitude * halfDeltaLatitude + cos(latitude1) * cos(latitude2) * halfDeltaLongitude * halfDeltaLongitude
+        return 2.0 * EARTH_RADIUS_METERS * asin(min(1.0, a.squareRoot()))
+    }
+
+    // Initial bearing in degrees true (0..<360) from the origin to a point
+    func bearing(fromLatitude latitude: Double, longitude: Double, to index: Int) -> Double {
+        let originLatitude = latitude * RangeBearingKernel.DEGREES_TO_RADIANS
+        let deltaLongitude = longitudes[index] - longitude * RangeBearingKernel.DEGREES_TO_RADIANS
+        let y = sin(deltaLongitude) * cosLatitudes[index]
+        let x = cos(originLatitude) * sinLatitudes[index] - sin(originLatitude) * cosLatitudes[index] * cos(deltaLongitude)
+        let degrees = atan2(y, x) * RangeBearingKernel.RADIANS_TO_DEGREES
+        return degrees < 0 ? degrees + 360.0 : degrees
+    }
+
+    // Bearings for every point, for when the whole table is wanted
+    func bearings(fromLatitude latitude: Double, longitude: Double, into output: inout [Double]) {
+        output.removeAll(keepingCapacity: true)
+        output.reserveCapacity(latitudes.count)
+        for index in 0..<latitudes.count {
+            output.append(bearing(fromLatitude: latitude, longitude: longitude, to: index))
+        }
+    }
+}
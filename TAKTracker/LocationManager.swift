@@ -5,29 +5,118 @@
 //  Created by Cory Foy on 7/3/23.
 //
 
+import Combine
 import UIKit
 import MapKit
 import CoreLocation
 
-class LocationManager: NSObject,CLLocationManagerDelegate, ObservableObject {
+class LocationManager: NSObject,CLLocationManagerDelegate, ObservableObject, LocationSource {
+    // Cap on how often location changes are allowed to redraw the UI
+    static let DISPLAY_UPDATES_PER_SECOND = 4.0
+    // How often to revisit GPS accuracy and distance filter settings
+    static let ACCURACY_REVIEW_SECONDS = 30.0
+    // How long heading callbacks can pause before the smoothed heading is
+    // settled onto the last raw reading, and how often it's nudged after
+    static let HEADING_SETTLE_SECONDS = 0.25
+    
     @Published var region = MKCoordinateRegion()
     @Published var locationStatus: CLAuthorizationStatus?
-    @Published var lastLocation: CLLocation?
-    @Published var lastHeading: CLHeading?
+    
+    // What the screen shows. These are throttled to the display rate and
+    // only published when the rendered values would actually change
+    @Published private(set) var lastLocation: CLLocation?
+    @Published private(set) var lastHeading: HeadingReading?
+    // The units the screen shows those in, which decide what counts as a
+    // visible change
+    var displayUnits = DisplayUIState() {
+        didSet {
+            displayUpdates.send()
+        }
+    }
+    
+    // Every fix as it arrives, for broadcasting. Reading these or
+    // subscribing to locationUpdates does not invalidate any views
+    private(set) var currentLocation: CLLocation?
+    private(set) var currentHeading: HeadingReading?
+    let locationUpdates = PassthroughSubject<CLLocation, Never>()
+    
+    var lastLocationPublisher: AnyPublisher<CLLocation?, Never> {
+        $lastLocation.eraseToAnyPublisher()
+    }
+    
+    var lastHeadingPublisher: AnyPublisher<HeadingReading?, Never> {
+        $lastHeading.eraseToAnyPublisher()
+    }
+    
+    // Fires when the smoothed heading has turned more than
+    // headingChangeThreshold degrees since it last fired
+    let significantHeadingChanges = PassthroughSubject<HeadingReading, Never>()
+    
+    // Minimum change in degrees before Core Location reports a new heading
+    var headingFilter: CLLocationDegrees = 2.0 {
+        didSet {
+            manager.headingFilter = headingFilter
+        }
+    }
+    
+    var headingChangeThreshold: CLLocationDegrees = 30.0
     
     var shouldUpdateCoordinateRegion = true
+    
+    // Our own breadcrumb trail, persisted across launches
+    let trackStore: TrackStore?
 
     private let manager = CLLocationManager()
+    private let displayUpdates = PassthroughSubject<Void, Never>()
+    private var displaySubscription: AnyCancellable?
+    private var headingSmoother = HeadingSmoother()
+    private var lastSignificantHeading: HeadingReading?
+    private var lastHeadingCallback: Date?
+    private var headingSettleTimer: Timer?
+    private var accuracySettings = LocationAccuracySettings(desiredAccuracy: kCLLocationAccuracyBest, distanceFilter: kCLDistanceFilterNone)
+    private var lastAccuracyReview: Date?
+    // Fixes stop coming once the distance filter holds them back, so the
+    // review also runs on a timer to step a stationary device down
+    private var accuracyReviewTimer: Timer?
 
     override init() {
+        do {
+            trackStore = try TrackStore()
+        } catch {
+            TAKLogger.error("[LocationManager]: Unable to open the track store: \(error)")
+            trackStore = nil
+        }
         super.init()
+        displaySubscription = displayUpdates
+            .throttle(for: .seconds(1.0 / LocationManager.DISPLAY_UPDATES_PER_SECOND), scheduler: DispatchQueue.main, latest: true)
+            .map { [unowned self] in
+                LocationDisplaySnapshot(location: self.currentLocation, heading: self.currentHeading, units: self.displayUnits)
+            }
+            .removeDuplicates()
+            .sink { [weak self] snapshot in
+                self?.publishDisplay(snapshot: snapshot)
+            }
         manager.delegate = self
-        manager.desiredAccuracy = kCLLocationAccuracyBest
+        // Start at full accuracy to get a quick first fix. The
+        // accuracy governor dials this back once we know our speed
+        manager.desiredAccuracy = accuracySettings.desiredAccuracy
+        manager.distanceFilter = accuracySettings.distanceFilter
         manager.allowsBackgroundLocationUpdates = true
         manager.showsBackgroundLocationIndicator = true
+        // Paused updates are not resumed while we're in the background,
+        // which would silently stop tracking, so we never let iOS pause
         manager.pausesLocationUpdatesAutomatically = false
+        manager.headingFilter = headingFilter
         manager.startUpdatingLocation()
         manager.startUpdatingHeading()
+        accuracyReviewTimer = Timer.scheduledTimer(withTimeInterval: LocationManager.ACCURACY_REVIEW_SECONDS, repeats: true) { [weak self] _ in
+            self?.reviewAccuracy(now: Date())
+        }
+    }
+    
+    deinit {
+        accuracyReviewTimer?.invalidate()
+        headingSettleTimer?.invalidate()
     }
     
     func requestAlwaysAuthorization() {
@@ -61,19 +150,94 @@ class LocationManager: NSObject,CLLocationManagerDelegate, ObservableObject {
     
     func locationManager(_ manager: CLLocationManager, didUpdateLocations locations: [CLLocation]) {
         guard let location = locations.last else { TAKLogger.debug("No Locations!"); return }
-        lastLocation = location
+        currentLocation = location
+        trackStore?.append(location: location)
+        locationUpdates.send(location)
+        displayUpdates.send()
+        reviewAccuracy(now: location.timestamp)
+    }
+    
+    private func reviewAccuracy(now: Date) {
+        if let lastReview = lastAccuracyReview,
+           now.timeIntervalSince(lastReview) < LocationManager.ACCURACY_REVIEW_SECONDS {
+            return
+        }
+        lastAccuracyReview = now
+        
+        let settings = LocationAccuracyGovernor.settings(
+            broadcastInterval: SettingsStore.global.broadcastIntervalSeconds,
+            lastFix: currentLocation,
+            now: now,
+            batteryLevel: AppConstants.getPhoneBatteryStatus()
+        )
+        
+        if(settings != accuracySettings) {
+            TAKLogger.debug("[LocationManager]: Adjusting accuracy to \(settings.desiredAccuracy)m with a \(settings.distanceFilter)m distance filter")
+            accuracySettings = settings
+            manager.desiredAccuracy = settings.desiredAccuracy
+            manager.distanceFilter = settings.distanceFilter
+        }
+    }
+    
+    func locationManager(_ manager: CLLocationManager, didUpdateHeading newHeading: CLHeading) {
+        // A negative accuracy means the reading is not valid
+        guard newHeading.headingAccuracy >= 0 else { return }
+        
+        let heading = headingSmoother.add(
+            trueHeading: newHeading.trueHeading,
+            magneticHeading: newHeading.magneticHeading,
+            headingAccuracy: newHeading.headingAccuracy,
+            timestamp: newHeading.timestamp
+        )
+        lastHeadingCallback = Date()
+        if(headingSettleTimer == nil) {
+            headingSettleTimer = Timer.scheduledTimer(withTimeInterval: LocationManager.HEADING_SETTLE_SECONDS, repeats: true) { [weak self] _ in
+                self?.settleHeading()
+            }
+        }
+        updateHeading(heading)
+    }
+    
+    private func settleHeading() {
+        if let lastCallback = lastHeadingCallback,
+           Date().timeIntervalSince(lastCallback) < LocationManager.HEADING_SETTLE_SECONDS {
+            return
+        }
+        guard let heading = headingSmoother.settle(timestamp: Date()) else {
+            headingSettleTimer?.invalidate()
+            headingSettleTimer = nil
+            return
+        }
+        updateHeading(heading)
+    }
+    
+    private func updateHeading(_ heading: HeadingReading) {
+        currentHeading = heading
+        
+        if let previous = lastSignificantHeading {
+            if(HeadingSmoother.angularDifference(previous.course, heading.course) >= headingChangeThreshold) {
+                lastSignificantHeading = heading
+                significantHeadingChanges.send(heading)
+            }
+        } else {
+            lastSignificantHeading = heading
+        }
+        
+        displayUpdates.send()
+    }
+    
+    private func publishDisplay(snapshot: LocationDisplaySnapshot) {
+        lastLocation = snapshot.location
+        lastHeading = snapshot.heading
         
         if(shouldUpdateCoordinateRegion) {
-            locations.last.map {
+            snapshot.location.map {
                 region = MKCoordinateRegion(
                     center: CLLocationCoordinate2D(latitude: $0.coordinate.latitude, longitude: $0.coordinate.longitude),
                     span: MKCoordinateSpan(latitudeDelta: 0.5, longitudeDelta: 0.5)
                 )
             }
         }
-        
-        guard let heading = manager.heading else { TAKLogger.debug("No heading!"); return }
-        lastHeading = heading
     }
     
     func deviceUpdatedOrientation(orientation: UIDeviceOrientation) {
@@ -97,6 +261,10 @@ class LocationManager: NSObject,CLLocationManagerDelegate, ObservableObject {
             TAKLogger.debug("[LocationManager]: Received an unsupported device rotation. Ignoring.")
         }
         
+        // Readings from the old orientation are a quarter turn off,
+        // so don't let them bleed into the new ones
+        headingSmoother.reset()
+        
         // Let the manager know something is up
         manager.startUpdatingHeading()
     }
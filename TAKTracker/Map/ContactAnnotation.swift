@@ -0,0 +1,81 @@
+//
+//  ContactAnnotation.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import MapKit
+
+// Map annotation for a ContactCluster. Instances live as long as their
+// cluster id is on the map and are updated in place, so MapKit animates
+// moves instead of tearing views down.
+final class ContactAnnotation: NSObject, MKAnnotation {
+    let id: String
+    @objc dynamic var coordinate: CLLocationCoordinate2D
+    private(set) var cluster: ContactCluster
+
+    init(cluster: ContactCluster) {
+        self.id = cluster.id
+        self.cluster = cluster
+        self.coordinate = CLLocationCoordinate2D(latitude: cluster.latitude, longitude: cluster.longitude)
+        super.init()
+    }
+
+    var title: String? {
+        cluster.isCluster ? "\(cluster.count) contacts" : cluster.callsign
+    }
+
+    func update(cluster: ContactCluster) {
+        self.cluster = cluster
+        let newCoordinate = CLLocationCoordinate2D(latitude: cluster.latitude, longitude: cluster.longitude)
+        if(newCoordinate.latitude != coordinate.latitude || newCoordinate.longitude != coordinate.longitude) {
+            coordinate = newCoordinate
+        }
+    }
+}
+
+// Reusable marker for contacts and clusters. Views are dequeued from
+// MKMapView's pool, so configure fully resets whatever the last
+// annotation set.
+final class ContactAnnotationView: MKMarkerAnnotationView {
+    static let REUSE_IDENTIFIER = "ContactAnnotationView"
+
+    override var annotation: MKAnnotation? {
+        didSet {
+            configure()
+        }
+    }
+
+    func configure() {
+        guard let contact = annotation as? ContactAnnotation else { return }
+        let cluster = contact.cluster
+        canShowCallout = !cluster.isCluster
+        displayPriority = cluster.isCluster ? .defaultHigh : .defaultLow
+        if(cluster.isCluster) {
+            glyphText = cluster.count > 999 ? "999+" : "\(cluster.count)"
+            glyphImage = nil
+            markerTintColor = .darkGray
+        } else {
+            glyphText = nil
+            glyphImage = UIImage(systemName: "person.fill")
+            markerTintColor = ContactAnnotationView.tint(type: cluster.type)
+        }
+    }
+
+    // Standard CoT affiliation colors
+    static func tint(type: String) -> UIColor {
+        let affiliation = type.split(separator: "-").dropFirst().first ?? ""
+        switch affiliation {
+        case "f", "a":
+            return .systemBlue
+        case "h", "s", "j", "k":
+            return .systemRed
+        case "n":
+            return .systemGreen
+        default:
+            return .systemYellow
+        }
+    }
+}
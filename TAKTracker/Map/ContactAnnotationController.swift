@@ -0,0 +1,157 @@
+//
+//  ContactAnnotationController.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import MapKit
+
+// Keeps the contacts shown on an MKMapView in step with the ContactStore.
+//
+// Viewport queries and clustering run on a background queue and produce
+// a diff against what is already on the map; the main thread only adds,
+// moves or removes the annotations in that diff. Requests arriving while
+// one is pending are coalesced into the latest.
+final class ContactAnnotationController {
+    static let REFRESH_DELAY: TimeInterval = 0.05
+    static let POLL_INTERVAL: TimeInterval = 0.5
+
+    private let store: ContactStore
+    private let queue = DispatchQueue(label: "com.flighttactics.TAKTracker.ContactAnnotationController", qos: .userInitiated)
+
+    // Main thread
+    private weak var mapView: MKMapView?
+    private var annotations: [String: ContactAnnotation] = [:]
+    private var pollTimer: Timer?
+
+    // Background queue
+    private var displayedClusters: [String: ContactCluster] = [:]
+    private var latestRequest: (region: MKCoordinateRegion, mapWidth: Double)?
+    private var isRefreshScheduled = false
+    private var lastStoreVersion = -1
+
+    init(store: ContactStore) {
+        self.store = store
+    }
+
+    deinit {
+        pollTimer?.invalidate()
+    }
+
+    var annotationCount: Int {
+        annotations.count
+    }
+
+    func attach(to mapView: MKMapView) {
+        self.mapView = mapView
+        mapView.register(ContactAnnotationView.self, forAnnotationViewWithReuseIdentifier: ContactAnnotationView.REUSE_IDENTIFIER)
+
+        pollTimer?.invalidate()
+        // Picks up received contacts between map movements
+        pollTimer = Timer.scheduledTimer(withTimeInterval: ContactAnnotationController.POLL_INTERVAL, repeats: true) { [weak self] _ in
+            self?.refreshIfStoreChanged()
+        }
+    }
+
+    func annotationView(for mapView: MKMapView, annotation: MKAnnotation) -> MKAnnotationView? {
+        guard annotation is ContactAnnotation else { return nil }
+        return mapView.dequeueReusableAnnotationView(withIdentifier: ContactAnnotationView.REUSE_IDENTIFIER, for: annotation)
+    }
+
+    // Called on the main thread whenever the visible region changes
+    func setNeedsRefresh(region: MKCoordinateRegion, mapWidth: Double) {
+        queue.async {
+            self.latestRequest = (region, mapWidth)
+            self.scheduleRefresh()
+        }
+    }
+
+    private func refreshIfStoreChanged() {
+        queue.async {
+            if(self.latestRequest != nil && self.store.version != self.lastStoreVersion) {
+                self.scheduleRefresh()
+            }
+        }
+    }
+
+    private func scheduleRefresh() {
+        if(isRefreshScheduled) {
+            return
+        }
+        isRefreshScheduled = true
+        queue.asyncAfter(deadline: .now() + ContactAnnotationController.REFRESH_DELAY) {
+            self.isRefreshScheduled = false
+            self.refresh()
+        }
+    }
+
+    private func refresh() {
+        guard let request = latestRequest else { return }
+        lastStoreVersion = store.version
+        let diff = ContactAnnotationController.diff(
+            store: store,
+            region: request.region,
+            mapWidth: request.mapWidth,
+            displayed: &displayedClusters
+        )
+        if(diff.isEmpty) {
+            return
+        }
+        DispatchQueue.main.async {
+            self.apply(diff)
+        }
+    }
+
+    // Clusters the contacts around a region and updates `displayed` to match
+    static func diff(store: ContactStore, region: MKCoordinateRegion, mapWidth: Double, displayed: inout [String: ContactCluster]) -> ContactClusterDiff {
+        // Query a margin around the viewport so small pans don't expose gaps
+        let padded = MKCoordinateRegion(
+            center: region.center,
+            span: MKCoordinateSpan(
+                latitudeDelta: min(region.span.latitudeDelta * 2.0, 180.0),
+                longitudeDelta: min(region.span.longitudeDelta * 2.0, 360.0)
+            )
+        )
+        let contacts = store.contacts(in: CoordinateBounds(region: padded))
+        let zoomLevel = ContactClusterer.zoomLevel(longitudeDelta: region.span.longitudeDelta, mapWidth: mapWidth)
+        let clusters = ContactClusterer.cluster(contacts, zoomLevel: zoomLevel)
+        let diff = ContactClusterer.diff(from: displayed, to: clusters)
+
+        for id in diff.removed {
+            displayed.removeValue(forKey: id)
+        }
+        for cluster in diff.added {
+            displayed[cluster.id] = cluster
+        }
+        for cluster in diff.updated {
+            displayed[cluster.id] = cluster
+        }
+        return diff
+    }
+
+    private func apply(_ diff: ContactClusterDiff) {
+        guard let mapView = mapView else { return }
+
+        let removed = diff.removed.compactMap { annotations.removeValue(forKey: $0) }
+        if(!removed.isEmpty) {
+            mapView.removeAnnotations(removed)
+        }
+
+        for cluster in diff.updated {
+            guard let annotation = annotations[cluster.id] else { continue }
+            annotation.update(cluster: cluster)
+            (mapView.view(for: annotation) as? ContactAnnotationView)?.configure()
+        }
+
+        let added = diff.added.map { cluster -> ContactAnnotation in
+            let annotation = ContactAnnotation(cluster: cluster)
+            annotations[cluster.id] = annotation
+            return annotation
+        }
+        if(!added.isEmpty) {
+            mapView.addAnnotations(added)
+        }
+    }
+}
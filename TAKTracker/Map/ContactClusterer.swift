@@ -0,0 +1,118 @@
+//
+//  ContactClusterer.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+// One marker on the map: either a single contact or a group of nearby
+// contacts drawn as a count
+struct ContactCluster: Equatable {
+    var id: String
+    var latitude: Double
+    var longitude: Double
+    var count: Int
+    var callsign: String
+    var type: String
+
+    var isCluster: Bool {
+        count > 1
+    }
+}
+
+// What has to change on the map to go from one set of clusters to the next
+struct ContactClusterDiff: Equatable {
+    var added: [ContactCluster] = []
+    var updated: [ContactCluster] = []
+    var removed: [String] = []
+
+    var isEmpty: Bool {
+        added.isEmpty && updated.isEmpty && removed.isEmpty
+    }
+}
+
+// Grid clustering. Contacts are bucketed into cells of a power-of-two
+// fraction of the world, sized from the zoom so a cell is roughly a
+// marker's width on screen. Cells are fixed to the world rather than the
+// viewport, so clusters keep their ids while the map is panned and only
+// change when the zoom level does.
+struct ContactClusterer {
+    // Approximate marker size in points
+    static let CLUSTER_CELL_POINTS = 60.0
+    // Past this zoom every contact is drawn on its own
+    static let MAX_CLUSTER_ZOOM = 18
+
+    static func zoomLevel(longitudeDelta: Double, mapWidth: Double) -> Int {
+        guard longitudeDelta > 0, mapWidth > 0 else { return 0 }
+        let cellDegrees = longitudeDelta * CLUSTER_CELL_POINTS / mapWidth
+        return max(0, Int(floor(log2(360.0 / cellDegrees))))
+    }
+
+    static func cluster(_ contacts: [ContactRecord], zoomLevel: Int) -> [ContactCluster] {
+        if(zoomLevel >= MAX_CLUSTER_ZOOM) {
+            return contacts.map { single($0) }
+        }
+
+        let cellSize = 360.0 / pow(2.0, Double(zoomLevel))
+        let columns = Int64((360.0 / cellSize).rounded(.up))
+        var cells: [Int64: [Int]] = [:]
+        for (index, contact) in contacts.enumerated() {
+            let row = Int64(floor((contact.latitude + 90.0) / cellSize))
+            let column = Int64(floor((contact.longitude + 180.0) / cellSize))
+            cells[row * columns + column, default: []].append(index)
+        }
+
+        var clusters: [ContactCluster] = []
+        clusters.reserveCapacity(cells.count)
+        for (key, members) in cells {
+            if(members.count == 1) {
+                clusters.append(single(contacts[members[0]]))
+                continue
+            }
+            var latitude = 0.0
+            var longitude = 0.0
+            for index in members {
+                latitude += contacts[index].latitude
+                longitude += contacts[index].longitude
+            }
+            clusters.append(ContactCluster(
+                id: "cluster-\(zoomLevel)-\(key)",
+                latitude: latitude / Double(members.count),
+                longitude: longitude / Double(members.count),
+                count: members.count,
+                callsign: "",
+                type: ""
+            ))
+        }
+        return clusters
+    }
+
+    static func diff(from current: [String: ContactCluster], to next: [ContactCluster]) -> ContactClusterDiff {
+        var diff = ContactClusterDiff()
+        var remaining = current
+        for cluster in next {
+            if let existing = remaining.removeValue(forKey: cluster.id) {
+                if(existing != cluster) {
+                    diff.updated.append(cluster)
+                }
+            } else {
+                diff.added.append(cluster)
+            }
+        }
+        diff.removed = Array(remaining.keys)
+        return diff
+    }
+
+    private static func single(_ contact: ContactRecord) -> ContactCluster {
+        return ContactCluster(
+            id: contact.uid,
+            latitude: contact.latitude,
+            longitude: contact.longitude,
+            count: 1,
+            callsign: contact.callsign,
+            type: contact.type
+        )
+    }
+}
@@ -0,0 +1,244 @@
+//
+//  KMLOverlay.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import MapKit
+import sf_ios
+
+// One ring or line of a KML shape at one level of detail, in map points.
+//
+// The vertices are split into runs of CHUNK_SIZE with a bounding rect
+// each (neighbouring runs share their end vertex), so drawing a tile only
+// walks the runs that reach into it.
+struct KMLShapePart {
+    static let CHUNK_SIZE = 128
+
+    let points: ContiguousArray<MKMapPoint>
+    let isClosed: Bool
+    let bounds: MKMapRect
+    let chunkBounds: [MKMapRect]
+
+    init(points: ContiguousArray<MKMapPoint>, isClosed: Bool) {
+        self.points = points
+        self.isClosed = isClosed
+
+        var chunkBounds: [MKMapRect] = []
+        var start = 0
+        while(start < points.count - 1) {
+            let end = min(start + KMLShapePart.CHUNK_SIZE, points.count - 1)
+            chunkBounds.append(KMLShapePart.bounds(of: points[start...end]))
+            start = end
+        }
+        self.chunkBounds = chunkBounds
+        self.bounds = chunkBounds.reduce(MKMapRect.null) { $0.union($1) }
+    }
+
+    // Closed ranges of vertex indexes whose segments may cross `rect`.
+    // Touching runs are merged.
+    func visibleRanges(in rect: MKMapRect) -> [ClosedRange<Int>] {
+        guard bounds.intersects(rect) else { return [] }
+        var ranges: [ClosedRange<Int>] = []
+        for (chunk, chunkRect) in chunkBounds.enumerated() where chunkRect.intersects(rect) {
+            let start = chunk * KMLShapePart.CHUNK_SIZE
+            let end = min(start + KMLShapePart.CHUNK_SIZE, points.count - 1)
+            if let last = ranges.last, last.upperBound == start {
+                ranges[ranges.count - 1] = last.lowerBound...end
+            } else {
+                ranges.append(start...end)
+            }
+        }
+        return ranges
+    }
+
+    // The ring to fill `rect` with. A run that doesn't reach into the rect
+    // is cut down to its end vertex: the run and the straight line that
+    // replaces it both stay within the run's bounds, which miss the rect,
+    // so every point in the rect is inside the shortened ring exactly when
+    // it's inside the full one. A tile well inside a 50k vertex boundary
+    // walks one vertex per run.
+    func fillPoints(in rect: MKMapRect) -> ContiguousArray<MKMapPoint> {
+        var fill = ContiguousArray<MKMapPoint>()
+        guard let first = points.first else { return fill }
+        fill.append(first)
+        for (chunk, chunkRect) in chunkBounds.enumerated() {
+            let start = chunk * KMLShapePart.CHUNK_SIZE
+            let end = min(start + KMLShapePart.CHUNK_SIZE, points.count - 1)
+            if(chunkRect.intersects(rect)) {
+                fill.append(contentsOf: points[(start + 1)...end])
+            } else {
+                fill.append(points[end])
+            }
+        }
+        return fill
+    }
+
+    static func bounds(of points: ArraySlice<MKMapPoint>) -> MKMapRect {
+        var minX = Double.greatestFiniteMagnitude
+        var minY = Double.greatestFiniteMagnitude
+        var maxX = -Double.greatestFiniteMagnitude
+        var maxY = -Double.greatestFiniteMagnitude
+        for point in points {
+            minX = min(minX, point.x)
+            maxX = max(maxX, point.x)
+            minY = min(minY, point.y)
+            maxY = max(maxY, point.y)
+        }
+        return MKMapRect(x: minX, y: minY, width: maxX - minX, height: maxY - minY)
+    }
+}
+
+struct KMLShapeLevel {
+    // Largest deviation from the original shape, in map points. 0 is full detail.
+    let tolerance: Double
+    let parts: [KMLShapePart]
+
+    var vertexCount: Int {
+        parts.reduce(0) { $0 + $1.points.count }
+    }
+
+    // How many vertices drawing `rect` at this level walks
+    func visibleVertexCount(in rect: MKMapRect) -> Int {
+        return parts.reduce(0) { count, part in
+            count + part.visibleRanges(in: rect).reduce(0) { $0 + $1.count }
+        }
+    }
+}
+
+// A KML placemark's lines and polygons, prepared for drawing at any zoom.
+//
+// When the overlay is built each ring and line is simplified with
+// SFGeometryUtils.simplifyPoints (Douglas-Peucker, in web mercator meters)
+// once for each of SIMPLIFIED_ZOOM_LEVELS, each level starting from the
+// one before. A renderer then asks for the coarsest level that is still
+// accurate to PIXEL_TOLERANCE on screen, so a 50k vertex boundary drawn
+// at country scale walks a few hundred vertices, and only the runs of
+// vertices inside the tile being drawn.
+//
+// The bounding rect comes from the placemark's cached SFGeometryEnvelope.
+final class KMLOverlay: NSObject, MKOverlay {
+    // How far, in screen points, a simplified shape may stray
+    static let PIXEL_TOLERANCE = 0.5
+    // Web mercator zoom levels (world is 256 * 2^z points wide) with a
+    // simplified copy. Past the last one, full detail is drawn.
+    static let SIMPLIFIED_ZOOM_LEVELS = [15, 12, 9, 6, 3]
+    static let HALF_WORLD_METERS = 20037508.342789244
+
+    let placemark: KMLPlacemark
+    let isFilled: Bool
+    let boundingMapRect: MKMapRect
+    let coordinate: CLLocationCoordinate2D
+    // Finest first
+    let levels: [KMLShapeLevel]
+
+    static var metersPerMapPoint: Double {
+        2 * HALF_WORLD_METERS / MKMapSize.world.width
+    }
+
+    // Map points per screen point at a zoom level
+    static func mapPointsPerPoint(zoomLevel: Int) -> Double {
+        return MKMapSize.world.width / (256.0 * pow(2.0, Double(zoomLevel)))
+    }
+
+    // Lines and polygons only; points are left to annotations
+    static func canDisplay(_ placemark: KMLPlacemark) -> Bool {
+        return !parts(of: placemark.geometry).isEmpty
+    }
+
+    // Every line and polygon in the KML and KMZ files of imported data packages
+    static func overlays(from store: DataPackageContentStore) -> [KMLOverlay] {
+        var overlays: [KMLOverlay] = []
+        for index in store.indexes() {
+            for entry in index.entries where entry.type == .kml || entry.type == .kmz {
+                overlays.append(contentsOf: KMLParser.parse(url: store.url(for: entry, in: index))
+                    .filter { canDisplay($0) }
+                    .map { KMLOverlay(placemark: $0) })
+            }
+        }
+        return overlays
+    }
+
+    init(placemark: KMLPlacemark) {
+        self.placemark = placemark
+
+        let envelope = placemark.envelope
+        let topLeft = MKMapPoint(CLLocationCoordinate2D(latitude: envelope.maxY.doubleValue, longitude: envelope.minX.doubleValue))
+        let bottomRight = MKMapPoint(CLLocationCoordinate2D(latitude: envelope.minY.doubleValue, longitude: envelope.maxX.doubleValue))
+        boundingMapRect = MKMapRect(x: topLeft.x, y: topLeft.y, width: bottomRight.x - topLeft.x, height: bottomRight.y - topLeft.y)
+        coordinate = CLLocationCoordinate2D(
+            latitude: (envelope.minY.doubleValue + envelope.maxY.doubleValue) / 2,
+            longitude: (envelope.minX.doubleValue + envelope.maxX.doubleValue) / 2
+        )
+
+        let sourceParts = KMLOverlay.parts(of: placemark.geometry)
+        isFilled = sourceParts.contains { $0.isClosed }
+
+        var current = sourceParts.map { part in
+            (points: part.points.map { SFGeometryUtils.degreesToMeters(withX: $0.x.doubleValue, andY: $0.y.doubleValue)! }, isClosed: part.isClosed)
+        }
+        var levels = [KMLOverlay.level(tolerance: 0, parts: current)]
+        for zoomLevel in KMLOverlay.SIMPLIFIED_ZOOM_LEVELS {
+            let tolerance = KMLOverlay.PIXEL_TOLERANCE * KMLOverlay.mapPointsPerPoint(zoomLevel: zoomLevel)
+            current = current.compactMap { part -> (points: [SFPoint], isClosed: Bool)? in
+                let simplified: [SFPoint] = SFGeometryUtils.simplifyPoints(part.points, withTolerance: tolerance * KMLOverlay.metersPerMapPoint)
+                // Smaller than the tolerance at this zoom, so nothing to draw
+                if(simplified.count < (part.isClosed ? 4 : 2)) {
+                    return nil
+                }
+                return (simplified, part.isClosed)
+            }
+            levels.append(KMLOverlay.level(tolerance: tolerance, parts: current))
+        }
+        self.levels = levels
+        super.init()
+    }
+
+    // The coarsest level that still looks right at this zoom scale
+    // (screen points per map point)
+    func level(forZoomScale zoomScale: MKZoomScale) -> KMLShapeLevel {
+        let allowed = KMLOverlay.PIXEL_TOLERANCE / Double(zoomScale)
+        return levels.last(where: { $0.tolerance <= allowed }) ?? levels[0]
+    }
+
+    func intersects(_ mapRect: MKMapRect) -> Bool {
+        return boundingMapRect.intersects(mapRect)
+    }
+
+    private static func level(tolerance: Double, parts: [(points: [SFPoint], isClosed: Bool)]) -> KMLShapeLevel {
+        let metersPerMapPoint = KMLOverlay.metersPerMapPoint
+        return KMLShapeLevel(tolerance: tolerance, parts: parts.map { part -> KMLShapePart in
+            var points = ContiguousArray<MKMapPoint>()
+            points.reserveCapacity(part.points.count)
+            for point in part.points {
+                points.append(MKMapPoint(
+                    x: (point.x.doubleValue + HALF_WORLD_METERS) / metersPerMapPoint,
+                    y: (HALF_WORLD_METERS - point.y.doubleValue) / metersPerMapPoint
+                ))
+            }
+            return KMLShapePart(points: points, isClosed: part.isClosed)
+        })
+    }
+
+    // Every ring and line in the geometry, in degrees
+    static func parts(of geometry: SFGeometry) -> [(points: [SFPoint], isClosed: Bool)] {
+        if let polygon = geometry as? SFPolygon {
+            return polygon.rings.compactMap { ring -> (points: [SFPoint], isClosed: Bool)? in
+                guard let ring = ring as? SFLineString else { return nil }
+                return (ring.points.compactMap { $0 as? SFPoint }, true)
+            }
+        }
+        if let lineString = geometry as? SFLineString {
+            return [(lineString.points.compactMap { $0 as? SFPoint }, false)]
+        }
+        if let collection = geometry as? SFGeometryCollection {
+            return collection.geometries.flatMap { member -> [(points: [SFPoint], isClosed: Bool)] in
+                guard let member = member as? SFGeometry else { return [] }
+                return parts(of: member)
+            }
+        }
+        return []
+    }
+}
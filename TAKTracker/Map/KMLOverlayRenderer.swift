@@ -0,0 +1,57 @@
+//
+//  KMLOverlayRenderer.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import MapKit
+import UIKit
+
+// Draws a KMLOverlay tile by tile from the level of detail matching the
+// tile's zoom scale. Outlines only walk the runs of vertices that reach
+// into the tile. Fills walk the same runs plus one vertex for each run
+// elsewhere in the ring (see KMLShapePart.fillPoints).
+final class KMLOverlayRenderer: MKOverlayRenderer {
+    static let STROKE_WIDTH: CGFloat = 2.0
+
+    var strokeColor = UIColor.systemYellow
+    var fillColor = UIColor.systemYellow.withAlphaComponent(0.15)
+
+    override func draw(_ mapRect: MKMapRect, zoomScale: MKZoomScale, in context: CGContext) {
+        guard let kmlOverlay = overlay as? KMLOverlay else { return }
+        let level = kmlOverlay.level(forZoomScale: zoomScale)
+        let lineWidth = KMLOverlayRenderer.STROKE_WIDTH / zoomScale
+        // Take in strokes from just outside the tile that bleed into it
+        let drawRect = mapRect.insetBy(dx: -Double(lineWidth), dy: -Double(lineWidth))
+
+        if(kmlOverlay.isFilled) {
+            let fillPath = CGMutablePath()
+            for part in level.parts where part.isClosed && part.bounds.intersects(drawRect) {
+                fillPath.addLines(between: part.fillPoints(in: drawRect).map { point(for: $0) })
+                fillPath.closeSubpath()
+            }
+            if(!fillPath.isEmpty) {
+                context.addPath(fillPath)
+                context.setFillColor(fillColor.cgColor)
+                context.fillPath(using: .evenOdd)
+            }
+        }
+
+        let strokePath = CGMutablePath()
+        for part in level.parts {
+            for range in part.visibleRanges(in: drawRect) {
+                strokePath.addLines(between: part.points[range].map { point(for: $0) })
+            }
+        }
+        if(!strokePath.isEmpty) {
+            context.addPath(strokePath)
+            context.setStrokeColor(strokeColor.cgColor)
+            context.setLineWidth(lineWidth)
+            context.setLineJoin(.round)
+            context.setLineCap(.round)
+            context.strokePath()
+        }
+    }
+}
@@ -0,0 +1,154 @@
+//
+//  MapController.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import MapKit
+import UIKit
+
+// The settings MapView pushes into the map on each SwiftUI update
+struct MapViewState: Equatable {
+    var mapType: UInt
+    var isHidden: Bool
+}
+
+// Owns the app's single MKMapView for its whole lifetime.
+//
+// MapView is a SwiftUI struct that gets re-created on every body
+// evaluation, so it can't own the map itself. It hands this controller's
+// view to SwiftUI instead, and updateUIView only passes state through
+// apply(_:), which touches the map when something actually changed.
+final class MapController: NSObject, ObservableObject, MKMapViewDelegate, UIGestureRecognizerDelegate {
+    private(set) lazy var mapView: MKMapView = makeMapView()
+
+    private var state: MapViewState?
+    private var hasSetInitialRegion = false
+    private var contactAnnotations: ContactAnnotationController?
+    private var contactStore: ContactStore?
+    private var overlayStore: DataPackageContentStore?
+    private var overlayObserver: NSObjectProtocol?
+    private var kmlOverlays: [KMLOverlay] = []
+    private let overlayQueue = DispatchQueue(label: "com.flighttactics.TAKTracker.MapController.overlays", qos: .utility)
+    private lazy var tapRecognizer: UITapGestureRecognizer = {
+        let recognizer = UITapGestureRecognizer(target: self, action: #selector(tapHandler))
+        recognizer.delegate = self
+        return recognizer
+    }()
+
+    var currentState: MapViewState? {
+        state
+    }
+
+    func apply(_ newState: MapViewState) {
+        if(newState == state) {
+            return
+        }
+        if(newState.mapType != state?.mapType) {
+            mapView.mapType = MKMapType(rawValue: newState.mapType) ?? .standard
+        }
+        if(newState.isHidden != state?.isHidden) {
+            mapView.isHidden = newState.isHidden
+        }
+        state = newState
+    }
+
+    func setInitialRegion(_ region: MKCoordinateRegion) {
+        if(hasSetInitialRegion) {
+            return
+        }
+        hasSetInitialRegion = true
+        mapView.setRegion(region, animated: true)
+        mapView.setCenter(region.center, animated: true)
+    }
+
+    func showContacts(from store: ContactStore) {
+        if(contactStore === store) {
+            return
+        }
+        contactStore = store
+        let annotations = ContactAnnotationController(store: store)
+        annotations.attach(to: mapView)
+        contactAnnotations = annotations
+    }
+
+    // Shows the KML shapes from imported data packages, and again
+    // whenever another package is imported
+    func showOverlays(from store: DataPackageContentStore) {
+        if(overlayStore === store) {
+            return
+        }
+        overlayStore = store
+        if let observer = overlayObserver {
+            NotificationCenter.default.removeObserver(observer)
+        }
+        overlayObserver = NotificationCenter.default.addObserver(
+            forName: DataPackageContentStore.DID_CHANGE_NOTIFICATION,
+            object: store,
+            queue: .main
+        ) { [weak self] _ in
+            self?.reloadOverlays()
+        }
+        reloadOverlays()
+    }
+
+    private func reloadOverlays() {
+        guard let store = overlayStore else { return }
+        // Parsing and simplifying stays off the main thread
+        overlayQueue.async { [weak self] in
+            let overlays = KMLOverlay.overlays(from: store)
+            DispatchQueue.main.async {
+                guard let self = self, self.overlayStore === store else { return }
+                self.mapView.removeOverlays(self.kmlOverlays)
+                self.kmlOverlays = overlays
+                self.mapView.addOverlays(overlays, level: .aboveRoads)
+                TAKLogger.debug("[MapController]: Showing \(overlays.count) KML overlay(s)")
+            }
+        }
+    }
+
+    func resetMap() {
+        mapView.showsCompass = true
+        mapView.userTrackingMode = .followWithHeading
+    }
+
+    private func makeMapView() -> MKMapView {
+        let mapView = MKMapView()
+        mapView.delegate = self
+        mapView.showsUserLocation = true
+        mapView.showsCompass = true
+        mapView.userTrackingMode = .followWithHeading
+        mapView.pointOfInterestFilter = .excludingAll
+        mapView.layer.borderColor = UIColor.black.cgColor
+        mapView.layer.borderWidth = 1.0
+        mapView.isHidden = false
+        mapView.addGestureRecognizer(tapRecognizer)
+        return mapView
+    }
+
+    @objc func tapHandler(_ gesture: UITapGestureRecognizer) {
+        // position on the screen, CGPoint
+        let location = tapRecognizer.location(in: mapView)
+        // position on the map, CLLocationCoordinate2D
+        let coordinate = mapView.convert(location, toCoordinateFrom: mapView)
+        TAKLogger.debug("Map Tapped! \(String(describing: coordinate))")
+        resetMap()
+    }
+
+    func mapView(_ mapView: MKMapView, viewFor annotation: MKAnnotation) -> MKAnnotationView? {
+        return contactAnnotations?.annotationView(for: mapView, annotation: annotation)
+    }
+
+    func mapView(_ mapView: MKMapView, rendererFor overlay: MKOverlay) -> MKOverlayRenderer {
+        if let kmlOverlay = overlay as? KMLOverlay {
+            return KMLOverlayRenderer(overlay: kmlOverlay)
+        }
+        return MKOverlayRenderer(overlay: overlay)
+    }
+
+    func mapView(_ mapView: MKMapView, regionDidChangeAnimated animated: Bool) {
+        contactAnnotations?.setNeedsRefresh(region: mapView.region, mapWidth: Double(mapView.bounds.width))
+    }
+}
@@ -0,0 +1,40 @@
+//
+//  MapView.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import MapKit
+import SwiftUI
+
+struct MapView: UIViewRepresentable {
+    // Maps shorter than this don't leave room for anything useful
+    static let MINIMUM_VISIBLE_HEIGHT = 150.0
+
+    @Binding var region: MKCoordinateRegion
+    @Binding var mapType: UInt
+    let contactStore: ContactStore
+    let controller: MapController
+
+    // The controller outlives this struct, so it's the coordinator
+    func makeCoordinator() -> MapController {
+        return controller
+    }
+
+    func makeUIView(context: Context) -> MKMapView {
+        let controller = context.coordinator
+        controller.setInitialRegion(region)
+        controller.showContacts(from: contactStore)
+        controller.showOverlays(from: DataPackageContentStore.global)
+        controller.apply(MapViewState(mapType: mapType, isHidden: false))
+        return controller.mapView
+    }
+
+    func updateUIView(_ view: MKMapView, context: Context) {
+        context.coordinator.apply(MapViewState(
+            mapType: mapType,
+            isHidden: Double(view.frame.height) < MapView.MINIMUM_VISIBLE_HEIGHT
+        ))
+    }
+}
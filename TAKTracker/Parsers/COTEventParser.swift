@@ -0,0 +1,131 @@
+//
+//  COTEventParser.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+// Splits a TCP byte stream from the TAK server into whole CoT events.
+// The server sends events back to back with no length prefix, so each
+// one ends at its closing </event> tag.
+struct COTStreamFramer {
+    static let EVENT_END = Data("</event>".utf8)
+    // Drop anything that grows this large without closing an event
+    static let MAX_BUFFERED_BYTES = 1_048_576
+
+    private var buffer = Data()
+
+    mutating func append(_ data: Data) -> [Data] {
+        buffer.append(data)
+        var events: [Data] = []
+        var searchStart = buffer.startIndex
+
+        while let end = buffer.range(of: COTStreamFramer.EVENT_END, in: searchStart..<buffer.endIndex) {
+            events.append(buffer.subdata(in: searchStart..<end.upperBound))
+            searchStart = end.upperBound
+        }
+
+        buffer.removeSubrange(buffer.startIndex..<searchStart)
+        if(buffer.count > COTStreamFramer.MAX_BUFFERED_BYTES) {
+            TAKLogger.error("[COTStreamFramer]: Discarding \(buffer.count) bytes without an event end")
+            buffer.removeAll()
+        }
+        return events
+    }
+}
+
+// Reads the parts of a CoT event needed to track another user:
+// <event uid type time stale> with its <point>, and the callsign,
+// group and track from <detail>.
+class COTEventParser: NSObject, XMLParserDelegate {
+    var uid: String?
+    var type: String?
+    var time: Date?
+    var stale: Date?
+    var latitude: Double?
+    var longitude: Double?
+    var heightAboveEllipsoid: Double = 0
+    var callsign = ""
+    var group = ""
+    var role = ""
+    var speed: Double = -1
+    var course: Double = -1
+
+    private static let dateFormatter = ISO8601DateFormatter()
+    private static let fractionalDateFormatter: ISO8601DateFormatter = {
+        let formatter = ISO8601DateFormatter()
+        formatter.formatOptions = [.withInternetDateTime, .withFractionalSeconds]
+        return formatter
+    }()
+
+    // Only atoms (a-*) are other users' positions
+    static func parseContact(data: Data) -> ContactRecord? {
+        let xmlParser = XMLParser(data: data)
+        let eventParser = COTEventParser()
+        xmlParser.delegate = eventParser
+        if(!xmlParser.parse()) {
+            TAKLogger.debug("[COTEventParser]: Unable to parse event: \(String(describing: xmlParser.parserError))")
+            return nil
+        }
+        return eventParser.contact
+    }
+
+    static func date(from value: String?) -> Date? {
+        guard let value = value else { return nil }
+        return fractionalDateFormatter.date(from: value) ?? dateFormatter.date(from: value)
+    }
+
+    var contact: ContactRecord? {
+        guard let uid = uid, let type = type, type.hasPrefix("a-"),
+              let time = time, let stale = stale,
+              let latitude = latitude, let longitude = longitude else {
+            return nil
+        }
+        return ContactRecord(
+            uid: uid,
+            type: type,
+            callsign: callsign.isEmpty ? uid : callsign,
+            group: group,
+            role: role,
+            latitude: latitude,
+            longitude: longitude,
+            heightAboveEllipsoid: heightAboveEllipsoid,
+            speed: speed,
+            course: course,
+            time: time,
+            stale: stale
+        )
+    }
+
+    func parser(
+        _ parser: XMLParser,
+        didStartElement elementName: String,
+        namespaceURI: String?,
+        qualifiedName qName: String?,
+        attributes attributeDict: [String : String] = [:]
+    ) {
+        switch elementName {
+        case "event":
+            uid = attributeDict["uid"]
+            type = attributeDict["type"]
+            time = COTEventParser.date(from: attributeDict["time"])
+            stale = COTEventParser.date(from: attributeDict["stale"])
+        case "point":
+            latitude = attributeDict["lat"].flatMap { Double($0) }
+            longitude = attributeDict["lon"].flatMap { Double($0) }
+            heightAboveEllipsoid = attributeDict["hae"].flatMap { Double($0) } ?? 0
+        case "contact":
+            callsign = attributeDict["callsign"] ?? callsign
+        case "__group":
+            group = attributeDict["name"] ?? group
+            role = attributeDict["role"] ?? role
+        case "track":
+            speed = attributeDict["speed"].flatMap { Double($0) } ?? -1
+            course = attributeDict["course"].flatMap { Double($0) } ?? -1
+        default:
+            return
+        }
+    }
+}
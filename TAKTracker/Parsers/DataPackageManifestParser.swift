@@ -0,0 +1,102 @@
+//
+//  DataPackageManifestParser.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+struct DataPackageManifestContent: Equatable {
+    var zipEntry: String
+    var ignore: Bool
+    var parameters: [String:String]
+}
+
+// Reads a data package MANIFEST/manifest.xml:
+//
+// <MissionPackageManifest version="2">
+//   <Configuration><Parameter name="uid" value="..."/></Configuration>
+//   <Contents>
+//     <Content ignore="false" zipEntry="overlays\boundary.kml">
+//       <Parameter name="contentType" value="KML"/>
+//     </Content>
+//   </Contents>
+// </MissionPackageManifest>
+class DataPackageManifestParser: NSObject, XMLParserDelegate {
+    static let UID_PARAMETER = "uid"
+    static let NAME_PARAMETER = "name"
+    static let CONTENT_TYPE_PARAMETER = "contentType"
+
+    var configuration: [String:String] = [:]
+    var contents: [DataPackageManifestContent] = []
+
+    private var isInConfiguration = false
+    private var currentContent: DataPackageManifestContent?
+
+    var uid: String? {
+        configuration[DataPackageManifestParser.UID_PARAMETER]
+    }
+
+    var name: String? {
+        configuration[DataPackageManifestParser.NAME_PARAMETER]
+    }
+
+    static func parse(data: Data) -> DataPackageManifestParser? {
+        let xmlParser = XMLParser(data: data)
+        let manifestParser = DataPackageManifestParser()
+        xmlParser.delegate = manifestParser
+        if(!xmlParser.parse()) {
+            TAKLogger.error("[DataPackageManifestParser]: Unable to parse manifest: \(String(describing: xmlParser.parserError))")
+            return nil
+        }
+        return manifestParser
+    }
+
+    func parser(
+        _ parser: XMLParser,
+        didStartElement elementName: String,
+        namespaceURI: String?,
+        qualifiedName qName: String?,
+        attributes attributeDict: [String : String] = [:]
+    ) {
+        switch elementName {
+        case "Configuration":
+            isInConfiguration = true
+        case "Content":
+            currentContent = DataPackageManifestContent(
+                zipEntry: attributeDict["zipEntry"] ?? "",
+                ignore: attributeDict["ignore"]?.lowercased() == "true",
+                parameters: [:]
+            )
+        case "Parameter":
+            guard let name = attributeDict["name"], let value = attributeDict["value"] else { return }
+            if(currentContent != nil) {
+                currentContent?.parameters[name] = value
+            } else if(isInConfiguration) {
+                configuration[name] = value
+            }
+        default:
+            return
+        }
+    }
+
+    func parser(
+        _ parser: XMLParser,
+        didEndElement elementName: String,
+        namespaceURI: String?,
+        qualifiedName qName: String?
+    ) {
+        switch elementName {
+        case "Configuration":
+            isInConfiguration = false
+        case "Content":
+            if let content = currentContent, !content.zipEntry.isEmpty {
+                contents.append(content)
+            }
+            currentContent = nil
+        default:
+            return
+        }
+    }
+}
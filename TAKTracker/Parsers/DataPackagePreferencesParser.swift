@@ -0,0 +1,67 @@
+//
+//  DataPackagePreferencesParser.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+// Reads the <entry key="..."> values out of a data package .pref file:
+//
+// <preference name="cot_streams">
+//   <entry key="connectString0">host:8089:ssl</entry>
+// </preference>
+// <preference name="com.atakmap.app_preferences">
+//   <entry key="certificateLocation">cert/user.p12</entry>
+// </preference>
+class DataPackagePreferencesParser: NSObject, XMLParserDelegate {
+    var entries: [String:String] = [:]
+
+    private var currentKey: String?
+    private var currentValue = ""
+
+    static func parse(data: Data) -> [String:String] {
+        let xmlParser = XMLParser(data: data)
+        let prefsParser = DataPackagePreferencesParser()
+        xmlParser.delegate = prefsParser
+        if(!xmlParser.parse()) {
+            TAKLogger.error("[DataPackagePreferencesParser]: Unable to parse preferences: \(String(describing: xmlParser.parserError))")
+        }
+        return prefsParser.entries
+    }
+
+    func parser(
+        _ parser: XMLParser,
+        didStartElement elementName: String,
+        namespaceURI: String?,
+        qualifiedName qName: String?,
+        attributes attributeDict: [String : String] = [:]
+    ) {
+        if(elementName == "entry") {
+            currentKey = attributeDict["key"]
+            currentValue = ""
+        }
+    }
+
+    func parser(_ parser: XMLParser, foundCharacters string: String) {
+        if(currentKey != nil) {
+            currentValue.append(string)
+        }
+    }
+
+    func parser(
+        _ parser: XMLParser,
+        didEndElement elementName: String,
+        namespaceURI: String?,
+        qualifiedName qName: String?
+    ) {
+        if(elementName == "entry"), let key = currentKey {
+            // Only ever take the first value for a key
+            if(!entries.keys.contains(key)) {
+                entries[key] = currentValue.trimmingCharacters(in: .whitespacesAndNewlines)
+            }
+            currentKey = nil
+        }
+    }
+}
@@ -0,0 +1,229 @@
+//
+//  DataPackageReader.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Crypto
+import Foundation
+import SwiftTAK
+import ZIPFoundation
+
+enum DataPackageError: Error {
+    case unreadableArchive(URL)
+    case entryTooLarge(String)
+    case cannotWriteEntry(String)
+}
+
+// Pulls the server connection and certificates out of a data package zip
+// without unpacking it.
+//
+// The archive's central directory is read first, then only the .pref files
+// and the two .p12 bundles they point at are inflated, a chunk at a time.
+// Every other entry (maps, imagery, attachments) is never decompressed, so
+// reading a large mission package costs about the same as a small one.
+//
+// A mission package with only overlays or imagery has no .pref, and reads
+// as contents with no connection or certificates.
+//
+// storeContents handles those other entries, streaming the ones
+// manifest.xml lists straight to disk through a fixed-size buffer.
+class DataPackageReader {
+    static let READ_CHUNK_SIZE = 64 * 1024
+    // Preferences and PKCS#12 bundles are a few KB. Anything this big isn't one.
+    static let MAX_CONFIG_ENTRY_BYTES: UInt64 = 1024 * 1024
+    static let MANIFEST_FILE_NAME = "manifest.xml"
+    static let CONFIG_EXTENSIONS = ["pref", "p12"]
+
+    static let CONNECT_STRING_KEY = "connectString0"
+    static let CERTIFICATE_LOCATION_KEY = "certificateLocation"
+    static let CLIENT_PASSWORD_KEY = "clientPassword"
+    static let CA_LOCATION_KEY = "caLocation"
+    static let CA_PASSWORD_KEY = "caPassword"
+
+    let archiveLocation: URL
+
+    init(fileLocation: URL) {
+        archiveLocation = fileLocation
+    }
+
+    // Reports the fraction of the needed bytes inflated so far
+    func read(progress: (Double) -> Void = { _ in }) throws -> DataPackageContents {
+        let archive = try openArchive()
+        let files = archive.filter { $0.type == .file }
+        let preferenceEntries = files.filter { $0.path.lowercased().hasSuffix(".pref") }
+        guard !preferenceEntries.isEmpty else {
+            TAKLogger.debug("[DataPackageReader]: No preferences in the package, so no connection to read")
+            progress(1.0)
+            return DataPackageContents()
+        }
+
+        let neededBytes = files
+            .filter { $0.path.lowercased().hasSuffix(".pref") || $0.path.lowercased().hasSuffix(".p12") }
+            .reduce(UInt64(0)) { $0 + $1.uncompressedSize }
+        var readBytes: UInt64 = 0
+        func onChunk(_ count: Int) {
+            readBytes += UInt64(count)
+            progress(neededBytes == 0 ? 1.0 : min(1.0, Double(readBytes) / Double(neededBytes)))
+        }
+
+        var preferences: [String:String] = [:]
+        for entry in preferenceEntries {
+            let entryPreferences = DataPackagePreferencesParser.parse(data: try extract(entry, from: archive, onChunk: onChunk))
+            preferences.merge(entryPreferences) { first, _ in first }
+        }
+
+        var contents = DataPackageContents()
+        if let connectString = preferences[DataPackageReader.CONNECT_STRING_KEY] {
+            let parts = connectString.components(separatedBy: ":")
+            if(parts.count >= 3) {
+                contents.serverURL = parts.dropLast(2).joined(separator: ":")
+                contents.serverPort = parts[parts.count - 2]
+                contents.serverProtocol = parts[parts.count - 1]
+            } else {
+                TAKLogger.error("[DataPackageReader]: Unrecognized connect string \(connectString)")
+            }
+        }
+
+        if let location = preferences[DataPackageReader.CERTIFICATE_LOCATION_KEY],
+           let entry = DataPackageReader.entry(named: location, in: files) {
+            contents.userCertificate = try extract(entry, from: archive, onChunk: onChunk)
+            contents.userCertificatePassword = preferences[DataPackageReader.CLIENT_PASSWORD_KEY] ?? ""
+        }
+
+        if let location = preferences[DataPackageReader.CA_LOCATION_KEY],
+           let entry = DataPackageReader.entry(named: location, in: files) {
+            var serverCertificate = TAKServerCertificatePackage()
+            serverCertificate.certificateData = try extract(entry, from: archive, onChunk: onChunk)
+            serverCertificate.certificatePassword = preferences[DataPackageReader.CA_PASSWORD_KEY] ?? ""
+            contents.serverCertificates = [serverCertificate]
+        }
+
+        progress(1.0)
+        return contents
+    }
+
+    // Streams the package's content (everything but the connection config,
+    // which only ever goes to the keychain and settings) into the store and
+    // returns its index. Memory use is one READ_CHUNK_SIZE buffer however
+    // large the entries are. Reports the fraction of bytes written so far.
+    func storeContents(in store: DataPackageContentStore, progress: (Double) -> Void = { _ in }) throws -> DataPackageContentIndex {
+        let archive = try openArchive()
+        let files = archive.filter { $0.type == .file }
+
+        var manifest: DataPackageManifestParser?
+        if let manifestEntry = files.first(where: { DataPackageReader.fileName($0.path).lowercased() == DataPackageReader.MANIFEST_FILE_NAME }) {
+            manifest = DataPackageManifestParser.parse(data: try extract(manifestEntry, from: archive, onChunk: { _ in }))
+        }
+        let selected = DataPackageReader.contentEntries(in: files, manifest: manifest)
+        let uid = manifest?.uid ?? archiveLocation.deletingPathExtension().lastPathComponent
+
+        let staging = store.stagingDirectory(uid: uid)
+        try? FileManager.default.removeItem(at: staging)
+        try FileManager.default.createDirectory(at: staging, withIntermediateDirectories: true)
+
+        let totalBytes = selected.reduce(UInt64(0)) { $0 + $1.entry.uncompressedSize }
+        var writtenBytes: UInt64 = 0
+        var storedPaths = Set<String>()
+        var index = DataPackageContentIndex(uid: uid, name: manifest?.name ?? uid, importedAt: Date.now, entries: [])
+
+        do {
+            for (entry, manifestType) in selected {
+                let storedPath = DataPackageContentStore.storedPath(forEntryPath: entry.path)
+                if(!storedPaths.insert(storedPath.lowercased()).inserted) {
+                    TAKLogger.info("[DataPackageReader]: Skipping duplicate entry \(entry.path)")
+                    continue
+                }
+                let fileURL = staging.appendingPathComponent(storedPath)
+                try FileManager.default.createDirectory(at: fileURL.deletingLastPathComponent(), withIntermediateDirectories: true)
+                guard FileManager.default.createFile(atPath: fileURL.path, contents: nil) else {
+                    throw DataPackageError.cannotWriteEntry(entry.path)
+                }
+
+                let handle = try FileHandle(forWritingTo: fileURL)
+                defer { try? handle.close() }
+                var hasher = SHA256()
+                var size: UInt64 = 0
+                _ = try archive.extract(entry, bufferSize: DataPackageReader.READ_CHUNK_SIZE) { chunk in
+                    hasher.update(data: chunk)
+                    try handle.write(contentsOf: chunk)
+                    size += UInt64(chunk.count)
+                    writtenBytes += UInt64(chunk.count)
+                    progress(totalBytes == 0 ? 1.0 : min(1.0, Double(writtenBytes) / Double(totalBytes)))
+                }
+
+                index.entries.append(DataPackageContentEntry(
+                    path: entry.path,
+                    storedPath: storedPath,
+                    type: DataPackageContentType.of(path: entry.path, manifestType: manifestType),
+                    size: size,
+                    sha256: hasher.finalize().map { String(format: "%02x", $0) }.joined()
+                ))
+            }
+            try store.commit(index)
+        } catch {
+            try? FileManager.default.removeItem(at: staging)
+            throw error
+        }
+
+        progress(1.0)
+        return index
+    }
+
+    // The entries manifest.xml lists and doesn't ignore, or every entry when
+    // there's no manifest to go by. Config, certificates and the manifest
+    // itself are never included.
+    static func contentEntries(in files: [Entry], manifest: DataPackageManifestParser?) -> [(entry: Entry, manifestType: String?)] {
+        let content = files.filter { entry in
+            let name = fileName(entry.path).lowercased()
+            return name != MANIFEST_FILE_NAME && !CONFIG_EXTENSIONS.contains((name as NSString).pathExtension)
+        }
+        guard let manifest = manifest, !manifest.contents.isEmpty else {
+            return content.map { (entry: $0, manifestType: nil) }
+        }
+
+        var selected: [(entry: Entry, manifestType: String?)] = []
+        for listed in manifest.contents where !listed.ignore {
+            let listedPath = DataPackageContentStore.storedPath(forEntryPath: listed.zipEntry)
+            let match = content.first { DataPackageContentStore.storedPath(forEntryPath: $0.path).caseInsensitiveCompare(listedPath) == .orderedSame }
+                ?? entry(named: listed.zipEntry, in: content)
+            if let match = match {
+                selected.append((match, listed.parameters[DataPackageManifestParser.CONTENT_TYPE_PARAMETER]))
+            }
+        }
+        return selected
+    }
+
+    // Preferences name certificates by where ATAK unpacks them ("cert/user.p12"),
+    // which rarely matches the zip layout, so match on the file name alone
+    static func entry(named location: String, in entries: [Entry]) -> Entry? {
+        let name = fileName(location)
+        return entries.first { fileName($0.path).caseInsensitiveCompare(name) == .orderedSame }
+    }
+
+    static func fileName(_ path: String) -> String {
+        return path.replacingOccurrences(of: "\\", with: "/").components(separatedBy: "/").last ?? path
+    }
+
+    private func openArchive() throws -> Archive {
+        do {
+            return try Archive(url: archiveLocation, accessMode: .read)
+        } catch {
+            TAKLogger.error("[DataPackageReader]: Unable to open archive: \(error)")
+            throw DataPackageError.unreadableArchive(archiveLocation)
+        }
+    }
+
+    private func extract(_ entry: Entry, from archive: Archive, onChunk: (Int) -> Void) throws -> Data {
+        guard entry.uncompressedSize <= DataPackageReader.MAX_CONFIG_ENTRY_BYTES else {
+            throw DataPackageError.entryTooLarge(entry.path)
+        }
+        var data = Data(capacity: Int(entry.uncompressedSize))
+        _ = try archive.extract(entry, bufferSize: DataPackageReader.READ_CHUNK_SIZE) { chunk in
+            data.append(chunk)
+            onChunk(chunk.count)
+        }
+        return data
+    }
+}
@@ -0,0 +1,108 @@
+//
+//  GPXTrackParser.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import CoreLocation
+import Foundation
+
+// Reads track, route and waypoint points out of a GPX file, in file order.
+// Points without a timestamp are skipped since they can't be replayed.
+class GPXTrackParser: NSObject, XMLParserDelegate {
+    static let POINT_ELEMENTS: Set<String> = ["trkpt", "rtept", "wpt"]
+
+    var locations: [CLLocation] = []
+
+    private var pointLatitude: Double?
+    private var pointLongitude: Double?
+    private var pointElevation: Double = 0
+    private var pointTime: Date?
+    private var pointSpeed: Double = -1
+    private var pointCourse: Double = -1
+    private var characters = ""
+
+    private let dateFormatter = ISO8601DateFormatter()
+    private let fractionalDateFormatter: ISO8601DateFormatter = {
+        let formatter = ISO8601DateFormatter()
+        formatter.formatOptions = [.withInternetDateTime, .withFractionalSeconds]
+        return formatter
+    }()
+
+    static func parse(data: Data) -> [CLLocation] {
+        let xmlParser = XMLParser(data: data)
+        let trackParser = GPXTrackParser()
+        xmlParser.delegate = trackParser
+        if(!xmlParser.parse()) {
+            TAKLogger.error("[GPXTrackParser]: Unable to parse GPX: \(String(describing: xmlParser.parserError))")
+        }
+        return trackParser.locations
+    }
+
+    func parser(
+        _ parser: XMLParser,
+        didStartElement elementName: String,
+        namespaceURI: String?,
+        qualifiedName qName: String?,
+        attributes attributeDict: [String : String] = [:]
+    ) {
+        characters = ""
+        if(GPXTrackParser.POINT_ELEMENTS.contains(elementName)) {
+            pointLatitude = attributeDict["lat"].flatMap { Double($0) }
+            pointLongitude = attributeDict["lon"].flatMap { Double($0) }
+            pointElevation = 0
+            pointTime = nil
+            pointSpeed = -1
+            pointCourse = -1
+        }
+    }
+
+    func parser(_ parser: XMLParser, foundCharacters string: String) {
+        characters += string
+    }
+
+    func parser(
+        _ parser: XMLParser,
+        didEndElement elementName: String,
+        namespaceURI: String?,
+        qualifiedName qName: String?
+    ) {
+        let value = characters.trimmingCharacters(in: .whitespacesAndNewlines)
+        // Extension elements come through namespaced, e.g. gpxtpx:speed
+        let localName = elementName.split(separator: ":").last.map(String.init) ?? elementName
+
+        switch localName {
+        case "ele":
+            pointElevation = Double(value) ?? 0
+        case "time":
+            pointTime = fractionalDateFormatter.date(from: value) ?? dateFormatter.date(from: value)
+        case "speed":
+            pointSpeed = Double(value) ?? -1
+        case "course":
+            pointCourse = Double(value) ?? -1
+        default:
+            if(GPXTrackParser.POINT_ELEMENTS.contains(localName)) {
+                appendPoint()
+            }
+        }
+        characters = ""
+    }
+
+    private func appendPoint() {
+        guard let latitude = pointLatitude,
+              let longitude = pointLongitude,
+              let time = pointTime else {
+            return
+        }
+        locations.append(CLLocation(
+            coordinate: CLLocationCoordinate2D(latitude: latitude, longitude: longitude),
+            altitude: pointElevation,
+            horizontalAccuracy: 5,
+            verticalAccuracy: 5,
+            course: pointCourse,
+            speed: pointSpeed,
+            timestamp: time
+        ))
+    }
+}
@@ -0,0 +1,143 @@
+//
+//  GeoChatParser.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+// Reads a GeoChat (b-t-f) CoT event:
+// <event uid type time stale> with <__chat messageId senderCallsign>,
+// the sender from <chatgrp uid0> or <link uid>, and the text in <remarks>.
+//
+// Also reads delivered (b-t-f-d) and read (b-t-f-r) receipts, which name
+// the message in <__chatreceipt messageId> or <__chat messageId>, falling
+// back to the event uid.
+class GeoChatParser: NSObject, XMLParserDelegate {
+    static let CHAT_TYPE = "b-t-f"
+    static let DELIVERED_RECEIPT_TYPE = "b-t-f-d"
+    static let READ_RECEIPT_TYPE = "b-t-f-r"
+
+    var eventUID: String?
+    var type: String?
+    var time: Date?
+    var messageID: String?
+    var senderCallsign = ""
+    var senderUID: String?
+    var linkUID: String?
+    var remarks = ""
+
+    private var isInRemarks = false
+
+    // Cheap check on the raw bytes so contact reports aren't parsed twice.
+    // Receipts (b-t-f-d, b-t-f-r) don't match.
+    static func isChat(_ data: Data) -> Bool {
+        return hasType(CHAT_TYPE, data)
+    }
+
+    static func isReceipt(_ data: Data) -> Bool {
+        return hasType(DELIVERED_RECEIPT_TYPE, data) || hasType(READ_RECEIPT_TYPE, data)
+    }
+
+    private static func hasType(_ type: String, _ data: Data) -> Bool {
+        return data.range(of: Data("type=\"\(type)\"".utf8)) != nil
+            || data.range(of: Data("type='\(type)'".utf8)) != nil
+    }
+
+    static func parseReceipt(data: Data) -> ChatDeliveryUpdate? {
+        let xmlParser = XMLParser(data: data)
+        let chatParser = GeoChatParser()
+        xmlParser.delegate = chatParser
+        if(!xmlParser.parse()) {
+            TAKLogger.debug("[GeoChatParser]: Unable to parse receipt: \(String(describing: xmlParser.parserError))")
+            return nil
+        }
+        return chatParser.receipt
+    }
+
+    var receipt: ChatDeliveryUpdate? {
+        let status: ChatDeliveryStatus
+        switch type ?? "" {
+        case GeoChatParser.DELIVERED_RECEIPT_TYPE: status = .delivered
+        case GeoChatParser.READ_RECEIPT_TYPE: status = .read
+        default: return nil
+        }
+        guard let id = messageID ?? eventUID else { return nil }
+        return ChatDeliveryUpdate(id: id, status: status)
+    }
+
+    static func parseMessage(data: Data, receivedAt: Date = Date.now) -> MessageData? {
+        let xmlParser = XMLParser(data: data)
+        let chatParser = GeoChatParser()
+        xmlParser.delegate = chatParser
+        if(!xmlParser.parse()) {
+            TAKLogger.debug("[GeoChatParser]: Unable to parse chat: \(String(describing: xmlParser.parserError))")
+            return nil
+        }
+        return chatParser.message(receivedAt: receivedAt)
+    }
+
+    func message(receivedAt: Date) -> MessageData? {
+        guard type == GeoChatParser.CHAT_TYPE,
+              let id = messageID ?? eventUID,
+              let sender = senderUID ?? linkUID else {
+            return nil
+        }
+        let sent = time ?? receivedAt
+        return MessageData(
+            id: id,
+            userUId: sender,
+            callSign: senderCallsign.isEmpty ? sender : senderCallsign,
+            message: remarks,
+            createAt: sent,
+            expiresAt: sent.addingTimeInterval(ChatStore.RETENTION_SECONDS),
+            dateSent: sent,
+            dateReceived: receivedAt
+        )
+    }
+
+    func parser(
+        _ parser: XMLParser,
+        didStartElement elementName: String,
+        namespaceURI: String?,
+        qualifiedName qName: String?,
+        attributes attributeDict: [String : String] = [:]
+    ) {
+        switch elementName {
+        case "event":
+            eventUID = attributeDict["uid"]
+            type = attributeDict["type"]
+            time = COTEventParser.date(from: attributeDict["time"])
+        case "__chat", "__chatreceipt":
+            messageID = attributeDict["messageId"] ?? messageID
+            senderCallsign = attributeDict["senderCallsign"] ?? senderCallsign
+        case "chatgrp":
+            senderUID = attributeDict["uid0"] ?? senderUID
+        case "link":
+            linkUID = attributeDict["uid"] ?? linkUID
+        case "remarks":
+            isInRemarks = true
+            remarks = ""
+        default:
+            return
+        }
+    }
+
+    func parser(_ parser: XMLParser, foundCharacters string: String) {
+        if(isInRemarks) {
+            remarks.append(string)
+        }
+    }
+
+    func parser(
+        _ parser: XMLParser,
+        didEndElement elementName: String,
+        namespaceURI: String?,
+        qualifiedName qName: String?
+    ) {
+        if(elementName == "remarks") {
+            isInRemarks = false
+        }
+    }
+}
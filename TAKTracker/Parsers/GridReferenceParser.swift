@@ -0,0 +1,330 @@
+//
+//  GridReferenceParser.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+enum GridReferenceParseError: Error, Equatable {
+    case empty
+    case invalidZone
+    case invalidBand
+    case invalidSquare
+    // MGRS easting/northing must be an even number of digits, at most 10
+    case invalidDigits
+    case invalidHemisphere
+    case invalidNumber
+    case unexpectedCharacter(offset: Int)
+}
+
+// An MGRS reference as written, down to the grid zone at least
+struct MGRSReference: Equatable {
+    var zone: Int
+    var band: UInt8
+    // Both set, or both nil for a bare grid zone like "18S"
+    var column: UInt8?
+    var row: UInt8?
+    // Meters into the 100km square, so "18SUJ2305" gives 23000, 5000
+    var easting: Int
+    var northing: Int
+    // Digits per coordinate, 0 to 5
+    var precision: Int
+}
+
+// Parses MGRS ("18S UJ 26938 05973") and UTM ("18N 326938 4305973")
+// references.
+//
+// MGRS.parse and UTM.parse match an NSRegularExpression through an
+// NSString, and preconditionFailure on anything that doesn't match, which
+// takes the app down on a mistyped or malformed reference. This reads the
+// UTF-8 bytes once, left to right, and throws a GridReferenceParseError
+// instead. What's accepted follows the mgrs-ios patterns, with a few
+// deliberate differences:
+// - zones outside 1-60, and the Svalbard zones that don't exist (32X, 34X,
+//   36X), are errors rather than crashes later on
+// - only ASCII whitespace is skipped
+// - UTM may have whitespace around it, and needs some between the easting
+//   and northing, where the regex would split a run of digits anywhere
+//
+// MGRSReference keeps the reference as written; a bare grid zone or a
+// square without digits isn't moved onto the zone's bounds as MGRS.parse
+// does.
+enum GridReferenceParser {
+    static let MAX_MGRS_DIGITS = 10
+    static let MAX_ZONE = 60
+    // Beyond this many significant digits, UTM numbers go through Double(String)
+    static let MAX_FAST_DIGITS = 15
+
+    private static let POWERS_OF_TEN: [Double] = (0...22).map { pow(10.0, Double($0)) }
+    private static let INTEGER_POWERS_OF_TEN: [Int] = [1, 10, 100, 1_000, 10_000, 100_000]
+
+    // MARK: MGRS
+
+    static func parseMGRS(_ text: String) throws -> MGRSReference {
+        var text = text
+        return try text.withUTF8 { try parseMGRS(bytes: $0) }
+    }
+
+    static func mgrs(_ text: String) -> MGRSReference? {
+        return try? parseMGRS(text)
+    }
+
+    static func parseMGRS(_ texts: [String]) -> [Result<MGRSReference, GridReferenceParseError>] {
+        return texts.map { text in
+            var text = text
+            return text.withUTF8 { bytes in
+                Result { try parseMGRS(bytes: bytes) }.mapError { $0 as! GridReferenceParseError }
+            }
+        }
+    }
+
+    // Whitespace anywhere is ignored, as MGRS.parse strips it first
+    static func parseMGRS(bytes: UnsafeBufferPointer<UInt8>) throws -> MGRSReference {
+        var index = 0
+
+        // Next byte that isn't whitespace, without consuming it
+        func peek() -> UInt8? {
+            while(index < bytes.count) {
+                if(!isWhitespace(bytes[index])) {
+                    return bytes[index]
+                }
+                index += 1
+            }
+            return nil
+        }
+
+        guard let first = peek() else {
+            throw GridReferenceParseError.empty
+        }
+        guard isDigit(first) else {
+            throw GridReferenceParseError.invalidZone
+        }
+        index += 1
+        var zone = Int(first - ASCII.zero)
+        if let second = peek(), isDigit(second) {
+            zone = zone * 10 + Int(second - ASCII.zero)
+            index += 1
+        }
+
+        guard let bandByte = peek() else {
+            throw GridReferenceParseError.invalidBand
+        }
+        let band = uppercased(bandByte)
+        guard band >= ASCII.c && band <= ASCII.x && band != ASCII.i && band != ASCII.o else {
+            throw GridReferenceParseError.invalidBand
+        }
+        index += 1
+        guard zone >= 1 && zone <= GridReferenceParser.MAX_ZONE else {
+            throw GridReferenceParseError.invalidZone
+        }
+        // 32X, 34X and 36X don't exist
+        guard let bandIndex = GridZoneTable.bandIndex(letter: band),
+              GridZoneTable.contains(GridZoneID(zone: zone, bandIndex: bandIndex)) else {
+            throw GridReferenceParseError.invalidZone
+        }
+
+        guard let columnByte = peek() else {
+            return MGRSReference(zone: zone, band: band, column: nil, row: nil, easting: 0, northing: 0, precision: 0)
+        }
+        let column = uppercased(columnByte)
+        guard column >= ASCII.a && column <= ASCII.z && column != ASCII.i && column != ASCII.o else {
+            throw GridReferenceParseError.invalidSquare
+        }
+        index += 1
+        guard let rowByte = peek() else {
+            throw GridReferenceParseError.invalidSquare
+        }
+        let row = uppercased(rowByte)
+        guard row >= ASCII.a && row <= ASCII.v && row != ASCII.i && row != ASCII.o else {
+            throw GridReferenceParseError.invalidSquare
+        }
+        index += 1
+
+        // Easting and northing digits, read as one number and split after
+        var digits = 0
+        var value = 0
+        while let byte = peek() {
+            guard isDigit(byte) else {
+                throw GridReferenceParseError.unexpectedCharacter(offset: index)
+            }
+            digits += 1
+            if(digits > GridReferenceParser.MAX_MGRS_DIGITS) {
+                throw GridReferenceParseError.invalidDigits
+            }
+            value = value * 10 + Int(byte - ASCII.zero)
+            index += 1
+        }
+        if(digits % 2 != 0) {
+            throw GridReferenceParseError.invalidDigits
+        }
+
+        let precision = digits / 2
+        let divisor = GridReferenceParser.INTEGER_POWERS_OF_TEN[precision]
+        let multiplier = GridReferenceParser.INTEGER_POWERS_OF_TEN[5 - precision]
+        return MGRSReference(zone: zone,
+                             band: band,
+                             column: column,
+                             row: row,
+                             easting: value / divisor * multiplier,
+                             northing: value % divisor * multiplier,
+                             precision: precision)
+    }
+
+    // MARK: UTM
+
+    static func parseUTM(_ text: String) throws -> UTMCoordinate {
+        var text = text
+        return try text.withUTF8 { try parseUTM(bytes: $0) }
+    }
+
+    static func utm(_ text: String) -> UTMCoordinate? {
+        return try? parseUTM(text)
+    }
+
+    static func parseUTM(_ texts: [String]) -> [Result<UTMCoordinate, GridReferenceParseError>] {
+        return texts.map { text in
+            var text = text
+            return text.withUTF8 { bytes in
+                Result { try parseUTM(bytes: bytes) }.mapError { $0 as! GridReferenceParseError }
+            }
+        }
+    }
+
+    // Zone, N or S, easting, northing: "18N 326938.11 4305973.74"
+    static func parseUTM(bytes: UnsafeBufferPointer<UInt8>) throws -> UTMCoordinate {
+        var index = 0
+        var end = bytes.count
+        while(index < end && isWhitespace(bytes[index])) {
+            index += 1
+        }
+        while(end > index && isWhitespace(bytes[end - 1])) {
+            end -= 1
+        }
+        guard index < end else {
+            throw GridReferenceParseError.empty
+        }
+
+        var zone = 0
+        var zoneDigits = 0
+        while(index < end && isDigit(bytes[index])) {
+            zoneDigits += 1
+            if(zoneDigits > 2) {
+                throw GridReferenceParseError.invalidZone
+            }
+            zone = zone * 10 + Int(bytes[index] - ASCII.zero)
+            index += 1
+        }
+        guard zoneDigits > 0 && zone >= 1 && zone <= GridReferenceParser.MAX_ZONE else {
+            throw GridReferenceParseError.invalidZone
+        }
+
+        while(index < end && isWhitespace(bytes[index])) {
+            index += 1
+        }
+        guard index < end else {
+            throw GridReferenceParseError.invalidHemisphere
+        }
+        let hemisphere = uppercased(bytes[index])
+        guard hemisphere == ASCII.n || hemisphere == ASCII.s else {
+            throw GridReferenceParseError.invalidHemisphere
+        }
+        index += 1
+
+        while(index < end && isWhitespace(bytes[index])) {
+            index += 1
+        }
+        let easting = try parseNumber(bytes, from: &index, to: end)
+        guard index < end && isWhitespace(bytes[index]) else {
+            throw index < end ? GridReferenceParseError.unexpectedCharacter(offset: index) : GridReferenceParseError.invalidNumber
+        }
+        while(index < end && isWhitespace(bytes[index])) {
+            index += 1
+        }
+        let northing = try parseNumber(bytes, from: &index, to: end)
+        guard index == end else {
+            throw GridReferenceParseError.unexpectedCharacter(offset: index)
+        }
+
+        return UTMCoordinate(zone: zone, isNorthern: hemisphere == ASCII.n, easting: easting, northing: northing)
+    }
+
+    // Digits with an optional fraction: "4305973", "4305973.", "4305973.74".
+    // Up to MAX_FAST_DIGITS significant digits the digits are exact in a
+    // Double and a single division by an exact power of ten rounds the
+    // same way Double(String) does.
+    private static func parseNumber(_ bytes: UnsafeBufferPointer<UInt8>, from index: inout Int, to end: Int) throws -> Double {
+        let start = index
+        var mantissa: UInt64 = 0
+        var digits = 0
+        var fractionDigits = 0
+        var seenPoint = false
+        guard index < end && isDigit(bytes[index]) else {
+            throw GridReferenceParseError.invalidNumber
+        }
+        while(index < end) {
+            let byte = bytes[index]
+            if(isDigit(byte)) {
+                if(digits < 19) {
+                    mantissa = mantissa * 10 + UInt64(byte - ASCII.zero)
+                }
+                // Leading zeros don't count towards precision
+                if(digits > 0 || byte != ASCII.zero) {
+                    digits += 1
+                }
+                if(seenPoint) {
+                    fractionDigits += 1
+                }
+            } else if(byte == ASCII.point && !seenPoint) {
+                seenPoint = true
+            } else {
+                break
+            }
+            index += 1
+        }
+
+        if(digits <= GridReferenceParser.MAX_FAST_DIGITS && fractionDigits < GridReferenceParser.POWERS_OF_TEN.count) {
+            return Double(mantissa) / GridReferenceParser.POWERS_OF_TEN[fractionDigits]
+        }
+        guard let value = Double(String(decoding: UnsafeBufferPointer(rebasing: bytes[start..<index]), as: UTF8.self)) else {
+            throw GridReferenceParseError.invalidNumber
+        }
+        return value
+    }
+
+    // MARK: Bytes
+
+    private enum ASCII {
+        static let zero = UInt8(ascii: "0")
+        static let nine = UInt8(ascii: "9")
+        static let point = UInt8(ascii: ".")
+        static let a = UInt8(ascii: "A")
+        static let c = UInt8(ascii: "C")
+        static let i = UInt8(ascii: "I")
+        static let n = UInt8(ascii: "N")
+        static let o = UInt8(ascii: "O")
+        static let s = UInt8(ascii: "S")
+        static let v = UInt8(ascii: "V")
+        static let x = UInt8(ascii: "X")
+        static let z = UInt8(ascii: "Z")
+        static let lowercaseA = UInt8(ascii: "a")
+        static let lowercaseZ = UInt8(ascii: "z")
+    }
+
+    @inline(__always)
+    private static func isDigit(_ byte: UInt8) -> Bool {
+        return byte >= ASCII.zero && byte <= ASCII.nine
+    }
+
+    // Space, tab, newline, vertical tab, form feed, carriage return
+    @inline(__always)
+    private static func isWhitespace(_ byte: UInt8) -> Bool {
+        return byte == 0x20 || (byte >= 0x09 && byte <= 0x0D)
+    }
+
+    @inline(__always)
+    private static func uppercased(_ byte: UInt8) -> UInt8 {
+        return (byte >= ASCII.lowercaseA && byte <= ASCII.lowercaseZ) ? byte - 0x20 : byte
+    }
+}
@@ -0,0 +1,220 @@
+//
+//  KMLParser.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import sf_ios
+import ZIPFoundation
+
+struct KMLPlacemark {
+    var id: String
+    var name: String
+    var geometry: SFGeometry
+    // In degrees, built once when the placemark is read
+    var envelope: SFGeometryEnvelope
+}
+
+// Reads the Placemarks out of a KML document as sf-ios geometries:
+// Point, LineString, Polygon (outerBoundaryIs plus any innerBoundaryIs
+// holes) and MultiGeometry of those.
+//
+// The document is read as a stream of SAX events, so only the placemark
+// being built is held in memory, never the document tree. KMZ files are
+// zips; their main .kml is unpacked to a temporary file and streamed the
+// same way.
+class KMLParser: NSObject, XMLParserDelegate {
+    static let KMZ_MAIN_DOCUMENT = "doc.kml"
+
+    var placemarks: [KMLPlacemark] = []
+
+    private var placemarkID: String?
+    private var placemarkName: String?
+    private var isInPlacemark = false
+    // Open Point/LineString/LinearRing/Polygon elements, innermost last
+    private var geometryStack: [String] = []
+    private var points: [SFPoint] = []
+    private var lineStrings: [SFLineString] = []
+    private var polygons: [SFPolygon] = []
+    private var rings: [SFLineString] = []
+    private var text = ""
+    private var isCollectingText = false
+
+    static func parse(url: URL) -> [KMLPlacemark] {
+        if(url.pathExtension.lowercased() == "kmz") {
+            return parseKMZ(url: url)
+        }
+        guard let stream = InputStream(url: url) else {
+            TAKLogger.error("[KMLParser]: Unable to open \(url.lastPathComponent)")
+            return []
+        }
+        return parse(parser: XMLParser(stream: stream))
+    }
+
+    static func parse(data: Data) -> [KMLPlacemark] {
+        return parse(parser: XMLParser(data: data))
+    }
+
+    private static func parse(parser xmlParser: XMLParser) -> [KMLPlacemark] {
+        let kmlParser = KMLParser()
+        xmlParser.delegate = kmlParser
+        if(!xmlParser.parse()) {
+            TAKLogger.error("[KMLParser]: Unable to parse KML: \(String(describing: xmlParser.parserError))")
+        }
+        return kmlParser.placemarks
+    }
+
+    private static func parseKMZ(url: URL) -> [KMLPlacemark] {
+        do {
+            let archive = try Archive(url: url, accessMode: .read)
+            let documents = archive.filter { $0.type == .file && $0.path.lowercased().hasSuffix(".kml") }
+            guard let document = documents.first(where: { DataPackageReader.fileName($0.path).lowercased() == KMZ_MAIN_DOCUMENT }) ?? documents.first else {
+                TAKLogger.error("[KMLParser]: No KML document in \(url.lastPathComponent)")
+                return []
+            }
+            let unpacked = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).kml")
+            defer { try? FileManager.default.removeItem(at: unpacked) }
+            _ = try archive.extract(document, to: unpacked)
+            return parse(url: unpacked)
+        } catch {
+            TAKLogger.error("[KMLParser]: Unable to read KMZ \(url.lastPathComponent): \(error)")
+            return []
+        }
+    }
+
+    // "lon,lat[,alt] lon,lat[,alt] ..."
+    static func parseCoordinates(_ text: String) -> [SFPoint] {
+        var parsed: [SFPoint] = []
+        for tuple in text.split(whereSeparator: { $0 == " " || $0 == "\n" || $0 == "\t" || $0 == "\r" }) {
+            let values = tuple.split(separator: ",", omittingEmptySubsequences: false)
+            guard values.count >= 2, let x = Double(values[0]), let y = Double(values[1]) else {
+                continue
+            }
+            parsed.append(SFPoint(xValue: x, andYValue: y))
+        }
+        return parsed
+    }
+
+    func parser(
+        _ parser: XMLParser,
+        didStartElement elementName: String,
+        namespaceURI: String?,
+        qualifiedName qName: String?,
+        attributes attributeDict: [String : String] = [:]
+    ) {
+        switch elementName {
+        case "Placemark":
+            isInPlacemark = true
+            placemarkID = attributeDict["id"]
+            placemarkName = nil
+            points = []
+            lineStrings = []
+            polygons = []
+        case "Point", "LineString", "Polygon", "LinearRing":
+            geometryStack.append(elementName)
+            if(elementName == "Polygon") {
+                rings = []
+            }
+        case "coordinates":
+            isCollectingText = !geometryStack.isEmpty
+            text = ""
+        case "name":
+            isCollectingText = isInPlacemark && geometryStack.isEmpty && placemarkName == nil
+            text = ""
+        default:
+            return
+        }
+    }
+
+    func parser(_ parser: XMLParser, foundCharacters string: String) {
+        if(isCollectingText) {
+            text.append(string)
+        }
+    }
+
+    func parser(
+        _ parser: XMLParser,
+        didEndElement elementName: String,
+        namespaceURI: String?,
+        qualifiedName qName: String?
+    ) {
+        switch elementName {
+        case "coordinates":
+            guard isCollectingText else { return }
+            isCollectingText = false
+            addCoordinates(KMLParser.parseCoordinates(text))
+            text = ""
+        case "name":
+            if(isCollectingText) {
+                placemarkName = text.trimmingCharacters(in: .whitespacesAndNewlines)
+                isCollectingText = false
+            }
+        case "LinearRing", "LineString", "Point":
+            geometryStack.removeLast()
+        case "Polygon":
+            geometryStack.removeLast()
+            // outerBoundaryIs comes first
+            if let outer = rings.first {
+                let polygon: SFPolygon = SFPolygon(ring: outer)
+                for hole in rings.dropFirst() {
+                    polygon.addRing(hole)
+                }
+                polygons.append(polygon)
+            }
+            rings = []
+        case "Placemark":
+            isInPlacemark = false
+            if let geometry = placemarkGeometry() {
+                let index = placemarks.count
+                placemarks.append(KMLPlacemark(
+                    id: placemarkID ?? "placemark-\(index)",
+                    name: placemarkName ?? "",
+                    geometry: geometry,
+                    envelope: SFGeometryEnvelopeBuilder.buildEnvelope(with: geometry)
+                ))
+            }
+        default:
+            return
+        }
+    }
+
+    // Coordinates belong to the innermost open geometry
+    private func addCoordinates(_ coordinates: [SFPoint]) {
+        guard let first = coordinates.first, let geometry = geometryStack.last else { return }
+        if(geometry == "Point") {
+            points.append(first)
+            return
+        }
+        let lineString = SFLineString()
+        for point in coordinates {
+            lineString.addPoint(point)
+        }
+        if(geometry == "LinearRing" && geometryStack.contains("Polygon")) {
+            rings.append(lineString)
+        } else {
+            lineStrings.append(lineString)
+        }
+    }
+
+    private func placemarkGeometry() -> SFGeometry? {
+        let geometries = (polygons as [SFGeometry]) + (lineStrings as [SFGeometry]) + (points as [SFGeometry])
+        if(geometries.count <= 1) {
+            return geometries.first
+        }
+        if(polygons.count == geometries.count) {
+            let multiPolygon = SFMultiPolygon()
+            polygons.forEach { multiPolygon.addPolygon($0) }
+            return multiPolygon
+        }
+        if(lineStrings.count == geometries.count) {
+            let multiLineString = SFMultiLineString()
+            lineStrings.forEach { multiLineString.addLineString($0) }
+            return multiLineString
+        }
+        let collection = SFGeometryCollection()
+        geometries.forEach { collection.addGeometry($0) }
+        return collection
+    }
+}
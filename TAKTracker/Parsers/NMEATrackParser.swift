@@ -0,0 +1,160 @@
+//
+//  NMEATrackParser.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import CoreLocation
+import Foundation
+
+// Builds a track from NMEA 0183 sentences. RMC sentences provide the
+// fixes (time, position, speed, course); a GGA sentence for the same
+// time adds altitude and an accuracy estimate from its HDOP.
+// Sentences with a bad checksum or a void status are ignored.
+class NMEATrackParser {
+    static let METERS_PER_SECOND_PER_KNOT = 0.514444
+    // Rough conversion from HDOP to a horizontal accuracy in meters
+    static let METERS_PER_HDOP = 5.0
+
+    private struct FixQuality {
+        var time: String
+        var altitude: Double
+        var horizontalAccuracy: Double
+    }
+
+    var locations: [CLLocation] = []
+
+    private var lastQuality: FixQuality?
+    private var lastFixTime: String?
+    private let utc = TimeZone(identifier: "UTC")!
+
+    static func parse(data: Data) -> [CLLocation] {
+        guard let contents = String(data: data, encoding: .utf8) ?? String(data: data, encoding: .ascii) else {
+            return []
+        }
+        let parser = NMEATrackParser()
+        contents.enumerateLines { line, _ in
+            parser.parse(sentence: line)
+        }
+        return parser.locations
+    }
+
+    func parse(sentence rawSentence: String) {
+        let sentence = rawSentence.trimmingCharacters(in: .whitespacesAndNewlines)
+        guard sentence.hasPrefix("$"), NMEATrackParser.hasValidChecksum(sentence) else {
+            return
+        }
+
+        let body = sentence.dropFirst().split(separator: "*", maxSplits: 1).first ?? ""
+        let fields = body.split(separator: ",", omittingEmptySubsequences: false).map(String.init)
+        guard let talkerAndType = fields.first, talkerAndType.count >= 5 else {
+            return
+        }
+
+        switch talkerAndType.suffix(3) {
+        case "RMC":
+            parseRMC(fields)
+        case "GGA":
+            parseGGA(fields)
+        default:
+            return
+        }
+    }
+
+    static func hasValidChecksum(_ sentence: String) -> Bool {
+        let parts = sentence.dropFirst().split(separator: "*", maxSplits: 1)
+        // Sentences without a checksum are accepted as-is
+        guard parts.count == 2 else { return parts.count == 1 }
+        guard let expected = UInt8(parts[1].prefix(2), radix: 16) else { return false }
+        let actual = parts[0].utf8.reduce(UInt8(0)) { $0 ^ $1 }
+        return actual == expected
+    }
+
+    // ddmm.mmmm / dddmm.mmmm plus a hemisphere letter
+    static func coordinate(_ value: String, hemisphere: String) -> Double? {
+        guard let raw = Double(value), !value.isEmpty else { return nil }
+        let degrees = floor(raw / 100.0)
+        let minutes = raw - degrees * 100.0
+        let decimal = degrees + minutes / 60.0
+        return (hemisphere == "S" || hemisphere == "W") ? -decimal : decimal
+    }
+
+    private func parseGGA(_ fields: [String]) {
+        // $GPGGA,time,lat,N,lon,W,quality,satellites,hdop,altitude,M,...
+        guard fields.count > 9, let quality = Int(fields[6]), quality > 0 else { return }
+        let altitude = Double(fields[9]) ?? 0
+        let hdop = Double(fields[8]) ?? 1
+        let fixQuality = FixQuality(time: fields[1], altitude: altitude, horizontalAccuracy: hdop * NMEATrackParser.METERS_PER_HDOP)
+        lastQuality = fixQuality
+
+        // GGA can follow the RMC for the same epoch
+        if lastFixTime == fields[1], let last = locations.last {
+            locations[locations.count - 1] = location(from: last, quality: fixQuality)
+        }
+    }
+
+    private func parseRMC(_ fields: [String]) {
+        // $GPRMC,time,status,lat,N,lon,W,knots,course,ddmmyy,...
+        guard fields.count > 9, fields[2] == "A",
+              let latitude = NMEATrackParser.coordinate(fields[3], hemisphere: fields[4]),
+              let longitude = NMEATrackParser.coordinate(fields[5], hemisphere: fields[6]),
+              let timestamp = date(time: fields[1], date: fields[9]) else {
+            return
+        }
+
+        let speed = Double(fields[7]).map { $0 * NMEATrackParser.METERS_PER_SECOND_PER_KNOT } ?? -1
+        let course = Double(fields[8]) ?? -1
+
+        var location = CLLocation(
+            coordinate: CLLocationCoordinate2D(latitude: latitude, longitude: longitude),
+            altitude: 0,
+            horizontalAccuracy: 5,
+            verticalAccuracy: -1,
+            course: course,
+            speed: speed,
+            timestamp: timestamp
+        )
+        if let quality = lastQuality, quality.time == fields[1] {
+            location = self.location(from: location, quality: quality)
+        }
+        lastFixTime = fields[1]
+        locations.append(location)
+    }
+
+    private func location(from location: CLLocation, quality: FixQuality) -> CLLocation {
+        return CLLocation(
+            coordinate: location.coordinate,
+            altitude: quality.altitude,
+            horizontalAccuracy: quality.horizontalAccuracy,
+            verticalAccuracy: quality.horizontalAccuracy,
+            course: location.course,
+            speed: location.speed,
+            timestamp: location.timestamp
+        )
+    }
+
+    // hhmmss(.ss) and ddmmyy, always UTC
+    private func date(time: String, date: String) -> Date? {
+        guard time.count >= 6, date.count == 6,
+              let hour = Int(time.prefix(2)),
+              let minute = Int(time.dropFirst(2).prefix(2)),
+              let seconds = Double(time.dropFirst(4)),
+              let day = Int(date.prefix(2)),
+              let month = Int(date.dropFirst(2).prefix(2)),
+              let year = Int(date.suffix(2)) else {
+            return nil
+        }
+        var components = DateComponents()
+        components.timeZone = utc
+        components.year = 2000 + year
+        components.month = month
+        components.day = day
+        components.hour = hour
+        components.minute = minute
+        components.second = Int(seconds)
+        var calendar = Calendar(identifier: .gregorian)
+        calendar.timeZone = utc
+        return calendar.date(from: components)?.addingTimeInterval(seconds - floor(seconds))
+    }
+}
@@ -9,84 +9,166 @@ import Foundation
 import NIOSSL
 import SwiftTAK
 
+// Imports a data package: reads it with DataPackageReader, then decodes the
+// user and server PKCS#12 bundles while the package's overlays and other
+// content stream into the content store. The identity, truststore and
+// server preferences are stored on the main actor once all three are done,
+// and only the ones the package has. A package of just overlays or imagery
+// leaves the current connection alone.
+//
+// Errors are collected in a fixed order (package, user certificate, server
+// certificates, content) no matter which step finishes first.
 class TAKDataPackageParser: NSObject {
+    // Share of progress given to reading the config, then to storing content
+    static let READ_PROGRESS_SHARE = 0.1
+    static let CONTENT_PROGRESS_SHARE = 0.8
+
     var archiveLocation: URL
     var parsingErrors: [String] = []
-    
-    init (fileLocation: URL) {
+    let contentStore: DataPackageContentStore
+
+    init (fileLocation: URL, contentStore: DataPackageContentStore = DataPackageContentStore.global) {
         TAKLogger.debug("[TAKDataPackageParser]: Initializing")
         archiveLocation = fileLocation
+        self.contentStore = contentStore
         super.init()
     }
-    
-    func parse() {
-        let parser = DataPackageParser(fileLocation: archiveLocation)
-        parser.parse()
-        let contents = parser.packageContents
-        storeUserCertificate(packageContents: contents)
-        storeServerCertificate(packageContents: contents)
-        storePreferences(packageContents: contents)
+
+    // Progress runs from 0 to 1 and is reported on the main queue.
+    // Returns the parsing errors, empty when the package was imported.
+    @discardableResult
+    func parse(progress: @escaping (Double) -> Void = { _ in }) async -> [String] {
+        let report = { (fraction: Double) in
+            DispatchQueue.main.async { progress(fraction) }
+        }
+
+        let reader = DataPackageReader(fileLocation: archiveLocation)
+        var contents = DataPackageContents()
+        var readErrors: [String] = []
+        do {
+            contents = try reader.read { fraction in
+                report(fraction * TAKDataPackageParser.READ_PROGRESS_SHARE)
+            }
+        } catch DataPackageError.unreadableArchive(let url) {
+            TAKLogger.error("[TAKDataPackageParser]: Unable to open Data Package at \(url)")
+            await MainActor.run {
+                self.parsingErrors = ["Could not read the data package \(DataPackageError.unreadableArchive(url))"]
+                progress(1.0)
+            }
+            return parsingErrors
+        } catch {
+            // The content is still worth storing without the connection
+            TAKLogger.error("[TAKDataPackageParser]: Unable to read Data Package connection: \(error)")
+            readErrors.append("Could not read the data package connection \(error)")
+        }
+
+        let hasUserCertificate = !contents.userCertificate.isEmpty
+        let hasServerCertificates = !contents.serverCertificates.isEmpty
+        async let identity = hasUserCertificate ? TAKDataPackageParser.userIdentity(packageContents: contents) : nil
+        async let serverCertificates = hasServerCertificates ? TAKDataPackageParser.serverCertificateChain(packageContents: contents) : nil
+        async let storedContent = TAKDataPackageParser.storeContents(of: reader, in: self.contentStore) { fraction in
+            report(TAKDataPackageParser.READ_PROGRESS_SHARE + fraction * TAKDataPackageParser.CONTENT_PROGRESS_SHARE)
+        }
+        let (userIdentity, serverChain, contentErrors) = await (identity, serverCertificates, storedContent)
+        report(TAKDataPackageParser.READ_PROGRESS_SHARE + TAKDataPackageParser.CONTENT_PROGRESS_SHARE)
+
+        await MainActor.run {
+            self.parsingErrors = readErrors
+            if(hasUserCertificate) {
+                self.storeUserIdentity(userIdentity, label: contents.serverURL)
+            }
+            if let serverChain = serverChain {
+                self.storeServerCertificateChain(serverChain)
+            }
+            if(!contents.serverURL.isEmpty) {
+                self.storePreferences(packageContents: contents)
+            }
+            self.parsingErrors.append(contentsOf: contentErrors)
+            progress(1.0)
+        }
         TAKLogger.debug("[TAKDataPackageParser]: Completed Parsing")
+        return parsingErrors
     }
-    
+
     func storeUserCertificate(packageContents: DataPackageContents) {
-        TAKLogger.debug("[TAKDataPackageParser]: Storing User Certificate")
-        
-        DispatchQueue.global(qos: .background).async {
-            //Parse the cert file
-            let parsedCert = PKCS12(data: packageContents.userCertificate, password: packageContents.userCertificatePassword)
-            
-            guard let identity = parsedCert.identity else {
-                self.parsingErrors.append("No User Certificate found")
-                TAKLogger.error("[TAKDataPackageParser]: Identity was not present in the parsed cert")
-                return
-            }
-            
-            SettingsStore.global.storeIdentity(identity: identity, label: packageContents.serverURL)
-            
-            TAKLogger.debug("[TAKDataPackageParser]: User Certificate Stored")
-        }
+        storeUserIdentity(TAKDataPackageParser.userIdentity(packageContents: packageContents), label: packageContents.serverURL)
     }
-    
+
     func storeServerCertificate(packageContents: DataPackageContents) {
-        TAKLogger.debug("[TAKDataPackageParser]: Storing Server Certificate")
-        
+        storeServerCertificateChain(TAKDataPackageParser.serverCertificateChain(packageContents: packageContents))
+    }
+
+    func storePreferences(packageContents: DataPackageContents) {
+        SettingsStore.global.takServerUrl = packageContents.serverURL
+        SettingsStore.global.takServerPort = packageContents.serverPort
+        SettingsStore.global.takServerProtocol = packageContents.serverProtocol
+        SettingsStore.global.takServerChanged = true
+    }
+
+    static func userIdentity(packageContents: DataPackageContents) -> SecIdentity? {
+        TAKLogger.debug("[TAKDataPackageParser]: Parsing User Certificate")
+        let parsedCert = PKCS12(data: packageContents.userCertificate, password: packageContents.userCertificatePassword)
+        return parsedCert.identity
+    }
+
+    // Returns what went wrong, if anything
+    static func storeContents(of reader: DataPackageReader, in store: DataPackageContentStore, progress: (Double) -> Void) -> [String] {
+        do {
+            let index = try reader.storeContents(in: store, progress: progress)
+            TAKLogger.debug("[TAKDataPackageParser]: Stored \(index.entries.count) content item(s)")
+            return []
+        } catch {
+            TAKLogger.error("[TAKDataPackageParser]: Unable to store Data Package contents: \(error)")
+            return ["Could not store the data package contents \(error)"]
+        }
+    }
+
+    // The DER encoded chain plus anything that went wrong reading it
+    static func serverCertificateChain(packageContents: DataPackageContents) -> (chain: [Data], errors: [String]) {
+        TAKLogger.debug("[TAKDataPackageParser]: Parsing Server Certificate")
+
         let serverCerts = packageContents.serverCertificates
         var serverCertChain: [Data] = []
-        
+        var errors: [String] = []
+
         guard !serverCerts.isEmpty else {
-            parsingErrors.append("No Server truststore certificate was found in the data package")
-            SettingsStore.global.serverCertificateTruststore = serverCertChain
-            return
+            return ([], ["No Server truststore certificate was found in the data package"])
         }
-        
+
         do {
             try serverCerts.forEach { serverCert in
-                print(serverCert)
                 let p12Bundle = try NIOSSLPKCS12Bundle(buffer: Array(serverCert.certificateData), passphrase: Array(serverCert.certificatePassword.utf8))
                 try p12Bundle.certificateChain.forEach { cert in
-                    print(cert)
                     try serverCertChain.append(Data(cert.toDERBytes()))
                 }
             }
         } catch {
-            parsingErrors.append("Could not process server certificates \(error)")
+            errors.append("Could not process server certificates \(error)")
             TAKLogger.error("[TAKDataPackageParser]: Unable to store Server Certificate from Data Package: \(error)")
         }
-        
+
         if(serverCertChain.isEmpty) {
-            parsingErrors.append("No Server truststore certificate was found in the data package")
+            errors.append("No Server truststore certificate was found in the data package")
         }
-        
-        TAKLogger.debug("[TAKDataPackageParser]: Storing cert chain with \(serverCertChain.count) cert(s)")
-        SettingsStore.global.serverCertificateTruststore = serverCertChain
+        return (serverCertChain, errors)
     }
-    
-    func storePreferences(packageContents: DataPackageContents) {        
-        SettingsStore.global.takServerUrl = packageContents.serverURL
-        SettingsStore.global.takServerPort = packageContents.serverPort
-        SettingsStore.global.takServerProtocol = packageContents.serverProtocol
-        SettingsStore.global.takServerChanged = true
+
+    private func storeUserIdentity(_ identity: SecIdentity?, label: String) {
+        TAKLogger.debug("[TAKDataPackageParser]: Storing User Certificate")
+        guard let identity = identity else {
+            parsingErrors.append("No User Certificate found")
+            TAKLogger.error("[TAKDataPackageParser]: Identity was not present in the parsed cert")
+            return
+        }
+
+        SettingsStore.global.storeIdentity(identity: identity, label: label)
+
+        TAKLogger.debug("[TAKDataPackageParser]: User Certificate Stored")
     }
 
+    private func storeServerCertificateChain(_ serverChain: (chain: [Data], errors: [String])) {
+        parsingErrors.append(contentsOf: serverChain.errors)
+        TAKLogger.debug("[TAKDataPackageParser]: Storing cert chain with \(serverChain.chain.count) cert(s)")
+        SettingsStore.global.serverCertificateTruststore = serverChain.chain
+    }
 }
@@ -9,25 +9,62 @@ import SwiftUI
 
 struct ChatView: View {
     @Environment(\.presentationMode) var presentationMode
+    @EnvironmentObject var takManager: TAKManager
     @StateObject var viewModel = ChatViewModel()
     @State private var message = ""
     @State private var searchResults = ""
     @State private var searchText = ""
-    
-    let columns = [GridItem(.flexible(minimum: 10))]
+    @State private var olderAnchorID: String?
+    @State private var isFollowingLatest = true
     
     var body: some View {
         NavigationView {
             VStack {
                 GeometryReader { geo in
-                    ScrollView {
-                        LazyVGrid(columns: columns, spacing: 0) {
-                            ForEach(viewModel.messages) { message in
-                                HStack {
-                                    MessageView(message: message, viewWidth: geo.size.width)
-                                        .padding(.horizontal)
+                    ScrollViewReader { proxy in
+                        ScrollView {
+                            LazyVStack(spacing: 0) {
+                                if viewModel.hasOlder {
+                                    ProgressView()
+                                        .padding()
+                                        .onAppear {
+                                            olderAnchorID = viewModel.messages.first?.id
+                                            viewModel.loadOlder()
+                                        }
+                                }
+                                ForEach(viewModel.messages) { message in
+                                    HStack {
+                                        MessageView(message: message, viewWidth: geo.size.width)
+                                            .padding(.horizontal)
+                                    }
+                                    .frame(maxWidth: .infinity, alignment: message.isFromCurrentUser() ? .trailing : .leading)
+                                    .id(message.id)
+                                }
+                                if !viewModel.isAtLatest {
+                                    ProgressView()
+                                        .padding()
+                                        .onAppear {
+                                            viewModel.loadNewer()
+                                        }
+                                }
+                                Color.clear
+                                    .frame(height: 1)
+                                    .onAppear { isFollowingLatest = true }
+                                    .onDisappear { isFollowingLatest = false }
+                            }
+                        }
+                        .onChange(of: viewModel.messages.first?.id) { _ in
+                            // An older page went in above: keep the row being read in place
+                            if let anchor = olderAnchorID {
+                                proxy.scrollTo(anchor, anchor: .top)
+                                olderAnchorID = nil
+                            }
+                        }
+                        .onChange(of: viewModel.messages.last?.id) { lastID in
+                            if let lastID = lastID, isFollowingLatest, viewModel.isAtLatest {
+                                withAnimation {
+                                    proxy.scrollTo(lastID, anchor: .bottom)
                                 }
-                                .frame(maxWidth: .infinity, alignment: message.isFromCurrentUser() ? .trailing : .leading)
                             }
                         }
                     }
@@ -86,7 +123,7 @@ struct ChatView: View {
             }
             .background(Color.baseChatBackground.ignoresSafeArea(edges: .all))
             .onAppear {
-                viewModel.messages = ChatViewModel.data
+                viewModel.start(takManager: takManager)
             }
             .navigationTitle("Chat")
             .navigationBarTitleDisplayMode(.inline)
@@ -106,7 +143,15 @@ struct ChatView: View {
 }
 
 #Preview {
-    ChatView()
+    ChatView(viewModel: ChatViewModel(messages: [
+        MessageData.defaultOutgoingMessage1,
+        MessageData.defaultIncomingMessage1,
+        MessageData.defaultIncomingMessage2,
+        MessageData.defaultOutgoingMessage2,
+        MessageData.defaultOutgoingMessage3,
+        MessageData.defaultIncomingMessage3
+    ]))
+    .environmentObject(TAKManager())
 }
 
 
@@ -102,12 +102,12 @@ struct EmergencyView: View {
                     if(alertType == EmergencyType.Cancel) {
                         SettingsStore.global.activeAlertType = alertType.rawValue
                         SettingsStore.global.isAlertActivated = false
-                        takManager.cancelEmergencyAlert(location: location.lastLocation)
+                        takManager.cancelEmergencyAlert(location: location.currentLocation)
                         TAKLogger.debug("Alert Cancelled")
                     } else {
                         SettingsStore.global.activeAlertType = alertType.rawValue
                         SettingsStore.global.isAlertActivated = true
-                        takManager.initiateEmergencyAlert(location: location.lastLocation)
+                        takManager.initiateEmergencyAlert(location: location.currentLocation)
                         TAKLogger.debug("Alert Activated!")
                     }
                     dismiss()
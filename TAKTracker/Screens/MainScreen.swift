@@ -8,198 +8,6 @@
 import SwiftUI
 import MapKit
 
-struct DisplayUIState {
-    var currentLocationUnit = LocationUnit.DMS
-    var currentSpeedUnit = SpeedUnit.MetersPerSecond
-    var currentCompassUnit = DirectionUnit.MN
-    var currentHeadingUnit = DirectionUnit.TN
-    
-    mutating func nextHeadingUnit() {
-        currentHeadingUnit = UnitOrder.nextDirectionUnit(unit: currentHeadingUnit)
-    }
-    
-    mutating func nextCompassUnit() {
-        currentCompassUnit = UnitOrder.nextDirectionUnit(unit: currentCompassUnit)
-    }
-    
-    mutating func nextSpeedUnit() {
-        currentSpeedUnit = UnitOrder.nextSpeedUnit(unit: currentSpeedUnit)
-    }
-    
-    mutating func nextLocationUnit() {
-        currentLocationUnit = UnitOrder.nextLocationUnit(unit: currentLocationUnit)
-    }
-    
-    func headingText(unit:DirectionUnit) -> String {
-        if(unit == DirectionUnit.TN) {
-            return "°" + "TN"
-        } else {
-            return "°" + "MN"
-        }
-    }
-    
-    func headingValue(unit:DirectionUnit, heading: CLHeading?) -> String {
-        guard let locationHeading = heading else {
-            #if targetEnvironment(simulator)
-            if(unit == DirectionUnit.TN) {
-                return "24"
-            } else {
-                return "18"
-            }
-            #else
-            return "--"
-            #endif
-        }
-        if(unit == DirectionUnit.TN) {
-            return Converter.formatOrZero(item: locationHeading.trueHeading) + "°"
-        } else {
-            return Converter.formatOrZero(item: locationHeading.magneticHeading) + "°"
-        }
-    }
-    
-    func speedText() -> String {
-        switch(currentSpeedUnit) {
-            case .MetersPerSecond: return "m/s"
-            case .KmPerHour: return "kph"
-            case .FeetPerSecond: return "fps"
-            case .MilesPerHour: return "mph"
-        }
-    }
-    
-    func speedValue(location: CLLocation?) -> String {
-        guard let location = location else {
-            return "--"
-        }
-        return Converter.convertToSpeedUnit(unit: currentSpeedUnit, location: location)
-    }
-    
-    func coordinateText() -> String {
-        switch(currentLocationUnit) {
-            case .DMS: return "DMS"
-            case .Decimal: return "Decimal"
-            case .MGRS: return "MGRS"
-        }
-    }
-    
-    func coordinateValue(location: CLLocation?) -> CoordinateDisplay {
-        var display = CoordinateDisplay()
-        guard let location = location else {
-            display.addLine(line: CoordinateDisplayLine(
-                lineContents: "---"
-            ))
-            return display
-        }
-        
-        switch(currentLocationUnit) {
-        case .DMS:
-            let latDMS = Converter.LatLonToDMS(latitude: location.coordinate.latitude).components(separatedBy: "  ")
-            let longDMS = Converter.LatLonToDMS(longitude: location.coordinate.longitude).components(separatedBy: "  ")
-            display.addLine(line: CoordinateDisplayLine(
-                lineTitle: latDMS.first!,
-                lineContents: latDMS.last!
-            ))
-            display.addLine(line: CoordinateDisplayLine(
-                lineTitle: longDMS.first!,
-                lineContents: longDMS.last!
-            ))
-        case .Decimal:
-            display.addLine(line: CoordinateDisplayLine(
-                lineTitle: "Lat",
-                lineContents: Converter.LatLonToDecimal(latitude: location.coordinate.latitude)
-            ))
-            display.addLine(line: CoordinateDisplayLine(
-                lineTitle: "Lon",
-                lineContents: Converter.LatLonToDecimal(latitude: location.coordinate.longitude)
-            ))
-        case .MGRS:
-            let mgrsString = Converter.LatLongToMGRS(latitude: location.coordinate.latitude, longitude: location.coordinate.longitude)
-            display.addLine(line: CoordinateDisplayLine(
-                lineContents: mgrsString
-            ))
-
-        }
-        
-        return display
-    }
-}
-
-struct CoordinateDisplay {
-    var lines:[CoordinateDisplayLine] = []
-    
-    mutating func addLine(line:CoordinateDisplayLine) {
-        lines.append(line)
-    }
-}
-
-struct CoordinateDisplayLine {
-    var id = UUID()
-    var lineTitle:String = ""
-    var lineContents:String = ""
-    
-    func hasLineTitle() -> Bool {
-        !lineTitle.isEmpty
-    }
-}
-
-struct MapView: UIViewRepresentable {
-    @Binding var region: MKCoordinateRegion
-    @Binding var mapType: UInt
-
-    let mapView = MKMapView()
-
-    func makeUIView(context: Context) -> MKMapView {
-        mapView.delegate = context.coordinator
-        mapView.setRegion(region, animated: true)
-        mapView.setCenter(region.center, animated: true)
-        mapView.showsUserLocation = true
-        mapView.showsCompass = true
-        mapView.userTrackingMode = .followWithHeading
-        mapView.pointOfInterestFilter = .excludingAll
-        mapView.mapType = MKMapType(rawValue: UInt(mapType))!
-        mapView.layer.borderColor = UIColor.black.cgColor
-        mapView.layer.borderWidth = 1.0
-        mapView.isHidden = false
-        return mapView
-    }
-
-    func updateUIView(_ view: MKMapView, context: Context) {
-        view.mapType = MKMapType(rawValue: UInt(mapType))!
-        view.isHidden = view.frame.height < 150
-    }
-    
-    func resetMap() {
-        mapView.showsCompass = true
-        mapView.userTrackingMode = .followWithHeading
-    }
-
-    func makeCoordinator() -> Coordinator {
-        return Coordinator(self)
-    }
-
-    class Coordinator: NSObject, MKMapViewDelegate, UIGestureRecognizerDelegate {
-        var parent: MapView
-
-        var gRecognizer = UITapGestureRecognizer()
-
-        init(_ parent: MapView) {
-            self.parent = parent
-            super.init()
-            self.gRecognizer = UITapGestureRecognizer(target: self, action: #selector(tapHandler))
-            self.gRecognizer.delegate = self
-            self.parent.mapView.addGestureRecognizer(gRecognizer)
-        }
-
-        @objc func tapHandler(_ gesture: UITapGestureRecognizer) {
-            // position on the screen, CGPoint
-            let location = gRecognizer.location(in: self.parent.mapView)
-            // position on the map, CLLocationCoordinate2D
-            let coordinate = self.parent.mapView.convert(location, toCoordinateFrom: self.parent.mapView)
-            TAKLogger.debug("Map Tapped! \(String(describing: coordinate))")
-            parent.resetMap()
-        }
-    }
-}
-
 // Our custom view modifier to track rotation and
 // call our action
 struct DeviceRotationViewModifier: ViewModifier {
@@ -227,12 +35,16 @@ struct MainScreen: View {
     @EnvironmentObject var settingsStore: SettingsStore
     @EnvironmentObject var takManager: TAKManager
     @EnvironmentObject var manager: LocationManager
+    @EnvironmentObject var mapController: MapController
     
+    @StateObject private var nearestContacts = NearestContactsViewModel()
     @State private var displayUIState = DisplayUIState()
     @State private var tracking:MapUserTrackingMode = .none
     @State private var sheet: Sheet.SheetType?
     @State private var migrator = Migrator()
     @State var isShowingAlert = false
+    @State private var geofenceAlert: GeofenceAlert?
+    @State private var isShowingGeofenceAlert = false
     
     func formatOrZero(item: Double?, formatter: String = "%.0f") -> String {
         guard let item = item else {
@@ -255,6 +67,13 @@ struct MainScreen: View {
         NavigationView {
             trackerStatus
             .background(Color.baseMediumGray)
+            .alert(isPresented: $isShowingGeofenceAlert) {
+                Alert(
+                    title: Text("Geofence"),
+                    message: Text(geofenceAlert?.message ?? ""),
+                    dismissButton: .default(Text("OK"))
+                )
+            }
             .navigationBarTitleDisplayMode(.inline)
             .toolbar {
                 ToolbarItemGroup(placement: .principal) {
@@ -295,9 +114,18 @@ struct MainScreen: View {
                 settingsStore.lastAppVersionRun = AppConstants.getAppReleaseVersion()
                 isShowingAlert = !migrator.migrationSucceeded
             }
-            broadcastLocation()
-            Timer.scheduledTimer(withTimeInterval: settingsStore.broadcastIntervalSeconds, repeats: true) { timer in
-                broadcastLocation()
+            nearestContacts.start(contactStore: takManager.contactStore, locationSource: manager)
+            takManager.geofenceMonitor.start(contactStore: takManager.contactStore, locationSource: manager, fenceStore: DataPackageContentStore.global)
+            takManager.broadcastPolicy.start(locationSource: manager, interval: settingsStore.broadcastIntervalSeconds)
+            Timer.scheduledTimer(withTimeInterval: takManager.broadcastPolicy.interval, repeats: true) { timer in
+                takManager.broadcastPolicy.advance(by: timer.timeInterval)
+            }
+        }
+        .onReceive(takManager.geofenceMonitor.alerts) { alert in
+            // Contacts crossing fences only go to the log
+            if(alert.isSelf) {
+                geofenceAlert = alert
+                isShowingGeofenceAlert = true
             }
         }
         .onRotate { newOrientation in
@@ -391,15 +219,23 @@ struct MainScreen: View {
             .padding(10)
             
             if(settingsStore.enableAdvancedMode) {
+                if(!nearestContacts.rows.isEmpty) {
+                    NearestContactsView(rows: nearestContacts.rows)
+                }
                 MapView(
                     region: $manager.region,
-                    mapType: $settingsStore.mapTypeDisplay
+                    mapType: $settingsStore.mapTypeDisplay,
+                    contactStore: takManager.contactStore,
+                    controller: mapController
                 )
                 .ignoresSafeArea(edges: .all)
             } else {
                 Spacer()
             }
         }
+        .onChange(of: displayUIState) { units in
+            manager.displayUnits = units
+        }
     }
     var toolbarItemsLeft: some View {
         Group {
@@ -464,8 +300,4 @@ struct MainScreen: View {
         }
         .padding(.horizontal)
     }
-    
-    func broadcastLocation() {
-        takManager.broadcastLocation(locationManager: manager)
-    }
 }
@@ -32,6 +32,23 @@ struct MessageView: View {
             .frame(width: viewWidth * 0.7, alignment: message.isFromCurrentUser() ? .trailing : .leading)
             .padding(.vertical)
             
+            if message.isFromCurrentUser() && message.deliveryStatus != .incoming {
+                Text(deliveryDescription)
+                    .font(.caption2)
+                    .foregroundStyle(.secondary)
+                    .frame(width: viewWidth * 0.7, alignment: .trailing)
+            }
+        }
+    }
+    
+    var deliveryDescription: String {
+        switch message.deliveryStatus {
+        case .incoming: return ""
+        case .pending: return "Sending"
+        case .sent: return "Sent"
+        case .delivered: return "Delivered"
+        case .read: return "Read"
+        case .failed: return "Not delivered"
         }
     }
 }
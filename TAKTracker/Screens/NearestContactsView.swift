@@ -0,0 +1,39 @@
+//
+//  NearestContactsView.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import SwiftUI
+
+struct NearestContactsView: View {
+    let rows: [NearestContactRow]
+
+    func rangeText(_ range: Double) -> String {
+        if(range < 1000) {
+            return String(format: "%.0f m", range)
+        }
+        return String(format: "%.1f km", range / 1000.0)
+    }
+
+    var body: some View {
+        VStack(alignment: .leading) {
+            Text("Nearest").padding(.leading, 5)
+            ForEach(rows) { row in
+                HStack {
+                    Text(row.callsign).padding(.leading, 5)
+                    Spacer()
+                    Text(rangeText(row.range))
+                    Text(Converter.formatOrZero(item: row.bearing) + "°TN")
+                        .frame(minWidth: 70, alignment: .trailing)
+                        .padding(.trailing, 5)
+                }
+            }
+        }
+        .border(.blue)
+        .foregroundColor(.white)
+        .background(.black)
+        .padding(.horizontal, 10)
+    }
+}
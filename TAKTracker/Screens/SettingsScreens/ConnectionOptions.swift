@@ -20,6 +20,35 @@ func didDismissCertEnrollment() {
     settingsStore.takServerUsername = ""
 }
 
+// Imports the picked data packages one after another off the main thread.
+// Progress and the outcome of the last package are delivered on main.
+func importDataPackages(_ fileurls: [URL], progress: @escaping (Double) -> Void, completion: @escaping (String?) -> Void) {
+    Task {
+        var alertText: String?
+        for fileurl in fileurls {
+            if(fileurl.startAccessingSecurityScopedResource()) {
+                TAKLogger.debug("Processing Package at \(String(describing: fileurl))")
+                let tdpp = TAKDataPackageParser(
+                    fileLocation: fileurl
+                )
+                let parsingErrors = await tdpp.parse(progress: progress)
+                fileurl.stopAccessingSecurityScopedResource()
+                if(parsingErrors.isEmpty) {
+                    alertText = "Data package processed successfully!"
+                } else {
+                    alertText = "Data package could not be processed\n\n\(parsingErrors.joined(separator: "\n\n"))"
+                }
+            } else {
+                TAKLogger.error("Unable to securely access  \(String(describing: fileurl))")
+            }
+        }
+        let result = alertText
+        await MainActor.run {
+            completion(result)
+        }
+    }
+}
+
 struct DataPackageEnrollment: View {
     @Binding var isProcessingDataPackage: Bool
     @StateObject var settingsStore: SettingsStore = SettingsStore.global
@@ -27,6 +56,7 @@ struct DataPackageEnrollment: View {
     @State var isShowingFilePicker = false
     @State var isShowingAlert = false
     @State var alertText: String = ""
+    @State var importProgress = 0.0
     
     var body: some View {
         Group {
@@ -49,26 +79,14 @@ struct DataPackageEnrollment: View {
                         switch results {
                         case .success(let fileurls):
                             isProcessingDataPackage = true
-                            for fileurl in fileurls {
-                                if(fileurl.startAccessingSecurityScopedResource()) {
-                                    TAKLogger.debug("Processing Package at \(String(describing: fileurl))")
-                                    let tdpp = TAKDataPackageParser(
-                                        fileLocation: fileurl
-                                    )
-                                    tdpp.parse()
-                                    fileurl.stopAccessingSecurityScopedResource()
-                                    isProcessingDataPackage = false
-                                    if(tdpp.parsingErrors.isEmpty) {
-                                        alertText = "Data package processed successfully!"
-                                    } else {
-                                        alertText = "Data package could not be processed\n\n\(tdpp.parsingErrors.joined(separator: "\n\n"))"
-                                    }
+                            importProgress = 0.0
+                            importDataPackages(fileurls, progress: { importProgress = $0 }) { result in
+                                isProcessingDataPackage = false
+                                if let result = result {
+                                    alertText = result
                                     isShowingAlert = true
-                                } else {
-                                    TAKLogger.error("Unable to securely access  \(String(describing: fileurl))")
                                 }
                             }
-                            isProcessingDataPackage = false
                         case .failure(let error):
                             isProcessingDataPackage = false
                             TAKLogger.debug(String(describing: error))
@@ -76,6 +94,9 @@ struct DataPackageEnrollment: View {
                         
                     })
                 }
+                if(isProcessingDataPackage) {
+                    ProgressView(value: importProgress)
+                }
             }
         }
         .alert(isPresented: $isShowingAlert) {
@@ -115,6 +136,7 @@ struct ConnectionOptionsScreen: View {
     @State var isShowingFilePicker = false
     @State var isShowingAlert = false
     @State var alertText: String = ""
+    @State var importProgress = 0.0
 
     var body: some View {
         VStack {
@@ -140,26 +162,14 @@ struct ConnectionOptionsScreen: View {
                     switch results {
                     case .success(let fileurls):
                         isProcessingDataPackage = true
-                        for fileurl in fileurls {
-                            if(fileurl.startAccessingSecurityScopedResource()) {
-                                TAKLogger.debug("Processing Package at \(String(describing: fileurl))")
-                                let tdpp = TAKDataPackageParser(
-                                    fileLocation: fileurl
-                                )
-                                tdpp.parse()
-                                fileurl.stopAccessingSecurityScopedResource()
-                                isProcessingDataPackage = false
-                                if(tdpp.parsingErrors.isEmpty) {
-                                    alertText = "Data package processed successfully!"
-                                } else {
-                                    alertText = "Data package could not be processed\n\n\(tdpp.parsingErrors.joined(separator: "\n\n"))"
-                                }
+                        importProgress = 0.0
+                        importDataPackages(fileurls, progress: { importProgress = $0 }) { result in
+                            isProcessingDataPackage = false
+                            if let result = result {
+                                alertText = result
                                 isShowingAlert = true
-                            } else {
-                                TAKLogger.error("Unable to securely access  \(String(describing: fileurl))")
                             }
                         }
-                        isProcessingDataPackage = false
                     case .failure(let error):
                         isProcessingDataPackage = false
                         TAKLogger.debug(String(describing: error))
@@ -170,6 +180,10 @@ struct ConnectionOptionsScreen: View {
                 // }
             }
             .buttonStyle(.borderedProminent)
+            if(isProcessingDataPackage) {
+                ProgressView(value: importProgress)
+                    .padding()
+            }
         }
         .alert(isPresented: $isShowingAlert) {
             Alert(title: Text("Data Package"), message: Text(alertText), dismissButton: .default(Text("OK")))
@@ -194,6 +208,7 @@ struct CertEnrollmentScreen: View {
     @State var formPassword = ""
     @State var formCSRPort = ""
     @State var formSecureAPIPort = ""
+    @State var formKeyType = CertificateKeyType.rsa2048.rawValue
     
     var isAuthorized: Bool {
         get {
@@ -250,6 +265,7 @@ struct CertEnrollmentScreen: View {
         settingsStore.takServerPassword = formPassword
         settingsStore.takServerCSRPort = formCSRPort
         settingsStore.takServerSecureAPIPort = formSecureAPIPort
+        settingsStore.enrollmentKeyType = formKeyType
         csrRequest.beginEnrollment()
     }
     
@@ -335,6 +351,17 @@ struct CertEnrollmentScreen: View {
                                     .keyboardType(.numberPad)
                             }
                         }
+                        
+                        Picker("Key Type", selection: $formKeyType) {
+                            ForEach(CertificateKeyType.allCases, id: \.self) {
+                                Text($0.displayName).tag($0.rawValue)
+                            }
+                        }
+                        .pickerStyle(.menu)
+                        .foregroundColor(.secondary)
+                        .onChange(of: formKeyType) { keyType in
+                            PrivateKeyPool.global.prepare(keyType: CertificateKeyType(rawValue: keyType) ?? .rsa2048)
+                        }
                     }
                 }
                 .multilineTextAlignment(.trailing)
@@ -394,6 +421,12 @@ struct CertEnrollmentScreen: View {
             formPassword = settingsStore.takServerPassword
             formCSRPort = settingsStore.takServerCSRPort
             formSecureAPIPort = settingsStore.takServerSecureAPIPort
+            formKeyType = settingsStore.enrollmentKeyType
+            // Start on the key now so it's ready by the time the CSR is built
+            PrivateKeyPool.global.prepare(keyType: CertificateKeyType(rawValue: formKeyType) ?? .rsa2048)
+        })
+        .onDisappear(perform: {
+            csrRequest.cancelEnrollment()
         })
     }
 }
@@ -14,6 +14,7 @@ struct TAKTrackerApp: App {
     @StateObject var locationManager: LocationManager = LocationManager()
     @StateObject var takManager: TAKManager = TAKManager()
     @StateObject var settingsStore = SettingsStore.global
+    @StateObject var mapController = MapController()
     
     init() {
         TAKLogger.debug("Hello, TAK Tracker!")
@@ -39,6 +40,7 @@ struct TAKTrackerApp: App {
                     .environmentObject(locationManager)
                     .environmentObject(takManager)
                     .environmentObject(settingsStore)
+                    .environmentObject(mapController)
                     .onAppear {
                         settingsStore.isConnectingToServer = false
                         settingsStore.connectionStatus = "Disconnected"
@@ -54,6 +56,7 @@ struct TAKTrackerApp: App {
                         } else if newPhase == .active {
                             TAKLogger.debug("[ScenePhase] Moving to active")
                             settingsStore.shouldTryReconnect = true
+                            takManager.certificateRenewal.evaluate()
                         } else if newPhase == .background {
                             TAKLogger.debug("[ScenePhase] Moving to background")
                             settingsStore.shouldTryReconnect = true
@@ -0,0 +1,58 @@
+//
+//  GeoChatMessage.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+// Builds the GeoChat (b-t-f) CoT event ATAK and WinTAK expect for a
+// message to the All Chat Rooms broadcast room.
+struct GeoChatMessage {
+    static let ALL_CHAT_ROOMS = "All Chat Rooms"
+    static let STALE_SECONDS: TimeInterval = 24 * 60 * 60
+
+    private static let dateFormatter: ISO8601DateFormatter = {
+        let formatter = ISO8601DateFormatter()
+        formatter.formatOptions = [.withInternetDateTime, .withFractionalSeconds]
+        return formatter
+    }()
+
+    static func generateChatXml(message: MessageData, chatroom: String = ALL_CHAT_ROOMS) -> String {
+        let time = dateFormatter.string(from: message.dateSent)
+        let stale = dateFormatter.string(from: message.dateSent.addingTimeInterval(STALE_SECONDS))
+        let sender = escape(message.userUId)
+        let callSign = escape(message.callSign)
+        let room = escape(chatroom)
+        let messageID = escape(message.id)
+
+        return "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>"
+            + "<event version=\"2.0\" uid=\"GeoChat.\(sender).\(room).\(messageID)\" type=\"\(GeoChatParser.CHAT_TYPE)\" how=\"h-g-i-g-o\" time=\"\(time)\" start=\"\(time)\" stale=\"\(stale)\">"
+            + "<point lat=\"0.0\" lon=\"0.0\" hae=\"9999999.0\" ce=\"9999999.0\" le=\"9999999.0\"/>"
+            + "<detail>"
+            + "<__chat parent=\"RootContactGroup\" groupOwner=\"false\" messageId=\"\(messageID)\" chatroom=\"\(room)\" id=\"\(room)\" senderCallsign=\"\(callSign)\">"
+            + "<chatgrp uid0=\"\(sender)\" uid1=\"\(room)\" id=\"\(room)\"/>"
+            + "</__chat>"
+            + "<link uid=\"\(sender)\" type=\"a-f-G-U-C\" relation=\"p-p\"/>"
+            + "<remarks source=\"BAO.F.ATAK.\(sender)\" to=\"\(room)\" time=\"\(time)\">\(escape(message.message))</remarks>"
+            + "</detail>"
+            + "</event>"
+    }
+
+    static func escape(_ value: String) -> String {
+        var escaped = ""
+        escaped.reserveCapacity(value.utf8.count)
+        for character in value {
+            switch character {
+            case "&": escaped.append("&amp;")
+            case "<": escaped.append("&lt;")
+            case ">": escaped.append("&gt;")
+            case "\"": escaped.append("&quot;")
+            case "'": escaped.append("&apos;")
+            default: escaped.append(character)
+            }
+        }
+        return escaped
+    }
+}
@@ -0,0 +1,57 @@
+//
+//  LocationBroadcastPolicy.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Combine
+import Foundation
+
+// When our position goes out: once on start, every broadcast interval,
+// and straight away on a significant heading change. Time only moves when
+// advanced, so MainScreen drives it from a Timer and a replayed track can
+// drive it from a VirtualClock as fast as it likes.
+final class LocationBroadcastPolicy {
+    private(set) var interval: TimeInterval = 0
+    private(set) var broadcastCount = 0
+    var onBroadcast: ((LocationSource) -> Void)?
+
+    private weak var locationSource: LocationSource?
+    private var elapsed: TimeInterval = 0
+    private var headingCancellable: AnyCancellable?
+
+    func start(locationSource: LocationSource, interval: TimeInterval) {
+        stop()
+        self.locationSource = locationSource
+        // A zero interval would broadcast forever on every advance
+        self.interval = max(interval, 1.0)
+        elapsed = 0
+        headingCancellable = locationSource.significantHeadingChanges.sink { [weak self] _ in
+            self?.broadcast()
+        }
+        broadcast()
+    }
+
+    func stop() {
+        headingCancellable?.cancel()
+        headingCancellable = nil
+        locationSource = nil
+    }
+
+    // Broadcasts once for every interval that has passed
+    func advance(by seconds: TimeInterval) {
+        guard locationSource != nil else { return }
+        elapsed += max(seconds, 0)
+        while(elapsed >= interval) {
+            elapsed -= interval
+            broadcast()
+        }
+    }
+
+    private func broadcast() {
+        guard let locationSource = locationSource else { return }
+        broadcastCount += 1
+        onBroadcast?(locationSource)
+    }
+}
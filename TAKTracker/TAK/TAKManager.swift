@@ -15,6 +15,12 @@ class TAKManager: NSObject, URLSessionDelegate, ObservableObject {
     private let udpMessage = UDPMessage()
     private let tcpMessage: TCPMessage
     private let cotMessage: COTMessage
+    let contactStore = ContactStore()
+    let geofenceMonitor = GeofenceMonitor()
+    let chatStore: ChatStore
+    private let chatOutbox: ChatOutbox
+    let certificateRenewal = CertificateRenewalScheduler()
+    let broadcastPolicy = LocationBroadcastPolicy()
     
     @Published var isConnectedToServer = false
     
@@ -22,12 +28,54 @@ class TAKManager: NSObject, URLSessionDelegate, ObservableObject {
         cotMessage = COTMessage(staleTimeMinutes: SettingsStore.global.staleTimeMinutes, deviceID: UIDevice.current.identifierForVendor!.uuidString, phoneModel: AppConstants.getPhoneModel(), phoneOS: AppConstants.getPhoneOS(), appPlatform: AppConstants.TAK_PLATFORM, appVersion: AppConstants.getAppReleaseAndBuildVersion())
         let initialMsg = Data(cotMessage.generateCOTXml(positionInfo: COTPositionInformation(), callSign: SettingsStore.global.callSign, group: SettingsStore.global.team, role: SettingsStore.global.role).utf8)
         tcpMessage = TCPMessage(initialPayload: initialMsg)
+        let store = ChatStore()
+        chatStore = store
+        chatOutbox = ChatOutbox(chatStore: store)
         super.init()
+        tcpMessage.onEvent = { [weak self] event in
+            self?.receivedEvent(event)
+        }
+        tcpMessage.onReady = { [weak self] in
+            self?.chatOutbox.wake()
+        }
+        chatOutbox.canTransmit = {
+            SettingsStore.global.isConnectedToServer
+        }
+        chatOutbox.onTransmit = { [weak self] message in
+            TAKLogger.debug("[TAKManager]: Sending GeoChat \(message.id), attempt \(message.sendAttempts)")
+            self?.sendToTCP(message: GeoChatMessage.generateChatXml(message: message))
+        }
+        chatOutbox.start()
+        broadcastPolicy.onBroadcast = { [weak self] locationSource in
+            self?.broadcastLocation(locationManager: locationSource)
+        }
+        contactStore.startExpiring()
+        chatStore.startExpiring()
+        certificateRenewal.start()
         udpMessage.connect()
         TAKLogger.debug("[TAKManager]: establishing TCP Message Connect")
         tcpMessage.connect()
     }
     
+    private func receivedEvent(_ event: Data) {
+        if(GeoChatParser.isChat(event)) {
+            // Our own messages coming back must not reset their delivery status
+            if let message = GeoChatParser.parseMessage(data: event), !message.isFromCurrentUser() {
+                chatStore.insert(message)
+            }
+            return
+        }
+        if(GeoChatParser.isReceipt(event)) {
+            if let receipt = GeoChatParser.parseReceipt(data: event) {
+                chatStore.applyReceipt(messageID: receipt.id, status: receipt.status)
+            }
+            return
+        }
+        if let contact = COTEventParser.parseContact(data: event) {
+            contactStore.upsert(contact)
+        }
+    }
+    
     private func sendToUDP(message: String) {
         let messageContent = Data(message.utf8)
         udpMessage.send(messageContent)
@@ -38,7 +86,7 @@ class TAKManager: NSObject, URLSessionDelegate, ObservableObject {
         tcpMessage.send(messageContent)
     }
     
-    func generatePositionInfo(location: CLLocation?, heading: CLHeading? = nil) -> COTPositionInformation {
+    static func generatePositionInfo(location: CLLocation?, heading: HeadingReading? = nil) -> COTPositionInformation {
         var positionInfo = COTPositionInformation()
         
         if(location != nil) {
@@ -49,26 +97,27 @@ class TAKManager: NSObject, URLSessionDelegate, ObservableObject {
         }
         
         if(heading != nil) {
-            positionInfo.course = heading!.magneticHeading
+            // CoT course is in degrees true
+            positionInfo.course = heading!.course
         }
 
         return positionInfo
     }
     
-    func broadcastLocation(locationManager: LocationManager) {
+    func broadcastLocation(locationManager: LocationSource) {
         DispatchQueue.global(qos: .background).async {
             var location: CLLocation? = nil
-            var heading: CLHeading? = nil
+            var heading: HeadingReading? = nil
             
-            if(locationManager.lastLocation != nil) {
-                location = locationManager.lastLocation
+            if(locationManager.currentLocation != nil) {
+                location = locationManager.currentLocation
             }
             
-            if(locationManager.lastHeading != nil) {
-                heading = locationManager.lastHeading
+            if(locationManager.currentHeading != nil) {
+                heading = locationManager.currentHeading
             }
             
-            let postionInfo = self.generatePositionInfo(location: location, heading: heading)
+            let postionInfo = TAKManager.generatePositionInfo(location: location, heading: heading)
             
             let message = self.cotMessage.generateCOTXml(positionInfo: postionInfo, callSign: SettingsStore.global.callSign, group: SettingsStore.global.team, role: SettingsStore.global.role, phoneBatteryStatus: AppConstants.getPhoneBatteryStatus().description)
 
@@ -83,7 +132,7 @@ class TAKManager: NSObject, URLSessionDelegate, ObservableObject {
     func initiateEmergencyAlert(location: CLLocation?) {
         let alertType = EmergencyType(rawValue: SettingsStore.global.activeAlertType)!
         
-        let alert = cotMessage.generateEmergencyCOTXml(positionInfo: generatePositionInfo(location: location), callSign: SettingsStore.global.callSign, emergencyType: alertType, isCancelled: false)
+        let alert = cotMessage.generateEmergencyCOTXml(positionInfo: TAKManager.generatePositionInfo(location: location), callSign: SettingsStore.global.callSign, emergencyType: alertType, isCancelled: false)
 
         TAKLogger.debug("[TAKManager]: Getting ready to broadcast emergency alert CoT")
         TAKLogger.debug(alert)
@@ -92,13 +141,35 @@ class TAKManager: NSObject, URLSessionDelegate, ObservableObject {
         TAKLogger.debug("[TAKManager]: Done broadcasting emergency alert")
     }
     
+    func sendChat(_ text: String) {
+        let now = Date.now
+        let message = MessageData(
+            id: UUID().uuidString,
+            userUId: MessageData.CURRENT_USER_UID,
+            callSign: SettingsStore.global.callSign,
+            message: text,
+            createAt: now,
+            expiresAt: now.addingTimeInterval(ChatStore.RETENTION_SECONDS),
+            dateSent: now,
+            dateReceived: now,
+            deliveryStatus: .pending,
+            nextAttemptAt: now
+        )
+        chatStore.insert(message)
+
+        // The server copy goes through the outbox, which retries until a
+        // receipt comes back. Multicast has no receipts, so it's sent once.
+        sendToUDP(message: GeoChatMessage.generateChatXml(message: message))
+        chatOutbox.wake()
+    }
+    
     func cancelEmergencyAlert(location: CLLocation?) {
         SettingsStore.global.activeAlertType = ""
         SettingsStore.global.isAlertActivated = false
         
         let alertType = EmergencyType.Cancel
         
-        let alert = cotMessage.generateEmergencyCOTXml(positionInfo: generatePositionInfo(location: location), callSign: SettingsStore.global.callSign, emergencyType: alertType, isCancelled: true)
+        let alert = cotMessage.generateEmergencyCOTXml(positionInfo: TAKManager.generatePositionInfo(location: location), callSign: SettingsStore.global.callSign, emergencyType: alertType, isCancelled: true)
 
         TAKLogger.debug("[TAKManager]: Getting ready to broadcast emergency alert cancellation CoT")
         TAKLogger.debug(alert)
@@ -7,7 +7,6 @@
 
 import Foundation
 import MapKit
-import mgrs_ios
 
 enum SpeedUnit {
     case MetersPerSecond
@@ -105,12 +104,7 @@ class Converter {
     }
     
     static func LatLongToMGRS(latitude: Double, longitude: Double) -> String {
-        let mgrsPoint = MGRS.from(longitude, latitude)
-        let accuracy = 5 - Int(log10(Double(GridType.METER.precision())))
-        let easting = String(format: "%05d", mgrsPoint.easting)
-        let northing = String(format: "%05d", mgrsPoint.northing)
-
-        return "\(mgrsPoint.zone)\(mgrsPoint.band) \(mgrsPoint.column)\(mgrsPoint.row) \(String(easting.prefix(accuracy))) \(String(northing.prefix(accuracy)))"
+        return MGRSEncoder.string(latitude: latitude, longitude: longitude)
     }
     
     static func LatLonToDMS(latitude: Double) -> String {
@@ -0,0 +1,206 @@
+//
+//  GridZoneTable.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+// A grid zone: UTM zone number and latitude band
+struct GridZoneID: Equatable, Hashable {
+    var zone: Int
+    // 0 is band C, 19 is band X
+    var bandIndex: Int
+
+    var band: UInt8 {
+        GridZoneTable.BAND_LETTERS[bandIndex]
+    }
+}
+
+// The 60 zones by 20 bands of MGRS grid zones, worked out once.
+//
+// GridZones.zoneNumber and bandLetter branch through the Norway and
+// Svalbard rules on every call, and zones(bounds)/gridRange(bounds) build
+// GridZone objects out of dictionaries as they go. Every zone boundary,
+// including 3°E in band V and 9°, 21° and 33°E in band X, falls on a
+// multiple of 3° of longitude, so one byte per 3° cell per band (2,400
+// bytes) holds the zone for any coordinate, found with two divisions. The
+// west and east edge of each zone in each band is in a second table
+// built from the first, with NaN for the zones Svalbard doesn't have
+// (32X, 34X, 36X).
+//
+// The lookups give the same zone and band as GridZones, down to points
+// within about 1e-13° of the Norway and Svalbard edges, where the sums
+// GridZones does can round the other way.
+enum GridZoneTable {
+    static let ZONE_COUNT = 60
+    static let BAND_COUNT = 20
+    static let CELL_WIDTH = 3.0
+    static let CELLS_PER_BAND = 120
+    static let MIN_LATITUDE = -80.0
+    static let MAX_LATITUDE = 84.0
+    static let BAND_HEIGHT = 8.0
+    static let ZONE_WIDTH = 6.0
+
+    static let BAND_LETTERS: [UInt8] = Array("CDEFGHJKLMNPQRSTUVWX".utf8)
+    static let NORWAY_BAND_INDEX = 17
+    static let SVALBARD_BAND_INDEX = 19
+
+    // Zone number of each 3° cell, band C first, west to east
+    static let CELL_ZONES: [UInt8] = {
+        var zones = [UInt8](repeating: 0, count: BAND_COUNT * CELLS_PER_BAND)
+        for bandIndex in 0..<BAND_COUNT {
+            for cell in 0..<CELLS_PER_BAND {
+                let center = -180.0 + (Double(cell) + 0.5) * CELL_WIDTH
+                var zone = cell / 2 + 1
+                if(bandIndex == SVALBARD_BAND_INDEX && zone >= 31 && zone <= 37) {
+                    // Only the odd zones, each widened over half of its neighbours
+                    zone = Int(round(31.0 + center / ZONE_WIDTH))
+                    if(zone % 2 == 0) {
+                        zone -= 1
+                    }
+                } else if(bandIndex == NORWAY_BAND_INDEX && zone >= 31 && zone <= 32) {
+                    // 32V takes over the eastern half of 31V
+                    zone = center >= ZONE_WIDTH / 2.0 ? 32 : 31
+                }
+                zones[bandIndex * CELLS_PER_BAND + cell] = UInt8(zone)
+            }
+        }
+        return zones
+    }()
+
+    // West and east longitude of each zone in each band, zone 1 first,
+    // band C first within it
+    static let ZONE_SPANS: [(west: Double, east: Double)] = {
+        var spans = [(west: Double, east: Double)](repeating: (Double.nan, Double.nan), count: ZONE_COUNT * BAND_COUNT)
+        for bandIndex in 0..<BAND_COUNT {
+            for cell in 0..<CELLS_PER_BAND {
+                let index = spanIndex(zone: Int(CELL_ZONES[bandIndex * CELLS_PER_BAND + cell]), bandIndex: bandIndex)
+                let west = -180.0 + Double(cell) * CELL_WIDTH
+                spans[index].west = spans[index].west.isNaN ? west : min(spans[index].west, west)
+                spans[index].east = spans[index].east.isNaN ? west + CELL_WIDTH : max(spans[index].east, west + CELL_WIDTH)
+            }
+        }
+        return spans
+    }()
+
+    // Band by latitude, northern band on the edges and X running on to
+    // MAX_LATITUDE. Latitudes outside MGRS are clamped.
+    @inline(__always)
+    static func bandIndex(latitude: Double) -> Int {
+        let clamped = min(max(latitude, GridZoneTable.MIN_LATITUDE), GridZoneTable.MAX_LATITUDE)
+        return min(Int((clamped - GridZoneTable.MIN_LATITUDE) / GridZoneTable.BAND_HEIGHT), GridZoneTable.BAND_COUNT - 1)
+    }
+
+    static func bandIndex(letter: UInt8) -> Int? {
+        return GridZoneTable.BAND_LETTERS.firstIndex(of: letter)
+    }
+
+    // Eastern cell on the edges. Longitude must be within -180...180.
+    @inline(__always)
+    static func cellIndex(longitude: Double) -> Int {
+        return min(max(Int((longitude + 180.0) / GridZoneTable.CELL_WIDTH), 0), GridZoneTable.CELLS_PER_BAND - 1)
+    }
+
+    @inline(__always)
+    static func zoneNumber(latitude: Double, longitude: Double) -> Int {
+        return Int(GridZoneTable.CELL_ZONES[bandIndex(latitude: latitude) * GridZoneTable.CELLS_PER_BAND + cellIndex(longitude: longitude)])
+    }
+
+    static func gridZone(latitude: Double, longitude: Double) -> GridZoneID {
+        let band = bandIndex(latitude: latitude)
+        return GridZoneID(zone: Int(GridZoneTable.CELL_ZONES[band * GridZoneTable.CELLS_PER_BAND + cellIndex(longitude: longitude)]), bandIndex: band)
+    }
+
+    static func contains(_ gridZone: GridZoneID) -> Bool {
+        guard gridZone.zone >= 1 && gridZone.zone <= GridZoneTable.ZONE_COUNT && gridZone.bandIndex >= 0 && gridZone.bandIndex < GridZoneTable.BAND_COUNT else {
+            return false
+        }
+        return !GridZoneTable.ZONE_SPANS[spanIndex(zone: gridZone.zone, bandIndex: gridZone.bandIndex)].west.isNaN
+    }
+
+    static func bounds(of gridZone: GridZoneID) -> CoordinateBounds? {
+        guard contains(gridZone) else {
+            return nil
+        }
+        let span = GridZoneTable.ZONE_SPANS[spanIndex(zone: gridZone.zone, bandIndex: gridZone.bandIndex)]
+        return CoordinateBounds(minLatitude: southLatitude(bandIndex: gridZone.bandIndex),
+                                maxLatitude: northLatitude(bandIndex: gridZone.bandIndex),
+                                minLongitude: span.west,
+                                maxLongitude: span.east)
+    }
+
+    static func southLatitude(bandIndex: Int) -> Double {
+        return GridZoneTable.MIN_LATITUDE + Double(bandIndex) * GridZoneTable.BAND_HEIGHT
+    }
+
+    static func northLatitude(bandIndex: Int) -> Double {
+        return bandIndex == GridZoneTable.BAND_COUNT - 1 ? GridZoneTable.MAX_LATITUDE : southLatitude(bandIndex: bandIndex + 1)
+    }
+
+    // The grid zones touching the bounds
+    static func gridZones(in bounds: CoordinateBounds) -> GridZoneRange {
+        return GridZoneRange(bounds: bounds)
+    }
+
+    @inline(__always)
+    fileprivate static func spanIndex(zone: Int, bandIndex: Int) -> Int {
+        return (zone - 1) * GridZoneTable.BAND_COUNT + bandIndex
+    }
+}
+
+// Walks the grid zones touching some bounds without building anything:
+// band by band, the zones from the one west of the bounds to the one east
+// of them (the widened Norway and Svalbard zones reach one zone over),
+// keeping those whose span overlaps. Bounds crossing the antimeridian
+// wrap from zone 60 to zone 1.
+struct GridZoneRange: Sequence, IteratorProtocol {
+    let bounds: CoordinateBounds
+    let bands: ClosedRange<Int>
+    let firstZone: Int
+    let zoneCount: Int
+    private var bandIndex: Int
+    private var zoneStep = 0
+
+    init(bounds: CoordinateBounds) {
+        self.bounds = bounds
+        // One band lower too, for bounds that start on a band's northern edge
+        let southBand = max(GridZoneTable.bandIndex(latitude: bounds.minLatitude) - 1, 0)
+        bands = southBand...max(southBand, GridZoneTable.bandIndex(latitude: bounds.maxLatitude))
+        let westZone = GridZoneTable.cellIndex(longitude: bounds.minLongitude) / 2 + 1
+        let eastZone = GridZoneTable.cellIndex(longitude: bounds.maxLongitude) / 2 + 1
+        let span = bounds.crossesAntimeridian ? eastZone + GridZoneTable.ZONE_COUNT - westZone : eastZone - westZone
+        zoneCount = min(span + 3, GridZoneTable.ZONE_COUNT)
+        firstZone = zoneCount == GridZoneTable.ZONE_COUNT ? 1 : westZone - 1
+        bandIndex = bands.lowerBound
+    }
+
+    mutating func next() -> GridZoneID? {
+        while(bandIndex <= bands.upperBound) {
+            let south = GridZoneTable.southLatitude(bandIndex: bandIndex)
+            let north = GridZoneTable.northLatitude(bandIndex: bandIndex)
+            if(south <= bounds.maxLatitude && north >= bounds.minLatitude) {
+                while(zoneStep < zoneCount) {
+                    // 1-60, wrapping either way
+                    let zone = (firstZone + zoneStep - 1 + GridZoneTable.ZONE_COUNT) % GridZoneTable.ZONE_COUNT + 1
+                    zoneStep += 1
+                    if(overlaps(GridZoneTable.ZONE_SPANS[GridZoneTable.spanIndex(zone: zone, bandIndex: bandIndex)])) {
+                        return GridZoneID(zone: zone, bandIndex: bandIndex)
+                    }
+                }
+            }
+            bandIndex += 1
+            zoneStep = 0
+        }
+        return nil
+    }
+
+    // False for NaN spans, the zones that don't exist
+    private func overlaps(_ span: (west: Double, east: Double)) -> Bool {
+        if(bounds.crossesAntimeridian) {
+            return span.east >= bounds.minLongitude || span.west <= bounds.maxLongitude
+        }
+        return span.west <= bounds.maxLongitude && span.east >= bounds.minLongitude
+    }
+}
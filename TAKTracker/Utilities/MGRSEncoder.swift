@@ -0,0 +1,128 @@
+//
+//  MGRSEncoder.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+// A coordinate's MGRS reference to the meter, as plain values
+struct MGRSEncoding: Equatable {
+    var zone: Int
+    var band: UInt8
+    var column: UInt8
+    var row: UInt8
+    // Meters into the 100km square
+    var easting: Int
+    var northing: Int
+}
+
+// MGRS for the coordinate readout, without the allocations.
+//
+// MGRS.from builds a GridPoint, a UTM and an MGRS (NSDecimalNumber backed
+// objects) for every fix, and the old formatting then went through
+// String(format:) twice and sliced the result. This is the same
+// conversion on doubles: UTMProjection for the easting and northing, the
+// grid zone from GridZoneTable, and the 100km square letters read from
+// MGRS' column/row letter sets. The text is written as ASCII into a
+// buffer the caller owns.
+//
+// Zones and letters match Converter.LatLongToMGRS as it was with
+// MGRS.from and GridType.METER precision, Norway and Svalbard zones
+// included, apart from the sub-nanometer slivers along the Norway and
+// Svalbard edges noted on GridZoneTable. The older UTM formula there is
+// off by a few centimeters, so where that straddles a meter the last
+// digit can differ by one (see MGRSEncoderTests).
+enum MGRSEncoder {
+    // "18S UJ 26938 05973"
+    static let MAX_LENGTH = 18
+    static let DIGITS = 5
+    static let MIN_LATITUDE = -80.0
+    static let MAX_LATITUDE = 84.0
+    static let SQUARE_SIZE = 100000.0
+
+    // Zones 1, 4, 7... use A-H, 2, 5, 8... J-R and 3, 6, 9... S-Z
+    static let COLUMN_LETTERS: [UInt8] = Array("ABCDEFGHJKLMNPQRSTUVWXYZ".utf8)
+    // Odd zones start at A, even zones at F
+    static let ROW_LETTERS: [UInt8] = Array("ABCDEFGHJKLMNPQRSTUV".utf8)
+    static let EVEN_ZONE_ROW_OFFSET = 5
+
+    private static let SPACE = UInt8(ascii: " ")
+    private static let ZERO = UInt8(ascii: "0")
+
+    static func encode(latitude: Double, longitude: Double) -> MGRSEncoding {
+        let latitude = min(max(latitude, MGRSEncoder.MIN_LATITUDE), MGRSEncoder.MAX_LATITUDE)
+        var longitude = longitude
+        if(longitude < -180.0) {
+            longitude += 360.0
+        } else if(longitude > 180.0) {
+            longitude -= 360.0
+        }
+
+        let gridZone = GridZoneTable.gridZone(latitude: latitude, longitude: longitude)
+        let zone = gridZone.zone
+        let utm = UTMProjection.forward(latitude: latitude, longitude: longitude, zone: zone)
+
+        let column = Int(floor(utm.easting / MGRSEncoder.SQUARE_SIZE)) - 1
+        let row = Int(floor(utm.northing / MGRSEncoder.SQUARE_SIZE)) % 20
+        let columnSet = (zone - 1) % 3
+        let rowOffset = (zone - 1) % 2 == 0 ? 0 : MGRSEncoder.EVEN_ZONE_ROW_OFFSET
+
+        return MGRSEncoding(
+            zone: zone,
+            band: gridZone.band,
+            column: MGRSEncoder.COLUMN_LETTERS[columnSet * 8 + min(max(column, 0), 7)],
+            row: MGRSEncoder.ROW_LETTERS[(row + rowOffset) % 20],
+            easting: Int(utm.easting.truncatingRemainder(dividingBy: MGRSEncoder.SQUARE_SIZE)),
+            northing: Int(utm.northing.truncatingRemainder(dividingBy: MGRSEncoder.SQUARE_SIZE))
+        )
+    }
+
+    // Writes the reference as ASCII and returns how many bytes were used.
+    // The buffer needs room for MAX_LENGTH.
+    @discardableResult
+    static func write(_ mgrs: MGRSEncoding, into buffer: UnsafeMutableBufferPointer<UInt8>) -> Int {
+        precondition(buffer.count >= MGRSEncoder.MAX_LENGTH, "MGRS buffer too small")
+        var length = 0
+        if(mgrs.zone >= 10) {
+            buffer[length] = MGRSEncoder.ZERO + UInt8(mgrs.zone / 10)
+            length += 1
+        }
+        buffer[length] = MGRSEncoder.ZERO + UInt8(mgrs.zone % 10)
+        buffer[length + 1] = mgrs.band
+        buffer[length + 2] = MGRSEncoder.SPACE
+        buffer[length + 3] = mgrs.column
+        buffer[length + 4] = mgrs.row
+        buffer[length + 5] = MGRSEncoder.SPACE
+        length += 6
+        length = writeDigits(mgrs.easting, into: buffer, at: length)
+        buffer[length] = MGRSEncoder.SPACE
+        length = writeDigits(mgrs.northing, into: buffer, at: length + 1)
+        return length
+    }
+
+    @discardableResult
+    static func write(latitude: Double, longitude: Double, into buffer: UnsafeMutableBufferPointer<UInt8>) -> Int {
+        return write(encode(latitude: latitude, longitude: longitude), into: buffer)
+    }
+
+    static func string(latitude: Double, longitude: Double) -> String {
+        let mgrs = encode(latitude: latitude, longitude: longitude)
+        return String(unsafeUninitializedCapacity: MGRSEncoder.MAX_LENGTH) { buffer in
+            write(mgrs, into: buffer)
+        }
+    }
+
+    // Zero padded, DIGITS wide
+    private static func writeDigits(_ value: Int, into buffer: UnsafeMutableBufferPointer<UInt8>, at start: Int) -> Int {
+        var remaining = value
+        var index = start + MGRSEncoder.DIGITS - 1
+        while(index >= start) {
+            buffer[index] = MGRSEncoder.ZERO + UInt8(remaining % 10)
+            remaining /= 10
+            index -= 1
+        }
+        return start + MGRSEncoder.DIGITS
+    }
+}
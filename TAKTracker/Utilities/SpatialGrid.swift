@@ -0,0 +1,224 @@
+//
+//  SpatialGrid.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import MapKit
+
+// Latitude/longitude box. When minLongitude is greater than maxLongitude
+// the box crosses the antimeridian.
+struct CoordinateBounds: Equatable {
+    var minLatitude: Double
+    var maxLatitude: Double
+    var minLongitude: Double
+    var maxLongitude: Double
+
+    init(minLatitude: Double, maxLatitude: Double, minLongitude: Double, maxLongitude: Double) {
+        self.minLatitude = minLatitude
+        self.maxLatitude = maxLatitude
+        self.minLongitude = minLongitude
+        self.maxLongitude = maxLongitude
+    }
+
+    init(region: MKCoordinateRegion) {
+        let halfLatitude = region.span.latitudeDelta / 2.0
+        let halfLongitude = min(region.span.longitudeDelta / 2.0, 180.0)
+        minLatitude = max(region.center.latitude - halfLatitude, -90.0)
+        maxLatitude = min(region.center.latitude + halfLatitude, 90.0)
+        if(halfLongitude >= 180.0) {
+            minLongitude = -180.0
+            maxLongitude = 180.0
+        } else {
+            minLongitude = CoordinateBounds.wrap(longitude: region.center.longitude - halfLongitude)
+            maxLongitude = CoordinateBounds.wrap(longitude: region.center.longitude + halfLongitude)
+        }
+    }
+
+    var crossesAntimeridian: Bool {
+        minLongitude > maxLongitude
+    }
+
+    func contains(latitude: Double, longitude: Double) -> Bool {
+        guard latitude >= minLatitude && latitude <= maxLatitude else { return false }
+        if(crossesAntimeridian) {
+            return longitude >= minLongitude || longitude <= maxLongitude
+        }
+        return longitude >= minLongitude && longitude <= maxLongitude
+    }
+
+    static func wrap(longitude: Double) -> Double {
+        var wrapped = (longitude + 180.0).truncatingRemainder(dividingBy: 360.0)
+        if(wrapped < 0) {
+            wrapped += 360.0
+        }
+        return wrapped - 180.0
+    }
+}
+
+// Uniform grid of lat/lon cells over items identified by small integer
+// ids (their index in the owner's storage). Each item remembers its cell
+// and its slot within that cell, so moves and removals are O(1) and a
+// move within the same cell only rewrites the coordinate.
+//
+// A viewport query visits only the cells it covers, or every occupied
+// cell when that is fewer (zoomed far out).
+//
+// Not thread safe. Owners serialize access.
+struct SpatialGrid {
+    // About 5.5km north-south
+    static let DEFAULT_CELL_SIZE = 0.05
+
+    let cellSize: Double
+    private let columns: Int64
+    private let rows: Int64
+
+    private var cells: [Int64: [Int]] = [:]
+    private var itemCell: [Int64] = []
+    private var itemSlot: [Int] = []
+    private var itemLatitude: [Double] = []
+    private var itemLongitude: [Double] = []
+
+    init(cellSize: Double = SpatialGrid.DEFAULT_CELL_SIZE) {
+        self.cellSize = cellSize
+        self.columns = Int64((360.0 / cellSize).rounded(.up))
+        self.rows = Int64((180.0 / cellSize).rounded(.up))
+    }
+
+    var count: Int {
+        itemCell.count
+    }
+
+    var occupiedCellCount: Int {
+        cells.count
+    }
+
+    // Ids must be added in order: the new id is always the current count
+    mutating func append(latitude: Double, longitude: Double) -> Int {
+        let id = itemCell.count
+        let cell = cellKey(latitude: latitude, longitude: longitude)
+        itemCell.append(cell)
+        itemSlot.append(cells[cell, default: []].count)
+        itemLatitude.append(latitude)
+        itemLongitude.append(longitude)
+        cells[cell, default: []].append(id)
+        return id
+    }
+
+    mutating func move(_ id: Int, latitude: Double, longitude: Double) {
+        itemLatitude[id] = latitude
+        itemLongitude[id] = longitude
+        let cell = cellKey(latitude: latitude, longitude: longitude)
+        if(cell == itemCell[id]) {
+            return
+        }
+        detach(id)
+        itemCell[id] = cell
+        itemSlot[id] = cells[cell, default: []].count
+        cells[cell, default: []].append(id)
+    }
+
+    // Removes an item by moving the last id into its place, matching a
+    // swap-remove in the owner's storage
+    mutating func swapRemove(_ id: Int) {
+        detach(id)
+        let last = itemCell.count - 1
+        if(id != last) {
+            itemCell[id] = itemCell[last]
+            itemSlot[id] = itemSlot[last]
+            itemLatitude[id] = itemLatitude[last]
+            itemLongitude[id] = itemLongitude[last]
+            cells[itemCell[id]]![itemSlot[id]] = id
+        }
+        itemCell.removeLast()
+        itemSlot.removeLast()
+        itemLatitude.removeLast()
+        itemLongitude.removeLast()
+    }
+
+    mutating func removeAll() {
+        cells.removeAll()
+        itemCell.removeAll()
+        itemSlot.removeAll()
+        itemLatitude.removeAll()
+        itemLongitude.removeAll()
+    }
+
+    func query(_ bounds: CoordinateBounds) -> [Int] {
+        var results: [Int] = []
+        if(bounds.crossesAntimeridian) {
+            collect(in: bounds, minLongitude: bounds.minLongitude, maxLongitude: 180.0, into: &results)
+            collect(in: bounds, minLongitude: -180.0, maxLongitude: bounds.maxLongitude, into: &results)
+        } else {
+            collect(in: bounds, minLongitude: bounds.minLongitude, maxLongitude: bounds.maxLongitude, into: &results)
+        }
+        return results
+    }
+
+    private func collect(in bounds: CoordinateBounds, minLongitude: Double, maxLongitude: Double, into results: inout [Int]) {
+        let minColumn = column(longitude: minLongitude)
+        let maxColumn = column(longitude: maxLongitude)
+        let minRow = row(latitude: bounds.minLatitude)
+        let maxRow = row(latitude: bounds.maxLatitude)
+        guard minColumn <= maxColumn, minRow <= maxRow else { return }
+
+        let coveredCells = (maxColumn - minColumn + 1) * (maxRow - minRow + 1)
+        if(coveredCells > Int64(cells.count)) {
+            for (key, ids) in cells {
+                let cellRow = key / columns
+                let cellColumn = key % columns
+                if(cellRow >= minRow && cellRow <= maxRow && cellColumn >= minColumn && cellColumn <= maxColumn) {
+                    append(ids, in: bounds, into: &results)
+                }
+            }
+            return
+        }
+
+        for cellRow in minRow...maxRow {
+            for cellColumn in minColumn...maxColumn {
+                if let ids = cells[cellRow * columns + cellColumn] {
+                    append(ids, in: bounds, into: &results)
+                }
+            }
+        }
+    }
+
+    private func append(_ ids: [Int], in bounds: CoordinateBounds, into results: inout [Int]) {
+        for id in ids where bounds.contains(latitude: itemLatitude[id], longitude: itemLongitude[id]) {
+            results.append(id)
+        }
+    }
+
+    private mutating func detach(_ id: Int) {
+        let cell = itemCell[id]
+        let slot = itemSlot[id]
+        var ids = cells.removeValue(forKey: cell)!
+        let moved = ids.removeLast()
+        if(moved != id) {
+            ids[slot] = moved
+            itemSlot[moved] = slot
+        }
+        if(!ids.isEmpty) {
+            cells[cell] = ids
+        }
+    }
+
+    private func column(longitude: Double) -> Int64 {
+        let value = Int64(floor((CoordinateBounds.wrap(longitude: longitude) + 180.0) / cellSize))
+        // +180 wraps to -180, but as a query edge it means the last column
+        if(longitude >= 180.0) {
+            return columns - 1
+        }
+        return min(max(value, 0), columns - 1)
+    }
+
+    private func row(latitude: Double) -> Int64 {
+        return min(max(Int64(floor((latitude + 90.0) / cellSize)), 0), rows - 1)
+    }
+
+    private func cellKey(latitude: Double, longitude: Double) -> Int64 {
+        return row(latitude: latitude) * columns + column(longitude: longitude)
+    }
+}
@@ -0,0 +1,159 @@
+//
+//  TimingWheel.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+// Hierarchical timing wheel. Each level has 64 slots; a slot on level n
+// spans 64^n ticks. Scheduling and expiring are O(1) per entry (plus
+// at most one cascade per level), so a large number of deadlines can be
+// tracked without ever scanning all of them.
+//
+// Entries can't be cancelled. Callers that reschedule a key should check
+// whether an expired entry is still current (lazy invalidation).
+//
+// Not thread safe. Owners serialize access.
+struct TimingWheel<Key> {
+    struct Entry {
+        var key: Key
+        var deadline: Date
+        fileprivate var tick: Int64
+    }
+
+    // Generic types can't have stored statics
+    static var SLOT_BITS: Int64 { 6 }
+    static var SLOTS_PER_LEVEL: Int { 64 }
+    static var LEVELS: Int { 4 }
+
+    let resolution: TimeInterval
+    private(set) var count = 0
+    private(set) var currentTick: Int64
+
+    private var levels: [[[Entry]]]
+    private var levelCounts: [Int]
+    private var due: [Entry] = []
+
+    // With 1 second ticks four levels cover about 194 days. Anything later
+    // sits in the top level and is cascaded back in as time moves.
+    init(start: Date = Date(), resolution: TimeInterval = 1.0) {
+        self.resolution = resolution
+        self.currentTick = Int64(floor(start.timeIntervalSince1970 / resolution))
+        self.levels = Array(
+            repeating: Array(repeating: [], count: TimingWheel.SLOTS_PER_LEVEL),
+            count: TimingWheel.LEVELS
+        )
+        self.levelCounts = Array(repeating: 0, count: TimingWheel.LEVELS)
+    }
+
+    var isEmpty: Bool {
+        count == 0
+    }
+
+    var currentTime: Date {
+        Date(timeIntervalSince1970: Double(currentTick) * resolution)
+    }
+
+    mutating func schedule(_ key: Key, at deadline: Date) {
+        let tick = Int64((deadline.timeIntervalSince1970 / resolution).rounded(.up))
+        insert(Entry(key: key, deadline: deadline, tick: tick))
+        count += 1
+    }
+
+    // Moves the wheel forward to the given time and returns every entry
+    // whose deadline has passed, in tick order
+    mutating func advance(to time: Date) -> [Entry] {
+        let targetTick = Int64(floor(time.timeIntervalSince1970 / resolution))
+        var expired = due
+        due.removeAll()
+
+        while(currentTick < targetTick) {
+            if(count == expired.count) {
+                // Nothing left in the wheel, so there is nothing to step through
+                currentTick = targetTick
+                break
+            }
+            if(levelCounts[0] == 0) {
+                // Only upper levels hold entries, so jump to the next cascade
+                let boundary = currentTick | Int64(TimingWheel.SLOTS_PER_LEVEL - 1)
+                if(boundary > currentTick) {
+                    currentTick = min(boundary, targetTick)
+                    continue
+                }
+            }
+            currentTick += 1
+            cascade()
+
+            let slot = Int(currentTick & Int64(TimingWheel.SLOTS_PER_LEVEL - 1))
+            if(!levels[0][slot].isEmpty) {
+                expired.append(contentsOf: levels[0][slot])
+                levelCounts[0] -= levels[0][slot].count
+                levels[0][slot].removeAll(keepingCapacity: true)
+            }
+            // Cascading can land entries exactly on the current tick
+            if(!due.isEmpty) {
+                expired.append(contentsOf: due)
+                due.removeAll()
+            }
+        }
+
+        count -= expired.count
+        return expired
+    }
+
+    mutating func removeAll() {
+        for level in 0..<levels.count {
+            for slot in 0..<levels[level].count {
+                levels[level][slot].removeAll()
+            }
+            levelCounts[level] = 0
+        }
+        due.removeAll()
+        count = 0
+    }
+
+    private mutating func insert(_ entry: Entry) {
+        let delta = entry.tick - currentTick
+        if(delta <= 0) {
+            due.append(entry)
+            return
+        }
+
+        var level = 0
+        var span = Int64(TimingWheel.SLOTS_PER_LEVEL)
+        while(delta >= span && level < TimingWheel.LEVELS - 1) {
+            level += 1
+            span <<= TimingWheel.SLOT_BITS
+        }
+
+        // Past the top level's range, park it in the furthest top slot
+        let tick = delta >= span ? currentTick + span - 1 : entry.tick
+        let slot = Int((tick >> (TimingWheel.SLOT_BITS * Int64(level))) & Int64(TimingWheel.SLOTS_PER_LEVEL - 1))
+        levels[level][slot].append(entry)
+        levelCounts[level] += 1
+    }
+
+    // When a level wraps, the matching slot of the level above is spread
+    // back down over the lower levels
+    private mutating func cascade() {
+        let mask = Int64(TimingWheel.SLOTS_PER_LEVEL - 1)
+        for level in 1..<TimingWheel.LEVELS {
+            let shift = TimingWheel.SLOT_BITS * Int64(level)
+            if((currentTick & ((Int64(1) << shift) - 1)) != 0) {
+                return
+            }
+            let slot = Int((currentTick >> shift) & mask)
+            let entries = levels[level][slot]
+            if(entries.isEmpty) {
+                continue
+            }
+            levels[level][slot].removeAll(keepingCapacity: true)
+            levelCounts[level] -= entries.count
+            for entry in entries {
+                insert(entry)
+            }
+        }
+    }
+}
@@ -0,0 +1,152 @@
+//
+//  ChatTimelineWindow.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+// The slice of chat history ChatView has loaded.
+//
+// History is read from ChatStore a page at a time: the newest page first,
+// older pages as the user scrolls up, and newer pages again on the way
+// back down. The window never holds more than maxPages pages, dropping
+// the end furthest from the one being loaded, so a 50k message history
+// costs the same to keep and lay out as a short one.
+//
+// Messages are kept in (createdAt, id) order, the same order ChatStore
+// pages in. Live writes only apply while the window reaches the newest
+// message; otherwise they're picked up by paging down.
+struct ChatTimelineWindow {
+    static let MAX_PAGES = 4
+
+    let pageSize: Int
+    let maxMessages: Int
+
+    private(set) var messages: [MessageData] = []
+    // The store has messages before the first one here
+    private(set) var hasOlder = false
+    // The last message here is the newest in the store
+    private(set) var isAtLatest = true
+    private var ids = Set<String>()
+
+    init(pageSize: Int = ChatStore.DEFAULT_PAGE_SIZE, maxPages: Int = ChatTimelineWindow.MAX_PAGES) {
+        self.pageSize = pageSize
+        self.maxMessages = pageSize * max(2, maxPages)
+    }
+
+    var oldest: MessageData? {
+        messages.first
+    }
+
+    var newest: MessageData? {
+        messages.last
+    }
+
+    // Starts over from the newest page
+    mutating func reset(latest page: [MessageData]) {
+        messages = page
+        ids = Set(page.map { $0.id })
+        hasOlder = page.count >= pageSize
+        isAtLatest = true
+    }
+
+    // A page from ChatStore.messages(olderThan: oldest)
+    mutating func prependOlder(_ page: [MessageData]) {
+        hasOlder = page.count >= pageSize
+        let older = page.filter { !ids.contains($0.id) }
+        if(older.isEmpty) {
+            return
+        }
+        messages.insert(contentsOf: older, at: 0)
+        ids.formUnion(older.map { $0.id })
+
+        let excess = messages.count - maxMessages
+        if(excess > 0) {
+            for message in messages.suffix(excess) {
+                ids.remove(message.id)
+            }
+            messages.removeLast(excess)
+            isAtLatest = false
+        }
+    }
+
+    // A page from ChatStore.messages(newerThan: newest)
+    mutating func appendNewer(_ page: [MessageData]) {
+        if(page.count < pageSize) {
+            isAtLatest = true
+        }
+        let newer = page.filter { !ids.contains($0.id) }
+        if(newer.isEmpty) {
+            return
+        }
+        messages.append(contentsOf: newer)
+        ids.formUnion(newer.map { $0.id })
+        trimOldest()
+    }
+
+    // Messages just written to ChatStore. Returns whether anything changed.
+    @discardableResult
+    mutating func insertLive(_ inserted: [MessageData]) -> Bool {
+        guard isAtLatest else { return false }
+        var changed = false
+        for message in inserted where !ids.contains(message.id) {
+            if let last = messages.last, ChatTimelineWindow.isOrdered(message, before: last) {
+                // Arrived out of order: slot it in if it belongs in the window
+                if(hasOlder && ChatTimelineWindow.isOrdered(message, before: messages[0])) {
+                    continue
+                }
+                messages.insert(message, at: insertionIndex(for: message))
+            } else {
+                messages.append(message)
+            }
+            ids.insert(message.id)
+            changed = true
+        }
+        if(changed) {
+            trimOldest()
+        }
+        return changed
+    }
+
+    // Returns whether the message is in the window
+    @discardableResult
+    mutating func updateDeliveryStatus(id: String, to status: ChatDeliveryStatus) -> Bool {
+        guard ids.contains(id), let index = messages.lastIndex(where: { $0.id == id }) else { return false }
+        messages[index].deliveryStatus = status
+        return true
+    }
+
+    static func isOrdered(_ message: MessageData, before other: MessageData) -> Bool {
+        if(message.createAt != other.createAt) {
+            return message.createAt < other.createAt
+        }
+        return message.id < other.id
+    }
+
+    private mutating func trimOldest() {
+        let excess = messages.count - maxMessages
+        if(excess > 0) {
+            for message in messages.prefix(excess) {
+                ids.remove(message.id)
+            }
+            messages.removeFirst(excess)
+            hasOlder = true
+        }
+    }
+
+    private func insertionIndex(for message: MessageData) -> Int {
+        var low = 0
+        var high = messages.count
+        while(low < high) {
+            let middle = (low + high) / 2
+            if(ChatTimelineWindow.isOrdered(messages[middle], before: message)) {
+                low = middle + 1
+            } else {
+                high = middle
+            }
+        }
+        return low
+    }
+}
@@ -5,25 +5,91 @@
 //  Created by Craig Clayton on 1/4/24.
 //
 
+import Combine
 import Foundation
 
 class ChatViewModel: ObservableObject {
-    @Published var messages: [MessageData] = []
-    
+    @Published private(set) var messages: [MessageData] = []
+    @Published private(set) var hasOlder = false
+    @Published private(set) var isAtLatest = true
+
+    private weak var takManager: TAKManager?
+    private var window = ChatTimelineWindow()
+    private var insertedCancellable: AnyCancellable?
+    private var deliveryCancellable: AnyCancellable?
+    private var isLoading = false
+
     init(messages: [MessageData] = []) {
-        self.messages = ChatViewModel.data
+        window.reset(latest: messages)
+        publish()
+    }
+
+    // Loads the latest page from the chat store, then follows new messages
+    func start(takManager: TAKManager) {
+        guard self.takManager == nil else { return }
+        self.takManager = takManager
+
+        insertedCancellable = takManager.chatStore.inserted.sink { [weak self] inserted in
+            guard let self = self else { return }
+            if(self.window.insertLive(inserted)) {
+                self.publish()
+            }
+        }
+        deliveryCancellable = takManager.chatStore.deliveryChanged.sink { [weak self] update in
+            guard let self = self else { return }
+            if(self.window.updateDeliveryStatus(id: update.id, to: update.status)) {
+                self.publish()
+            }
+        }
+        jumpToLatest()
+    }
+
+    func jumpToLatest() {
+        guard let chatStore = takManager?.chatStore, !isLoading else { return }
+        isLoading = true
+        chatStore.loadMessages(limit: window.pageSize) { [weak self] page in
+            guard let self = self else { return }
+            self.isLoading = false
+            self.window.reset(latest: page)
+            self.publish()
+        }
     }
-    
-    static let data = [
-        MessageData.defaultOutgoingMessage1,
-        MessageData.defaultIncomingMessage1,
-        MessageData.defaultIncomingMessage2,
-        MessageData.defaultOutgoingMessage2,
-        MessageData.defaultOutgoingMessage3,
-        MessageData.defaultIncomingMessage3
-    ]
-    
+
+    // Called as the first loaded message scrolls into view
+    func loadOlder() {
+        guard let chatStore = takManager?.chatStore, !isLoading, window.hasOlder, let oldest = window.oldest else { return }
+        isLoading = true
+        chatStore.loadMessages(olderThan: oldest, limit: window.pageSize) { [weak self] page in
+            guard let self = self else { return }
+            self.isLoading = false
+            self.window.prependOlder(page)
+            self.publish()
+        }
+    }
+
+    // Called as the last loaded message scrolls into view
+    func loadNewer() {
+        guard let chatStore = takManager?.chatStore, !isLoading, !window.isAtLatest, let newest = window.newest else { return }
+        isLoading = true
+        chatStore.loadMessages(newerThan: newest, limit: window.pageSize) { [weak self] page in
+            guard let self = self else { return }
+            self.isLoading = false
+            self.window.appendNewer(page)
+            self.publish()
+        }
+    }
+
     func send(_ message: String) {
-        print(message)
+        takManager?.sendChat(message)
+        // Our own message should come into view
+        if(!window.isAtLatest) {
+            jumpToLatest()
+        }
+    }
+
+    private func publish() {
+        messages = window.messages
+        hasOlder = window.hasOlder
+        isAtLatest = window.isAtLatest
     }
 }
@@ -0,0 +1,95 @@
+//
+//  NearestContactsViewModel.swift
+//  TAKTracker
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Combine
+import Foundation
+
+struct NearestContactRow: Identifiable, Equatable {
+    var id: String
+    var callsign: String
+    // Meters
+    var range: Double
+    // Degrees true
+    var bearing: Double
+}
+
+// Live "nearest friendlies" list. Own fixes and contact store changes
+// are fed into a NearestContactsTracker on a background queue, so a new
+// fix only re-measures the few contacts that could be among the nearest.
+class NearestContactsViewModel: ObservableObject {
+    static let DEFAULT_COUNT = 5
+    static let STORE_POLL_SECONDS = 1.0
+    static let FRIENDLY_TYPE_PREFIX = "a-f"
+
+    @Published private(set) var rows: [NearestContactRow] = []
+
+    private let queue = DispatchQueue(label: "com.flighttactics.TAKTracker.NearestContacts", qos: .utility)
+    private var tracker: NearestContactsTracker
+    private var callsigns: [String: String] = [:]
+    private var lastStoreVersion = -1
+    private var contactStore: ContactStore?
+    private var cancellables = Set<AnyCancellable>()
+
+    init(count: Int = NearestContactsViewModel.DEFAULT_COUNT) {
+        tracker = NearestContactsTracker(k: count)
+    }
+
+    func start(contactStore: ContactStore, locationSource: LocationSource) {
+        if(self.contactStore === contactStore) {
+            return
+        }
+        self.contactStore = contactStore
+        cancellables.removeAll()
+
+        locationSource.locationUpdates
+            .receive(on: queue)
+            .sink { [weak self] location in
+                self?.tracker.updateSelf(latitude: location.coordinate.latitude, longitude: location.coordinate.longitude)
+                self?.publish()
+            }
+            .store(in: &cancellables)
+
+        Timer.publish(every: NearestContactsViewModel.STORE_POLL_SECONDS, on: .main, in: .common)
+            .autoconnect()
+            .receive(on: queue)
+            .sink { [weak self] _ in
+                self?.syncContacts()
+                self?.publish()
+            }
+            .store(in: &cancellables)
+    }
+
+    private func syncContacts() {
+        guard let store = contactStore else { return }
+        let snapshot = store.snapshot()
+        if(snapshot.version == lastStoreVersion) {
+            return
+        }
+        lastStoreVersion = snapshot.version
+
+        var current: [String: String] = [:]
+        for contact in snapshot.contacts where contact.type.hasPrefix(NearestContactsViewModel.FRIENDLY_TYPE_PREFIX) {
+            current[contact.uid] = contact.callsign
+            tracker.upsertContact(uid: contact.uid, latitude: contact.latitude, longitude: contact.longitude)
+        }
+        for uid in callsigns.keys where current[uid] == nil {
+            tracker.removeContact(uid: uid)
+        }
+        callsigns = current
+    }
+
+    private func publish() {
+        let newRows = tracker.nearest().map {
+            NearestContactRow(id: $0.uid, callsign: callsigns[$0.uid] ?? $0.uid, range: $0.range, bearing: $0.bearing)
+        }
+        DispatchQueue.main.async {
+            if(self.rows != newRows) {
+                self.rows = newRows
+            }
+        }
+    }
+}
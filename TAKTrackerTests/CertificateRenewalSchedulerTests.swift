@@ -0,0 +1,173 @@
+//
+//  CertificateRenewalSchedulerTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import XCTest
+
+final class CertificateRenewalSchedulerTests: TAKTrackerTestCase {
+    let hostName = "tak.example.com"
+    let configPath = TAKConstants.CERT_CONFIG_PATH
+    let signPath = "/Marti/api/tls/signClient/v2"
+    let caConfig = """
+    <certificateConfig validityDays="30">
+      <nameEntries>
+        <nameEntry name="O" value="FLIGHTTACTICS"/>
+        <nameEntry name="OU" value="TAK"/>
+      </nameEntries>
+    </certificateConfig>
+    """
+
+    var client: EnrollmentHTTPClient!
+    var certificateAuthority: MockCertificateAuthority!
+
+    override func setUpWithError() throws {
+        MockTAKServer.reset()
+        client = EnrollmentHTTPClient(configuration: MockTAKServer.configuration(), retryBaseDelay: 0.01)
+        certificateAuthority = try MockCertificateAuthority(lifetime: 120)
+        let authority = certificateAuthority!
+        MockTAKServer.reply(to: configPath, with: MockTAKServer.text(caConfig))
+        MockTAKServer.reply(to: signPath, with: .respond({ authority.reply(to: $0) }))
+
+        SettingsStore.global.takServerUrl = hostName
+        SettingsStore.global.takServerUsername = "foyc"
+        SettingsStore.global.takServerPassword = "atakatak"
+        SettingsStore.global.enrollmentKeyType = CertificateKeyType.ecdsaP256.rawValue
+        SettingsStore.global.takServerChanged = false
+    }
+
+    override func tearDownWithError() throws {
+        MockTAKServer.reset()
+        SettingsStore.global.takServerUrl = ""
+        SettingsStore.global.takServerUsername = ""
+        SettingsStore.global.takServerPassword = ""
+        SettingsStore.global.enrollmentKeyType = CertificateKeyType.rsa2048.rawValue
+        SettingsStore.global.takServerChanged = false
+        for secItemClass in [kSecClassCertificate, kSecClassKey, kSecClassIdentity] {
+            let dictionary = [kSecClass as String: secItemClass]
+            SecItemDelete(dictionary as CFDictionary)
+        }
+    }
+
+    func makeRequestor() -> CSRRequestor {
+        let requestor = CSRRequestor()
+        requestor.httpClient = client
+        return requestor
+    }
+
+    func enroll() {
+        let requestor = makeRequestor()
+        requestor.beginEnrollment()
+        let enrolled = expectation(for: NSPredicate { _, _ in requestor.enrollmentStatus == .Succeeded }, evaluatedWith: nil)
+        wait(for: [enrolled], timeout: 10.0)
+        SettingsStore.global.takServerChanged = false
+    }
+
+    func privateKeyCount() -> Int {
+        let query: [NSString: Any] = [
+            kSecClass: kSecClassKey,
+            kSecAttrApplicationTag: "tak.flighttactics.com-\(hostName)-pk".data(using: .utf8)!,
+            kSecMatchLimit: kSecMatchLimitAll,
+            kSecReturnRef: true ]
+        var resultRef: AnyObject?
+        guard SecItemCopyMatching(query as CFDictionary, &resultRef) == errSecSuccess else { return 0 }
+        return (resultRef as? [AnyObject])?.count ?? 0
+    }
+
+    func testWaitsUntilWindowThenPreparesKey() {
+        var clock = Date()
+        let expiry = clock.addingTimeInterval(10 * CertificateRenewalScheduler.SECONDS_PER_DAY)
+        let window = 7 * CertificateRenewalScheduler.SECONDS_PER_DAY
+        let scheduler = CertificateRenewalScheduler(renewalWindow: window, expiryProvider: { expiry }, makeRequestor: makeRequestor, now: { clock })
+        let renewAt = expiry.addingTimeInterval(-window)
+
+        scheduler.start()
+        XCTAssertFalse(scheduler.isRenewing)
+        XCTAssertEqual(renewAt.addingTimeInterval(-CertificateRenewalScheduler.KEY_PREPARE_LEAD), scheduler.nextCheckDate)
+
+        clock = renewAt.addingTimeInterval(-60)
+        scheduler.evaluate()
+        XCTAssertFalse(scheduler.isRenewing)
+        XCTAssertEqual(renewAt, scheduler.nextCheckDate)
+        XCTAssertTrue(PrivateKeyPool.global.hasPreparedKey(keyType: .ecdsaP256))
+        XCTAssertTrue(MockTAKServer.requests.isEmpty)
+        scheduler.stop()
+    }
+
+    func testNothingToDoWithoutIdentity() {
+        let scheduler = CertificateRenewalScheduler(renewalWindow: 60, expiryProvider: { nil }, makeRequestor: makeRequestor)
+
+        scheduler.start()
+
+        XCTAssertNil(scheduler.nextCheckDate)
+        XCTAssertFalse(scheduler.isRenewing)
+    }
+
+    func testSkipsRenewalWithoutEnrollmentCredentials() {
+        SettingsStore.global.takServerUsername = ""
+        let scheduler = CertificateRenewalScheduler(renewalWindow: 60, expiryProvider: { Date().addingTimeInterval(30) }, makeRequestor: makeRequestor)
+
+        scheduler.start()
+
+        XCTAssertFalse(scheduler.isRenewing)
+        XCTAssertTrue(MockTAKServer.requests.isEmpty)
+    }
+
+    func testRenewsShortLivedCertificateInPlace() throws {
+        enroll()
+        let firstExpiry = try XCTUnwrap(CertificateRenewalScheduler.identityExpiry(label: hostName))
+        XCTAssertLessThan(firstExpiry.timeIntervalSinceNow, 180)
+        XCTAssertEqual(1, privateKeyCount())
+
+        certificateAuthority.lifetime = 60 * 60
+        let scheduler = CertificateRenewalScheduler(renewalWindow: 5 * 60, makeRequestor: makeRequestor)
+        scheduler.start()
+        XCTAssertTrue(scheduler.isRenewing)
+        let renewed = expectation(for: NSPredicate { _, _ in scheduler.lastRenewalSucceeded == true }, evaluatedWith: nil)
+        wait(for: [renewed], timeout: 10.0)
+
+        let renewedExpiry = try XCTUnwrap(CertificateRenewalScheduler.identityExpiry(label: hostName))
+        XCTAssertGreaterThan(renewedExpiry.timeIntervalSince(firstExpiry), 30 * 60)
+        XCTAssertEqual(2, certificateAuthority.issued.count)
+        XCTAssertEqual(1, CertificateManager.certificatePersistentRefs(label: hostName).count)
+        XCTAssertEqual(1, privateKeyCount())
+        XCTAssertNotNil(SettingsStore.global.retrieveIdentity(label: hostName))
+        // The live connection isn't torn down; the next reconnect uses the new identity
+        XCTAssertFalse(SettingsStore.global.takServerChanged)
+        XCTAssertNotNil(scheduler.nextCheckDate)
+        scheduler.stop()
+    }
+
+    func testFailedRenewalIsRetriedLater() {
+        enroll()
+        XCTAssertEqual(1, privateKeyCount())
+        MockTAKServer.reply(to: signPath, with: MockTAKServer.text("Unauthorized", status: 401))
+        let signRequests = { MockTAKServer.requests.filter { $0.path == self.signPath }.count }
+        let enrolledRequests = signRequests()
+        let startedAt = Date()
+        var clock = startedAt
+        let scheduler = CertificateRenewalScheduler(renewalWindow: 5 * 60, expiryProvider: { startedAt.addingTimeInterval(60) }, makeRequestor: makeRequestor, now: { clock })
+
+        scheduler.start()
+        let failed = expectation(for: NSPredicate { _, _ in scheduler.lastRenewalSucceeded == false }, evaluatedWith: nil)
+        wait(for: [failed], timeout: 10.0)
+
+        XCTAssertFalse(scheduler.isRenewing)
+        XCTAssertEqual(startedAt.addingTimeInterval(CertificateRenewalScheduler.RETRY_INTERVAL), scheduler.nextCheckDate)
+        // The key stored for the failed CSR is removed again
+        XCTAssertEqual(1, privateKeyCount())
+
+        clock = startedAt.addingTimeInterval(CertificateRenewalScheduler.RETRY_INTERVAL)
+        scheduler.evaluate()
+        let failedAgain = expectation(for: NSPredicate { _, _ in !scheduler.isRenewing && signRequests() == enrolledRequests + 2 }, evaluatedWith: nil)
+        wait(for: [failedAgain], timeout: 10.0)
+
+        XCTAssertEqual(false, scheduler.lastRenewalSucceeded)
+        XCTAssertEqual(1, privateKeyCount())
+        XCTAssertNotNil(SettingsStore.global.retrieveIdentity(label: hostName))
+        scheduler.stop()
+    }
+}
@@ -0,0 +1,50 @@
+//
+//  ChatFixtures.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+// Messages for the chat tests, numbered so their ids sort by index and
+// each is created `index` seconds after START unless given a time
+struct ChatFixtures {
+    static let START = Date(timeIntervalSince1970: 1_000_000)
+
+    // A received message from one of seven senders
+    static func message(_ index: Int, at time: TimeInterval? = nil) -> MessageData {
+        let created = START.addingTimeInterval(time ?? TimeInterval(index))
+        return MessageData(
+            id: String(format: "message-%06d", index),
+            userUId: "ANDROID-\(index % 7)",
+            callSign: "Unit \(index % 7)",
+            message: "Message \(index)",
+            createAt: created,
+            expiresAt: created.addingTimeInterval(ChatStore.RETENTION_SECONDS),
+            dateSent: created,
+            dateReceived: created
+        )
+    }
+
+    static func messages(_ range: Range<Int>) -> [MessageData] {
+        return range.map { message($0) }
+    }
+
+    // One of ours, waiting in the outbox and due as soon as it's created
+    static func outgoing(_ index: Int, text: String? = nil) -> MessageData {
+        let created = START.addingTimeInterval(TimeInterval(index))
+        return MessageData(
+            id: String(format: "outgoing-%04d", index),
+            userUId: MessageData.CURRENT_USER_UID,
+            callSign: "Viper 1",
+            message: text ?? "Message \(index)",
+            createAt: created,
+            expiresAt: created.addingTimeInterval(ChatStore.RETENTION_SECONDS),
+            dateSent: created,
+            dateReceived: created,
+            deliveryStatus: .pending,
+            nextAttemptAt: created
+        )
+    }
+}
@@ -0,0 +1,120 @@
+//
+//  ChatOutboxTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import XCTest
+
+final class ChatOutboxTests: TAKTrackerTestCase {
+    // Past any jittered backoff
+    let longWait = ChatOutbox.MAX_BACKOFF_SECONDS * (1.0 + ChatOutbox.BACKOFF_JITTER) + 1
+    var temporaryDirectory: URL?
+
+    override func tearDown() {
+        if let directory = temporaryDirectory {
+            try? FileManager.default.removeItem(at: directory)
+        }
+        super.tearDown()
+    }
+
+    func outbox(_ store: ChatStore, sent: @escaping (MessageData) -> Void = { _ in }) -> ChatOutbox {
+        let outbox = ChatOutbox(chatStore: store)
+        outbox.onTransmit = sent
+        return outbox
+    }
+
+    func testRetriesOnlyAfterBackoff() {
+        let store = ChatStore(inMemory: true)
+        var sent: [MessageData] = []
+        let chatOutbox = outbox(store) { sent.append($0) }
+        store.insert(ChatFixtures.outgoing(0))
+
+        XCTAssertEqual(1, chatOutbox.drain(now: ChatFixtures.START))
+        XCTAssertEqual(1, sent.first?.sendAttempts)
+        XCTAssertEqual(.sent, store.messages().first?.deliveryStatus)
+
+        let firstBackoff = ChatOutbox.INITIAL_BACKOFF_SECONDS
+        XCTAssertEqual(0, chatOutbox.drain(now: ChatFixtures.START.addingTimeInterval(firstBackoff * (1.0 - ChatOutbox.BACKOFF_JITTER) - 1)))
+        XCTAssertEqual(1, chatOutbox.drain(now: ChatFixtures.START.addingTimeInterval(firstBackoff * (1.0 + ChatOutbox.BACKOFF_JITTER) + 1)))
+        XCTAssertEqual(2, sent.last?.sendAttempts)
+    }
+
+    func testReceiptsStopRetries() {
+        let store = ChatStore(inMemory: true)
+        let chatOutbox = outbox(store)
+        store.insert(ChatFixtures.outgoing(0))
+        XCTAssertEqual(1, chatOutbox.drain(now: ChatFixtures.START))
+
+        XCTAssertTrue(store.applyReceipt(messageID: ChatFixtures.outgoing(0).id, status: .delivered))
+        XCTAssertEqual(0, chatOutbox.drain(now: ChatFixtures.START.addingTimeInterval(longWait)))
+        XCTAssertTrue(store.applyReceipt(messageID: ChatFixtures.outgoing(0).id, status: .read))
+        // A late delivered receipt doesn't move it back
+        XCTAssertFalse(store.applyReceipt(messageID: ChatFixtures.outgoing(0).id, status: .delivered))
+        XCTAssertEqual(.read, store.messages().first?.deliveryStatus)
+        XCTAssertNil(store.messages().first?.nextAttemptAt)
+    }
+
+    func testGivesUpAfterMaxAttempts() {
+        let store = ChatStore(inMemory: true)
+        var sends = 0
+        let chatOutbox = outbox(store) { _ in sends += 1 }
+        store.insert(ChatFixtures.outgoing(0))
+
+        var now = ChatFixtures.START
+        for _ in 0...ChatOutbox.MAX_ATTEMPTS {
+            chatOutbox.drain(now: now)
+            now = now.addingTimeInterval(longWait)
+        }
+        XCTAssertEqual(ChatOutbox.MAX_ATTEMPTS, sends)
+        XCTAssertEqual(.failed, store.messages().first?.deliveryStatus)
+        XCTAssertEqual(0, chatOutbox.drain(now: now.addingTimeInterval(longWait)))
+    }
+
+    func testBacklogDrainsInSmallBatchesOnceConnected() {
+        let store = ChatStore(inMemory: true)
+        var isConnected = false
+        let chatOutbox = outbox(store)
+        chatOutbox.canTransmit = { isConnected }
+        store.insert((0..<25).map { ChatFixtures.outgoing($0) })
+
+        let now = ChatFixtures.START.addingTimeInterval(60)
+        XCTAssertEqual(0, chatOutbox.drain(now: now))
+        isConnected = true
+        XCTAssertEqual(ChatOutbox.MESSAGES_PER_TICK, chatOutbox.drain(now: now))
+        XCTAssertEqual(ChatOutbox.MESSAGES_PER_TICK, chatOutbox.drain(now: now.addingTimeInterval(1)))
+        XCTAssertEqual(5, chatOutbox.drain(now: now.addingTimeInterval(2)))
+        XCTAssertEqual(0, chatOutbox.drain(now: now.addingTimeInterval(3)))
+    }
+
+    func testQueueSurvivesRestart() throws {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        temporaryDirectory = directory
+        let url = directory.appendingPathComponent("MessageModel.sqlite")
+
+        do {
+            let store = ChatStore(storeURL: url)
+            store.insert([ChatFixtures.outgoing(0), ChatFixtures.outgoing(1)])
+            XCTAssertEqual(1, outbox(store).drain(now: ChatFixtures.START))
+        }
+
+        let store = ChatStore(storeURL: url)
+        var sent: [String] = []
+        let chatOutbox = outbox(store) { sent.append($0.id) }
+        chatOutbox.drain(now: ChatFixtures.START.addingTimeInterval(1))
+        XCTAssertEqual([ChatFixtures.outgoing(1).id], sent)
+        XCTAssertEqual(2, store.count())
+    }
+
+    func testBackoffDoublesUpToTheCap() {
+        for attempt in 1...10 {
+            let base = min(ChatOutbox.MAX_BACKOFF_SECONDS, ChatOutbox.INITIAL_BACKOFF_SECONDS * pow(2.0, Double(attempt - 1)))
+            let backoff = ChatOutbox.backoff(attempt: attempt)
+            XCTAssertGreaterThanOrEqual(backoff, base * (1.0 - ChatOutbox.BACKOFF_JITTER))
+            XCTAssertLessThanOrEqual(backoff, base * (1.0 + ChatOutbox.BACKOFF_JITTER))
+        }
+    }
+}
@@ -0,0 +1,141 @@
+//
+//  ChatStoreTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Combine
+import Foundation
+import XCTest
+
+final class ChatStoreTests: TAKTrackerTestCase {
+    func testStoresAndReadsBackMessages() {
+        let store = ChatStore(inMemory: true)
+        let sent = ChatFixtures.message(1)
+        store.insert(sent)
+        XCTAssertEqual([sent], store.messages())
+    }
+
+    func testLatestPageComesBackOldestFirst() {
+        let store = ChatStore(inMemory: true)
+        store.insert((0..<500).map { ChatFixtures.message($0) })
+
+        let page = store.messages(limit: 50)
+        XCTAssertEqual((450..<500).map { ChatFixtures.message($0).id }, page.map { $0.id })
+    }
+
+    func testPagingVisitsEveryMessageOnce() {
+        let store = ChatStore(inMemory: true)
+        // Groups of ten share a timestamp, so pages split ties
+        store.insert((0..<1_000).map { ChatFixtures.message($0, at: TimeInterval($0 / 10)) })
+        XCTAssertEqual(1_000, store.count())
+
+        var seen: [String] = []
+        var cursor: MessageData? = nil
+        while(true) {
+            let page = store.messages(olderThan: cursor, limit: 37)
+            if(page.isEmpty) {
+                break
+            }
+            seen.insert(contentsOf: page.map { $0.id }, at: 0)
+            cursor = page.first
+        }
+        XCTAssertEqual((0..<1_000).map { ChatFixtures.message($0).id }, seen)
+    }
+
+    func testWritesArePublishedOnMain() {
+        let store = ChatStore(inMemory: true)
+        let published = expectation(description: "published")
+        let cancellable = store.inserted.sink { messages in
+            XCTAssertTrue(Thread.isMainThread)
+            XCTAssertEqual(3, messages.count)
+            published.fulfill()
+        }
+        store.insert([ChatFixtures.message(1), ChatFixtures.message(2), ChatFixtures.message(3)])
+        wait(for: [published], timeout: 2)
+        cancellable.cancel()
+    }
+
+    // A busy channel: 10k messages arriving one at a time
+    func testInsertingTenThousandMessages() {
+        let messages = (0..<10_000).map { ChatFixtures.message($0) }
+        measure {
+            let store = ChatStore(inMemory: true)
+            for message in messages {
+                store.insert(message)
+            }
+            store.flush()
+        }
+    }
+
+    func testMessageIDsAreUnique() {
+        let store = ChatStore(inMemory: true)
+        store.insert(ChatFixtures.message(1))
+        store.flush()
+        let edited = MessageData(id: ChatFixtures.message(1).id, userUId: "ANDROID-1", callSign: "Unit 1", message: "Edited", createAt: ChatFixtures.message(1).createAt, expiresAt: ChatFixtures.message(1).expiresAt)
+        store.insert([ChatFixtures.message(2), edited, ChatFixtures.message(2)])
+
+        XCTAssertEqual(2, store.count())
+        XCTAssertEqual(["Edited", "Message 2"], store.messages().map { $0.message })
+        XCTAssertTrue(store.containsMessage(id: ChatFixtures.message(2).id))
+        XCTAssertFalse(store.containsMessage(id: ChatFixtures.message(3).id))
+    }
+
+    func testOnlyNewMessagesArePublished() {
+        let store = ChatStore(inMemory: true)
+        store.insert(ChatFixtures.message(1))
+        store.flush()
+
+        let published = expectation(description: "published")
+        let cancellable = store.inserted.sink { messages in
+            XCTAssertEqual([self.message(2)], messages)
+            published.fulfill()
+        }
+        store.insert([ChatFixtures.message(1), ChatFixtures.message(2)])
+        store.flush()
+        wait(for: [published], timeout: 2)
+        cancellable.cancel()
+    }
+
+    func testPurgeRemovesExpiredMessages() {
+        let store = ChatStore(inMemory: true)
+        store.insert((0..<100).map { ChatFixtures.message($0) })
+
+        let cutoff = ChatFixtures.message(40).expiresAt
+        XCTAssertEqual(41, store.purgeExpired(now: cutoff))
+        XCTAssertEqual(59, store.count())
+        XCTAssertEqual(ChatFixtures.message(41), store.messages(limit: 100).first)
+    }
+
+    func hundredThousandMessageStore() -> ChatStore {
+        let store = ChatStore(inMemory: true)
+        store.insert((0..<100_000).map { ChatFixtures.message($0) })
+        store.flush()
+        return store
+    }
+
+    // 1000 dedup lookups against 100k stored messages
+    func testDedupLookupsInHundredThousandMessages() {
+        let store = hundredThousandMessageStore()
+        let ids = stride(from: 0, to: 200_000, by: 200).map { ChatFixtures.message($0).id }
+        measure {
+            var found = 0
+            for id in ids where store.containsMessage(id: id) {
+                found += 1
+            }
+            XCTAssertEqual(500, found)
+        }
+    }
+
+    // Purging half of a 100k message store
+    func testPurgingHalfOfHundredThousandMessages() {
+        measureMetrics([.wallClockTime], automaticallyStartMeasuring: false) {
+            let store = hundredThousandMessageStore()
+            startMeasuring()
+            let purged = store.purgeExpired(now: ChatFixtures.message(49_999).expiresAt)
+            stopMeasuring()
+            XCTAssertEqual(50_000, purged)
+        }
+    }
+}
@@ -0,0 +1,94 @@
+//
+//  ChatTimelineWindowTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import XCTest
+
+final class ChatTimelineWindowTests: TAKTrackerTestCase {
+    func testOlderPagesEvictTheNewest() {
+        var window = ChatTimelineWindow(pageSize: 10, maxPages: 3)
+        window.reset(latest: ChatFixtures.messages(90..<100))
+        XCTAssertTrue(window.hasOlder)
+
+        window.prependOlder(ChatFixtures.messages(80..<90))
+        window.prependOlder(ChatFixtures.messages(70..<80))
+        XCTAssertTrue(window.isAtLatest)
+        window.prependOlder(ChatFixtures.messages(60..<70))
+
+        XCTAssertEqual(ChatFixtures.messages(60..<90), window.messages)
+        XCTAssertFalse(window.isAtLatest)
+    }
+
+    func testNewerPagesEvictTheOldest() {
+        var window = ChatTimelineWindow(pageSize: 10, maxPages: 2)
+        window.reset(latest: ChatFixtures.messages(90..<100))
+        window.prependOlder(ChatFixtures.messages(80..<90))
+        window.prependOlder(ChatFixtures.messages(70..<80))
+        XCTAssertEqual(ChatFixtures.messages(70..<90), window.messages)
+
+        window.appendNewer(ChatFixtures.messages(90..<100))
+        XCTAssertEqual(ChatFixtures.messages(80..<100), window.messages)
+        XCTAssertTrue(window.hasOlder)
+        // A full page may not be the last one
+        XCTAssertFalse(window.isAtLatest)
+        window.appendNewer([])
+        XCTAssertTrue(window.isAtLatest)
+    }
+
+    func testLiveMessagesOnlyApplyAtTheLatestEdge() {
+        var window = ChatTimelineWindow(pageSize: 10, maxPages: 2)
+        window.reset(latest: ChatFixtures.messages(90..<100))
+        XCTAssertTrue(window.insertLive([ChatFixtures.message(100)]))
+        XCTAssertEqual(ChatFixtures.message(100), window.newest)
+        XCTAssertFalse(window.insertLive([ChatFixtures.message(100)]))
+
+        window.prependOlder(ChatFixtures.messages(80..<90))
+        window.prependOlder(ChatFixtures.messages(70..<80))
+        XCTAssertFalse(window.insertLive([ChatFixtures.message(101)]))
+        XCTAssertFalse(window.messages.contains(ChatFixtures.message(101)))
+    }
+
+    func testLateMessagesAreSlottedInOrder() {
+        var window = ChatTimelineWindow(pageSize: 10)
+        window.reset(latest: [ChatFixtures.message(1), ChatFixtures.message(3), ChatFixtures.message(5)])
+        window.insertLive([ChatFixtures.message(4), ChatFixtures.message(0)])
+        XCTAssertEqual([0, 1, 3, 4, 5].map { ChatFixtures.message($0) }, window.messages)
+    }
+
+    func testDeliveryStatusUpdatesInPlace() {
+        var window = ChatTimelineWindow(pageSize: 10)
+        window.reset(latest: ChatFixtures.messages(0..<5))
+        XCTAssertTrue(window.updateDeliveryStatus(id: ChatFixtures.message(3).id, to: .delivered))
+        XCTAssertFalse(window.updateDeliveryStatus(id: ChatFixtures.message(9).id, to: .delivered))
+        XCTAssertEqual(.delivered, window.messages[3].deliveryStatus)
+        XCTAssertEqual(.incoming, window.messages[2].deliveryStatus)
+    }
+
+    // Scroll to the top of a 50k message history and back down
+    func testWindowStaysBoundedOverFiftyThousandMessages() {
+        let store = ChatStore(inMemory: true)
+        store.insert(ChatFixtures.messages(0..<50_000))
+        var window = ChatTimelineWindow()
+        window.reset(latest: store.messages(limit: window.pageSize))
+
+        var pages = 1
+        while(window.hasOlder) {
+            window.prependOlder(store.messages(olderThan: window.oldest, limit: window.pageSize))
+            XCTAssertLessThanOrEqual(window.messages.count, window.maxMessages)
+            pages += 1
+        }
+        XCTAssertEqual(ChatFixtures.message(0), window.oldest)
+        XCTAssertEqual(50_000 / window.pageSize + 1, pages)
+
+        while(!window.isAtLatest) {
+            window.appendNewer(store.messages(newerThan: window.newest!, limit: window.pageSize))
+            XCTAssertLessThanOrEqual(window.messages.count, window.maxMessages)
+        }
+        XCTAssertEqual(ChatFixtures.message(49_999), window.newest)
+        XCTAssertEqual(ChatFixtures.messages((50_000 - window.maxMessages)..<50_000), window.messages)
+    }
+}
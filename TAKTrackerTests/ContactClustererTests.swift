@@ -0,0 +1,106 @@
+//
+//  ContactClustererTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import MapKit
+import XCTest
+
+final class ContactClustererTests: TAKTrackerTestCase {
+    let start = Date(timeIntervalSince1970: 1_000_000)
+
+    func contact(_ uid: String, latitude: Double, longitude: Double) -> ContactRecord {
+        return ContactRecord(uid: uid, type: "a-f-G-U-C", callsign: uid, group: "Cyan", role: "Team Member", latitude: latitude, longitude: longitude, heightAboveEllipsoid: 0, speed: 0, course: 0, time: start, stale: start.addingTimeInterval(600))
+    }
+
+    func randomContacts(count: Int, seed: UInt64) -> [ContactRecord] {
+        var generator = SeededGenerator(seed: seed)
+        return (0..<count).map { index in
+            contact("contact-\(index)", latitude: Double.random(in: 38.5...39.5, using: &generator), longitude: Double.random(in: -77.5 ... -76.5, using: &generator))
+        }
+    }
+
+    func testZoomLevelFollowsSpan() {
+        // The whole world on a phone is zoom 2, a few blocks is well past 14
+        XCTAssertEqual(2, ContactClusterer.zoomLevel(longitudeDelta: 360, mapWidth: 390))
+        XCTAssertGreaterThan(ContactClusterer.zoomLevel(longitudeDelta: 0.01, mapWidth: 390), 14)
+        XCTAssertEqual(
+            ContactClusterer.zoomLevel(longitudeDelta: 0.5, mapWidth: 390) + 1,
+            ContactClusterer.zoomLevel(longitudeDelta: 0.25, mapWidth: 390)
+        )
+    }
+
+    func testNearbyContactsAreClustered() {
+        let contacts = [
+            contact("a", latitude: 38.8001, longitude: -77.0001),
+            contact("b", latitude: 38.8002, longitude: -77.0002),
+            contact("c", latitude: 38.8003, longitude: -77.0003),
+            contact("far", latitude: 40.0, longitude: -75.0)
+        ]
+        let clusters = ContactClusterer.cluster(contacts, zoomLevel: 10)
+        XCTAssertEqual(2, clusters.count)
+        let group = clusters.first { $0.isCluster }!
+        XCTAssertEqual(3, group.count)
+        XCTAssertEqual(38.8002, group.latitude, accuracy: 0.00001)
+        XCTAssertEqual("far", clusters.first { !$0.isCluster }?.id)
+    }
+
+    func testNoClusteringWhenZoomedAllTheWayIn() {
+        let contacts = [contact("a", latitude: 38.8, longitude: -77.0), contact("b", latitude: 38.8, longitude: -77.0)]
+        XCTAssertEqual(["a", "b"], ContactClusterer.cluster(contacts, zoomLevel: ContactClusterer.MAX_CLUSTER_ZOOM).map { $0.id })
+    }
+
+    func testDiffOnlyTouchesWhatChanged() {
+        let before = ContactClusterer.cluster(randomContacts(count: 500, seed: 1), zoomLevel: 12)
+        var current: [String: ContactCluster] = [:]
+        for cluster in before {
+            current[cluster.id] = cluster
+        }
+        XCTAssertTrue(ContactClusterer.diff(from: current, to: before).isEmpty)
+
+        var contacts = randomContacts(count: 500, seed: 1)
+        contacts[0].latitude += 0.00001
+        let after = ContactClusterer.cluster(contacts, zoomLevel: 12)
+        let diff = ContactClusterer.diff(from: current, to: after)
+        XCTAssertTrue(diff.added.isEmpty)
+        XCTAssertTrue(diff.removed.isEmpty)
+        XCTAssertEqual(1, diff.updated.count)
+    }
+
+    func testPanningKeepsClusterIds() {
+        let store = ContactStore(start: start)
+        store.upsert(randomContacts(count: 2_000, seed: 2))
+        var displayed: [String: ContactCluster] = [:]
+        let center = CLLocationCoordinate2D(latitude: 39.0, longitude: -77.0)
+        let span = MKCoordinateSpan(latitudeDelta: 0.4, longitudeDelta: 0.4)
+
+        let initial = ContactAnnotationController.diff(store: store, region: MKCoordinateRegion(center: center, span: span), mapWidth: 390, displayed: &displayed)
+        XCTAssertFalse(initial.added.isEmpty)
+        XCTAssertTrue(initial.removed.isEmpty)
+
+        // A small pan at the same zoom only brings in clusters at the edges
+        let panned = CLLocationCoordinate2D(latitude: 39.01, longitude: -77.01)
+        let diff = ContactAnnotationController.diff(store: store, region: MKCoordinateRegion(center: panned, span: span), mapWidth: 390, displayed: &displayed)
+        XCTAssertLessThan(diff.added.count + diff.removed.count, initial.added.count / 2)
+        XCTAssertEqual(initial.added.count + diff.added.count - diff.removed.count, displayed.count)
+    }
+
+    // Clustering and diffing for one frame of panning across 5k contacts
+    func testPanPerformanceWithFiveThousandContacts() {
+        let store = ContactStore(start: start)
+        store.upsert(randomContacts(count: 5_000, seed: 3))
+        var displayed: [String: ContactCluster] = [:]
+        let span = MKCoordinateSpan(latitudeDelta: 0.5, longitudeDelta: 0.5)
+        var step = 0.0
+        measure {
+            for _ in 0..<10 {
+                step += 0.005
+                let center = CLLocationCoordinate2D(latitude: 38.8 + step, longitude: -77.2 + step)
+                _ = ContactAnnotationController.diff(store: store, region: MKCoordinateRegion(center: center, span: span), mapWidth: 390, displayed: &displayed)
+            }
+        }
+    }
+}
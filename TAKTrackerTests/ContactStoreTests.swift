@@ -0,0 +1,140 @@
+//
+//  ContactStoreTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import XCTest
+
+final class ContactStoreTests: TAKTrackerTestCase {
+    let start = Date(timeIntervalSince1970: 1_000_000)
+
+    func contact(_ uid: String, at time: TimeInterval, staleAfter: TimeInterval = 60, latitude: Double = 38.0) -> ContactRecord {
+        return ContactRecord(
+            uid: uid,
+            type: "a-f-G-U-C",
+            callsign: uid.uppercased(),
+            group: "Cyan",
+            role: "Team Member",
+            latitude: latitude,
+            longitude: -77.0,
+            heightAboveEllipsoid: 10,
+            speed: 1,
+            course: 90,
+            time: start.addingTimeInterval(time),
+            stale: start.addingTimeInterval(time + staleAfter)
+        )
+    }
+
+    func testUpsertInsertsAndUpdatesInPlace() {
+        let store = ContactStore(start: start)
+        store.upsert(contact("alpha", at: 0))
+        store.upsert(contact("bravo", at: 0))
+        store.upsert(contact("alpha", at: 5, latitude: 39.0))
+
+        XCTAssertEqual(2, store.count)
+        XCTAssertEqual(39.0, store.contact(uid: "alpha")?.latitude)
+    }
+
+    func testOlderReportsAreIgnored() {
+        let store = ContactStore(start: start)
+        store.upsert(contact("alpha", at: 10, latitude: 39.0))
+        store.upsert(contact("alpha", at: 5, latitude: 40.0))
+        XCTAssertEqual(39.0, store.contact(uid: "alpha")?.latitude)
+    }
+
+    func testContactsExpireAtStaleTime() {
+        let store = ContactStore(start: start)
+        store.upsert(contact("alpha", at: 0, staleAfter: 30))
+        store.upsert(contact("bravo", at: 0, staleAfter: 90))
+
+        XCTAssertTrue(store.expire(now: start.addingTimeInterval(29)).isEmpty)
+        XCTAssertEqual(["alpha"], store.expire(now: start.addingTimeInterval(30)))
+        XCTAssertEqual(["bravo"], store.expire(now: start.addingTimeInterval(91)))
+        XCTAssertEqual(0, store.count)
+    }
+
+    func testRefreshedContactsAreKept() {
+        let store = ContactStore(start: start)
+        store.upsert(contact("alpha", at: 0, staleAfter: 30))
+        store.upsert(contact("alpha", at: 20, staleAfter: 30))
+
+        XCTAssertTrue(store.expire(now: start.addingTimeInterval(35)).isEmpty)
+        XCTAssertEqual(1, store.count)
+        XCTAssertEqual(["alpha"], store.expire(now: start.addingTimeInterval(50)))
+    }
+
+    func testEarlierStaleTimeTakesEffect() {
+        let store = ContactStore(start: start)
+        store.upsert(contact("alpha", at: 0, staleAfter: 300))
+        store.upsert(contact("alpha", at: 1, staleAfter: 10))
+        XCTAssertEqual(["alpha"], store.expire(now: start.addingTimeInterval(11)))
+        XCTAssertTrue(store.expire(now: start.addingTimeInterval(400)).isEmpty)
+    }
+
+    func testSnapshotsDoNotChangeUnderneathReaders() {
+        let store = ContactStore(start: start)
+        store.upsert(contact("alpha", at: 0))
+        let snapshot = store.snapshot()
+        store.upsert(contact("bravo", at: 0))
+        store.remove(uid: "alpha")
+
+        XCTAssertEqual(["alpha"], snapshot.contacts.map { $0.uid })
+        let latest = store.snapshot()
+        XCTAssertEqual(["bravo"], latest.contacts.map { $0.uid })
+        XCTAssertGreaterThan(latest.version, snapshot.version)
+    }
+
+    func testParsesContactFromEvent() throws {
+        let event = """
+        <?xml version="1.0" encoding="UTF-8"?>
+        <event version="2.0" uid="ANDROID-1234" type="a-f-G-U-C" how="m-g" time="2023-09-01T12:00:00.000Z" start="2023-09-01T12:00:00.000Z" stale="2023-09-01T12:05:00Z">
+        <point lat="38.8895" lon="-77.0353" hae="12.5" ce="9999999" le="9999999"/>
+        <detail><contact callsign="VIPER"/><__group name="Cyan" role="Team Lead"/><track course="271.5" speed="3.2"/></detail>
+        </event>
+        """
+        let contact = try XCTUnwrap(COTEventParser.parseContact(data: Data(event.utf8)))
+        XCTAssertEqual("ANDROID-1234", contact.uid)
+        XCTAssertEqual("VIPER", contact.callsign)
+        XCTAssertEqual("Cyan", contact.group)
+        XCTAssertEqual("Team Lead", contact.role)
+        XCTAssertEqual(38.8895, contact.latitude)
+        XCTAssertEqual(271.5, contact.course)
+        XCTAssertEqual(300, contact.stale.timeIntervalSince(contact.time))
+    }
+
+    func testNonAtomEventsAreNotContacts() {
+        let event = """
+        <event version="2.0" uid="GeoChat.1" type="b-t-f" time="2023-09-01T12:00:00Z" start="2023-09-01T12:00:00Z" stale="2023-09-02T12:00:00Z"><point lat="0" lon="0" hae="0" ce="0" le="0"/></event>
+        """
+        XCTAssertNil(COTEventParser.parseContact(data: Data(event.utf8)))
+    }
+
+    func testFramerSplitsStreamIntoEvents() {
+        var framer = COTStreamFramer()
+        let first = "<event uid=\"1\"><point/></event>"
+        let second = "<event uid=\"2\"><point/></event>"
+        let stream = Data((first + second).utf8)
+
+        let split = stream.count - 10
+        XCTAssertEqual([Data(first.utf8)], framer.append(stream.prefix(split)))
+        XCTAssertEqual([Data(second.utf8)], framer.append(stream.suffix(from: split)))
+        XCTAssertTrue(framer.append(Data()).isEmpty)
+    }
+
+    // 10k contacts each reporting at 4 Hz for 5 seconds, expiring as we go
+    func testUpdatePerformanceWithTenThousandContacts() {
+        let uids = (0..<10_000).map { "contact-\($0)" }
+        measure {
+            let store = ContactStore(start: start)
+            for step in 0..<20 {
+                let time = Double(step) * 0.25
+                store.upsert(uids.map { contact($0, at: time, staleAfter: 30) })
+                store.expire(now: start.addingTimeInterval(time))
+            }
+            XCTAssertEqual(10_000, store.count)
+        }
+    }
+}
@@ -0,0 +1,174 @@
+//
+//  DataPackageContentStoreTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Crypto
+import Foundation
+import XCTest
+import ZIPFoundation
+
+final class DataPackageContentStoreTests: TAKTrackerTestCase {
+    let manifest = """
+    <MissionPackageManifest version="2">
+    <Configuration>
+      <Parameter name="uid" value="mission-1"/>
+      <Parameter name="name" value="Mission One"/>
+    </Configuration>
+    <Contents>
+      <Content ignore="false" zipEntry="overlays\\boundary.kml">
+        <Parameter name="contentType" value="KML"/>
+      </Content>
+      <Content ignore="false" zipEntry="imagery/area.tif"/>
+      <Content ignore="true" zipEntry="notes/skip.txt"/>
+      <Content ignore="false" zipEntry="certs\\user.p12"/>
+    </Contents>
+    </MissionPackageManifest>
+    """
+
+    var workDirectory: URL!
+    var store: DataPackageContentStore!
+
+    override func setUpWithError() throws {
+        workDirectory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+        try FileManager.default.createDirectory(at: workDirectory, withIntermediateDirectories: true)
+        store = DataPackageContentStore(rootURL: workDirectory.appendingPathComponent("store", isDirectory: true))
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: workDirectory)
+    }
+
+    // Zips up files written from `files` (path -> contents)
+    func makePackage(named name: String, files: [String: Data]) throws -> URL {
+        let sourceDirectory = workDirectory.appendingPathComponent("\(name)-source", isDirectory: true)
+        let packageURL = workDirectory.appendingPathComponent("\(name).zip")
+        let archive = try Archive(url: packageURL, accessMode: .create)
+        for (path, contents) in files.sorted(by: { $0.key < $1.key }) {
+            let fileURL = sourceDirectory.appendingPathComponent(path)
+            try FileManager.default.createDirectory(at: fileURL.deletingLastPathComponent(), withIntermediateDirectories: true)
+            try contents.write(to: fileURL)
+            try archive.addEntry(with: path, relativeTo: sourceDirectory, compressionMethod: .deflate)
+        }
+        return packageURL
+    }
+
+    // Not very compressible, so the zip is about as big as the image
+    func imagery(megabytes: Int) -> Data {
+        var generator = SeededGenerator(seed: 42)
+        var data = Data(capacity: megabytes * 1024 * 1024)
+        for _ in 0..<(megabytes * 1024 * 1024 / 8) {
+            var value = generator.next()
+            withUnsafeBytes(of: &value) { data.append(contentsOf: $0) }
+        }
+        return data
+    }
+
+    func sha256(_ data: Data) -> String {
+        return SHA256.hash(data: data).map { String(format: "%02x", $0) }.joined()
+    }
+
+    func testStoresManifestEntriesWithIndex() throws {
+        let kml = Data("<kml><Placemark><name>Boundary</name></Placemark></kml>".utf8)
+        let image = imagery(megabytes: 4)
+        let packageURL = try makePackage(named: "mission", files: [
+            "manifest.xml": Data(manifest.utf8),
+            "overlays/boundary.kml": kml,
+            "imagery/area.tif": image,
+            "notes/skip.txt": Data("ignored".utf8),
+            "notes/unlisted.txt": Data("not in the manifest".utf8),
+            "certs/user.p12": Data("secret".utf8)
+        ])
+
+        var fractions: [Double] = []
+        let index = try DataPackageReader(fileLocation: packageURL).storeContents(in: store) { fractions.append($0) }
+
+        XCTAssertEqual("mission-1", index.uid)
+        XCTAssertEqual("Mission One", index.name)
+        XCTAssertEqual(["overlays/boundary.kml", "imagery/area.tif"], index.entries.map { $0.storedPath })
+        XCTAssertEqual([.kml, .image], index.entries.map { $0.type })
+        XCTAssertEqual([UInt64(kml.count), UInt64(image.count)], index.entries.map { $0.size })
+        XCTAssertEqual([sha256(kml), sha256(image)], index.entries.map { $0.sha256 })
+        XCTAssertEqual(index, store.index(uid: "mission-1"))
+        XCTAssertEqual([index], store.indexes())
+        XCTAssertEqual(fractions.sorted(), fractions)
+        XCTAssertEqual(1.0, fractions.last)
+
+        let mapped = try store.mappedData(for: index.entries[1], in: index)
+        XCTAssertEqual(image, mapped)
+        XCTAssertFalse(FileManager.default.fileExists(atPath: store.packageDirectory(uid: "mission-1").appendingPathComponent("certs/user.p12").path))
+        XCTAssertFalse(FileManager.default.fileExists(atPath: store.stagingDirectory(uid: "mission-1").path))
+    }
+
+    func testReimportReplacesPackage() throws {
+        let first = try makePackage(named: "first", files: [
+            "manifest.xml": Data(manifest.utf8),
+            "overlays/boundary.kml": Data("<kml/>".utf8),
+            "imagery/area.tif": Data("old".utf8)
+        ])
+        let second = try makePackage(named: "second", files: [
+            "manifest.xml": Data(manifest.utf8),
+            "overlays/boundary.kml": Data("<kml></kml>".utf8)
+        ])
+
+        _ = try DataPackageReader(fileLocation: first).storeContents(in: store)
+        let index = try DataPackageReader(fileLocation: second).storeContents(in: store)
+
+        XCTAssertEqual(["overlays/boundary.kml"], store.index(uid: "mission-1")?.entries.map { $0.storedPath })
+        XCTAssertEqual(Data("<kml></kml>".utf8), try store.mappedData(for: index.entries[0], in: index))
+        XCTAssertFalse(FileManager.default.fileExists(atPath: store.packageDirectory(uid: "mission-1").appendingPathComponent("imagery/area.tif").path))
+        XCTAssertEqual(1, store.indexes().count)
+    }
+
+    func testPackageWithoutManifestStoresEverythingButConfig() throws {
+        let packageURL = try makePackage(named: "loose", files: [
+            "server.pref": Data("<preferences/>".utf8),
+            "photos/site.jpg": Data([0xFF, 0xD8]),
+            "briefing.pdf": Data("%PDF".utf8)
+        ])
+
+        let index = try DataPackageReader(fileLocation: packageURL).storeContents(in: store)
+
+        XCTAssertEqual("loose", index.uid)
+        XCTAssertEqual(["briefing.pdf", "photos/site.jpg"], index.entries.map { $0.storedPath }.sorted())
+        XCTAssertEqual([.document, .image], index.entries.sorted { $0.storedPath < $1.storedPath }.map { $0.type })
+    }
+
+    func testParseStoresContentOnlyPackage() async throws {
+        let packageURL = try makePackage(named: "overlays", files: [
+            "manifest.xml": Data(manifest.utf8),
+            "overlays/boundary.kml": Data("<kml/>".utf8),
+            "imagery/area.tif": Data("tif".utf8)
+        ])
+        SettingsStore.global.takServerUrl = "tak.example.com"
+        SettingsStore.global.serverCertificateTruststore = [Data("existing".utf8)]
+        defer {
+            SettingsStore.global.takServerUrl = ""
+            SettingsStore.global.serverCertificateTruststore = []
+        }
+
+        let errors = await TAKDataPackageParser(fileLocation: packageURL, contentStore: store).parse()
+
+        XCTAssertEqual([], errors)
+        XCTAssertEqual(["overlays/boundary.kml", "imagery/area.tif"], store.index(uid: "mission-1")?.entries.map { $0.storedPath })
+        // No connection in the package, so the current one is left alone
+        XCTAssertEqual("tak.example.com", SettingsStore.global.takServerUrl)
+        XCTAssertEqual([Data("existing".utf8)], SettingsStore.global.serverCertificateTruststore)
+    }
+
+    func testStoredPathsStayInsidePackage() {
+        XCTAssertEqual("a/b.kml", DataPackageContentStore.storedPath(forEntryPath: "a\\b.kml"))
+        XCTAssertEqual("etc/passwd", DataPackageContentStore.storedPath(forEntryPath: "../../etc/passwd"))
+        XCTAssertEqual("unnamed", DataPackageContentStore.storedPath(forEntryPath: "/"))
+        XCTAssertEqual("a_b", DataPackageContentStore.safeComponent("a/b"))
+    }
+
+    func testContentTypes() {
+        XCTAssertEqual(.kml, DataPackageContentType.of(path: "a.xml", manifestType: "KML"))
+        XCTAssertEqual(.kmz, DataPackageContentType.of(path: "a.KMZ"))
+        XCTAssertEqual(.video, DataPackageContentType.of(path: "clip.mp4"))
+        XCTAssertEqual(.other, DataPackageContentType.of(path: "data.bin"))
+    }
+}
@@ -18,16 +18,22 @@ import ZIPFoundation
 final class DataPackageParserTests: TAKTrackerTestCase {
     var parser:TAKDataPackageParser? = nil
     var archiveURL:URL? = nil
+    var contentStore:DataPackageContentStore? = nil
 
     override func setUpWithError() throws {
         let bundle = Bundle(for: Self.self)
         archiveURL = bundle.url(forResource: TestConstants.ITAK_DATA_PACKAGE_NAME, withExtension: "zip")
-        parser = TAKDataPackageParser.init(fileLocation: archiveURL!)
+        contentStore = DataPackageContentStore(rootURL: FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString))
+        parser = TAKDataPackageParser.init(fileLocation: archiveURL!, contentStore: contentStore!)
         
         let cleanUpQuery: [String: Any] = [kSecClass as String:  kSecClassIdentity,
                                            kSecAttrLabel as String: TestConstants.TEST_HOST]
         SecItemDelete(cleanUpQuery as CFDictionary)
     }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: contentStore!.rootURL)
+    }
     
     func testParserStoresServerCertificates() throws {
         let bundle = Bundle(for: Self.self)
@@ -86,4 +92,49 @@ final class DataPackageParserTests: TAKTrackerTestCase {
         XCTAssertNotNil(identity, "Identity was not stored in the Keychain")
     }
 
+    func testReaderStreamsConnectionAndCertificatesFromPackage() throws {
+        var fractions: [Double] = []
+        let contents = try DataPackageReader(fileLocation: archiveURL!).read { fractions.append($0) }
+
+        XCTAssertEqual("tak.flighttactics.com", contents.serverURL)
+        XCTAssertEqual("8089", contents.serverPort)
+        XCTAssertEqual("ssl", contents.serverProtocol)
+        XCTAssertEqual(4598, contents.userCertificate.count)
+        XCTAssertEqual(TestConstants.DEFAULT_CERT_PASSWORD, contents.userCertificatePassword)
+        XCTAssertEqual(1, contents.serverCertificates.count)
+        XCTAssertEqual(2216, contents.serverCertificates.first?.certificateData.count)
+        XCTAssertEqual(fractions.sorted(), fractions)
+        XCTAssertEqual(1.0, fractions.last)
+    }
+
+    func testReaderMatchesCertificatesByFileName() throws {
+        let archive = try Archive(url: archiveURL!, accessMode: .read)
+        let entries = Array(archive)
+        XCTAssertEqual("foyc.p12", DataPackageReader.entry(named: "cert/foyc.p12", in: entries)?.path)
+        XCTAssertEqual("foyc.p12", DataPackageReader.entry(named: "certs\\FOYC.p12", in: entries)?.path)
+        XCTAssertNil(DataPackageReader.entry(named: "cert/missing.p12", in: entries))
+    }
+
+    func testParseImportsPackage() async throws {
+        var fractions: [Double] = []
+        let errors = await parser!.parse { fractions.append($0) }
+
+        XCTAssertEqual([], errors)
+        XCTAssertEqual("tak.flighttactics.com", SettingsStore.global.takServerUrl)
+        XCTAssertEqual("8089", SettingsStore.global.takServerPort)
+        XCTAssertEqual("ssl", SettingsStore.global.takServerProtocol)
+        XCTAssertFalse(SettingsStore.global.serverCertificateTruststore.isEmpty)
+        // Only certificates and preferences, which are never written out
+        XCTAssertEqual([], contentStore!.index(uid: "8d16b2fc-1e53-11ee-be56-0242ac120002")?.entries)
+
+        // Progress is delivered on main ahead of parse returning
+        XCTAssertEqual(fractions.sorted(), fractions)
+        XCTAssertEqual(1.0, fractions.last)
+    }
+
+    func testParseCollectsErrorsForUnreadablePackage() async throws {
+        let missing = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).zip")
+        let errors = await TAKDataPackageParser(fileLocation: missing).parse()
+        XCTAssertEqual(1, errors.count)
+    }
 }
@@ -0,0 +1,235 @@
+//
+//  EnrollmentHTTPClientTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import SwiftASN1
+import X509
+import XCTest
+
+final class EnrollmentHTTPClientTests: TAKTrackerTestCase {
+    let configPath = TAKConstants.CERT_CONFIG_PATH
+    let signPath = "/Marti/api/tls/signClient/v2"
+    let caConfig = """
+    <?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+    <certificateConfig validityDays="30">
+      <nameEntries>
+        <nameEntry name="O" value="FLIGHTTACTICS"/>
+        <nameEntry name="OU" value="TAK"/>
+      </nameEntries>
+    </certificateConfig>
+    """
+
+    var client: EnrollmentHTTPClient!
+
+    override func setUpWithError() throws {
+        MockTAKServer.reset()
+        client = EnrollmentHTTPClient(configuration: MockTAKServer.configuration(), retryBaseDelay: 0.01)
+    }
+
+    override func tearDownWithError() throws {
+        MockTAKServer.reset()
+        SettingsStore.global.takServerUrl = ""
+        SettingsStore.global.enrollmentKeyType = CertificateKeyType.rsa2048.rawValue
+        let dictionary = [kSecClass as String: kSecClassKey]
+        SecItemDelete(dictionary as CFDictionary)
+    }
+
+    func request(_ path: String) -> URLRequest {
+        return URLRequest(url: URL(string: "https://tak.example.com:8446\(path)")!)
+    }
+
+    func signRequest() -> URLRequest {
+        var post = request(signPath)
+        post.httpMethod = "POST"
+        post.httpBody = Data("csr".utf8)
+        return post
+    }
+
+    func send(_ path: String) -> (result: EnrollmentHTTPResult?, task: EnrollmentHTTPTask) {
+        return send(request(path))
+    }
+
+    func send(_ request: URLRequest) -> (result: EnrollmentHTTPResult?, task: EnrollmentHTTPTask) {
+        let finished = expectation(description: "request finished")
+        var result: EnrollmentHTTPResult?
+        let task = client.send(request) {
+            result = $0
+            finished.fulfill()
+        }
+        wait(for: [finished], timeout: 5.0)
+        return (result, task)
+    }
+
+    func testSigningReusesTheConfigConnection() throws {
+        let server = try LocalTLSServer(body: caConfig)
+        try server.start()
+        defer { server.stop() }
+        client = EnrollmentHTTPClient()
+
+        let config = send(URLRequest(url: server.url(configPath)))
+        var signRequest = URLRequest(url: server.url(signPath))
+        signRequest.httpMethod = "POST"
+        signRequest.httpBody = Data("csr".utf8)
+        let signed = send(signRequest)
+        let collected = expectation(for: NSPredicate { _, _ in config.task.metrics != nil && signed.task.metrics != nil }, evaluatedWith: nil)
+        wait(for: [collected], timeout: 5.0)
+
+        XCTAssertEqual(Data(caConfig.utf8), try config.result?.get().data)
+        XCTAssertNotNil(try signed.result?.get())
+        XCTAssertEqual([configPath, signPath], server.requests)
+        XCTAssertEqual(false, config.task.metrics?.transactionMetrics.last?.isReusedConnection)
+        XCTAssertEqual(true, signed.task.metrics?.transactionMetrics.last?.isReusedConnection)
+    }
+
+    func testRetriesTransientFailures() throws {
+        MockTAKServer.reply(to: configPath, with: .failure(.networkConnectionLost), MockTAKServer.text("busy", status: 503), MockTAKServer.text(caConfig))
+
+        let sent = send(configPath)
+
+        XCTAssertEqual(Data(caConfig.utf8), try sent.result?.get().data)
+        XCTAssertEqual(3, sent.task.attempts)
+    }
+
+    func testRetriesSigningOnlyWhenItWasNotProcessed() throws {
+        MockTAKServer.reply(to: signPath, with: .failure(.cannotConnectToHost), MockTAKServer.text("slow down", status: 429), MockTAKServer.json("{}"))
+
+        let signed = send(signRequest())
+
+        XCTAssertNotNil(try signed.result?.get())
+        XCTAssertEqual(3, signed.task.attempts)
+    }
+
+    func testDoesNotRetrySigningThatMayHaveReachedTheServer() {
+        let failures: [MockTAKServer.Reply] = [
+            .failure(.timedOut),
+            .failure(.networkConnectionLost),
+            MockTAKServer.text("bad gateway", status: 502),
+            MockTAKServer.text("gateway timeout", status: 504)
+        ]
+        for failure in failures {
+            MockTAKServer.reset()
+            MockTAKServer.reply(to: signPath, with: failure, MockTAKServer.json("{}"))
+
+            let signed = send(signRequest())
+
+            guard case .failure = signed.result else {
+                return XCTFail("Expected \(failure) to fail, got \(String(describing: signed.result))")
+            }
+            XCTAssertEqual(1, signed.task.attempts)
+            XCTAssertEqual(1, MockTAKServer.requests.count)
+        }
+    }
+
+    func testGivesUpAfterMaxAttempts() {
+        MockTAKServer.reply(to: configPath, with: MockTAKServer.text("busy", status: 503))
+
+        let sent = send(configPath)
+
+        guard case .failure(.httpStatus(503, _, _)) = sent.result else {
+            return XCTFail("Expected a 503, got \(String(describing: sent.result))")
+        }
+        XCTAssertEqual(EnrollmentHTTPClient.MAX_ATTEMPTS, sent.task.attempts)
+        XCTAssertEqual(EnrollmentHTTPClient.MAX_ATTEMPTS, MockTAKServer.requests.count)
+    }
+
+    func testDoesNotRetryPermanentFailures() {
+        MockTAKServer.reply(to: configPath, with: MockTAKServer.text("Unauthorized", status: 401))
+        MockTAKServer.reply(to: signPath, with: .failure(.serverCertificateUntrusted))
+
+        let unauthorized = send(configPath)
+        let untrusted = send(signPath)
+
+        guard case .failure(.httpStatus(401, _, _)) = unauthorized.result,
+              case .failure(.transport(let urlError)) = untrusted.result else {
+            return XCTFail("Unexpected results \(String(describing: unauthorized.result)), \(String(describing: untrusted.result))")
+        }
+        XCTAssertEqual(.serverCertificateUntrusted, urlError.code)
+        XCTAssertEqual(1, unauthorized.task.attempts)
+        XCTAssertEqual(1, untrusted.task.attempts)
+    }
+
+    func testStatusFailuresKeepTheServerResponseForLogging() {
+        SettingsStore.global.takServerUrl = "tak.example.com"
+        MockTAKServer.reply(to: configPath, with: MockTAKServer.text("Bad credentials", status: 401))
+
+        let requestor = CSRRequestor()
+        requestor.httpClient = client
+        requestor.beginEnrollment()
+        let failed = expectation(for: NSPredicate { _, _ in requestor.enrollmentStatus == .Failed }, evaluatedWith: nil)
+        wait(for: [failed], timeout: 5.0)
+
+        XCTAssertTrue(requestor.config.didError)
+        XCTAssertNil(requestor.config.error)
+        XCTAssertEqual(401, (requestor.config.response as? HTTPURLResponse)?.statusCode)
+        XCTAssertEqual(Data("Bad credentials".utf8), requestor.config.responseData)
+    }
+
+    func testCancelInFlight() {
+        MockTAKServer.reply(to: configPath, with: .noReply)
+        let finished = expectation(description: "request finished")
+        var result: EnrollmentHTTPResult?
+
+        let task = client.send(request(configPath)) {
+            result = $0
+            finished.fulfill()
+        }
+        task.cancel()
+        wait(for: [finished], timeout: 5.0)
+
+        guard case .failure(.cancelled) = result else {
+            return XCTFail("Expected cancelled, got \(String(describing: result))")
+        }
+    }
+
+    func testCancelWhileWaitingToRetry() {
+        client = EnrollmentHTTPClient(configuration: MockTAKServer.configuration(), retryBaseDelay: 30.0)
+        MockTAKServer.reply(to: configPath, with: MockTAKServer.text("busy", status: 503))
+        let finished = expectation(description: "request finished")
+        var result: EnrollmentHTTPResult?
+
+        let task = client.send(request(configPath)) {
+            result = $0
+            finished.fulfill()
+        }
+        let firstAttempt = expectation(for: NSPredicate { _, _ in MockTAKServer.requests.count == 1 }, evaluatedWith: nil)
+        wait(for: [firstAttempt], timeout: 5.0)
+        DispatchQueue.main.async {
+            task.cancel()
+        }
+        wait(for: [finished], timeout: 5.0)
+
+        guard case .failure(.cancelled) = result else {
+            return XCTFail("Expected cancelled, got \(String(describing: result))")
+        }
+        XCTAssertEqual(1, MockTAKServer.requests.count)
+    }
+
+    func testEnrollmentAgainstStandIn() throws {
+        SettingsStore.global.takServerUrl = "tak.example.com"
+        SettingsStore.global.takServerUsername = "foyc"
+        SettingsStore.global.takServerPassword = "atakatak"
+        SettingsStore.global.enrollmentKeyType = CertificateKeyType.ecdsaP256.rawValue
+        MockTAKServer.reply(to: configPath, with: MockTAKServer.text(caConfig))
+        MockTAKServer.reply(to: signPath, with: MockTAKServer.json("{}"))
+
+        let requestor = CSRRequestor()
+        requestor.httpClient = client
+        requestor.beginEnrollment()
+        let signed = expectation(for: NSPredicate { _, _ in MockTAKServer.requests.count == 2 }, evaluatedWith: nil)
+        wait(for: [signed], timeout: 10.0)
+
+        let requests = MockTAKServer.requests
+        XCTAssertEqual(["GET", "POST"], requests.map { $0.method })
+        XCTAssertEqual([configPath, signPath], requests.map { $0.path })
+        XCTAssertEqual(requestor.generateAuthHeaderString(), requests[0].headers["Authorization"])
+        let der = try XCTUnwrap(Data(base64Encoded: requests[1].body))
+        let csr = try CertificateSigningRequest(derEncoded: Array(der))
+        XCTAssertEqual(.ecdsaWithSHA256, csr.signatureAlgorithm)
+        XCTAssertTrue(csr.subject.description.contains("O=FLIGHTTACTICS"))
+        XCTAssertEqual("TAK", requestor.config.orgUnitName)
+    }
+}
@@ -0,0 +1,80 @@
+//
+//  GeoChatParserTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import XCTest
+
+final class GeoChatParserTests: TAKTrackerTestCase {
+    // When the ATAK events below were sent
+    let sent = Date(timeIntervalSince1970: 1_700_000_000)
+
+    func testGeneratedChatParsesBack() {
+        let message = ChatFixtures.outgoing(0, text: "Rally at <checkpoint 2> & \"hold\"")
+        let data = Data(GeoChatMessage.generateChatXml(message: message).utf8)
+
+        XCTAssertTrue(GeoChatParser.isChat(data))
+        let parsed = GeoChatParser.parseMessage(data: data, receivedAt: message.dateSent.addingTimeInterval(2))
+        XCTAssertEqual(message.id, parsed?.id)
+        XCTAssertEqual(message.userUId, parsed?.userUId)
+        XCTAssertEqual(message.callSign, parsed?.callSign)
+        XCTAssertEqual(message.message, parsed?.message)
+        XCTAssertEqual(message.createAt, parsed?.createAt)
+        XCTAssertEqual(message.dateSent.addingTimeInterval(2), parsed?.dateReceived)
+    }
+
+    func testParsesATAKChat() {
+        let chat = """
+        <?xml version='1.0' encoding='UTF-8' standalone='yes'?>
+        <event version='2.0' uid='GeoChat.ANDROID-99.All Chat Rooms.4d2f' type='b-t-f' time='2023-11-14T22:13:20.000Z' start='2023-11-14T22:13:20.000Z' stale='2023-11-15T22:13:20.000Z' how='h-g-i-g-o'>
+          <point lat='38.9' lon='-77.0' hae='9999999.0' ce='9999999.0' le='9999999.0'/>
+          <detail>
+            <__chat parent='RootContactGroup' groupOwner='false' messageId='4d2f' chatroom='All Chat Rooms' id='All Chat Rooms' senderCallsign='HAMMER'>
+              <chatgrp uid0='ANDROID-99' uid1='All Chat Rooms' id='All Chat Rooms'/>
+            </__chat>
+            <link uid='ANDROID-99' type='a-f-G-U-C' relation='p-p'/>
+            <remarks source='BAO.F.ATAK.ANDROID-99' to='All Chat Rooms' time='2023-11-14T22:13:20.000Z'>on my way</remarks>
+          </detail>
+        </event>
+        """
+        let data = Data(chat.utf8)
+        XCTAssertTrue(GeoChatParser.isChat(data))
+        let parsed = GeoChatParser.parseMessage(data: data)
+        XCTAssertEqual("4d2f", parsed?.id)
+        XCTAssertEqual("ANDROID-99", parsed?.userUId)
+        XCTAssertEqual("HAMMER", parsed?.callSign)
+        XCTAssertEqual("on my way", parsed?.message)
+        XCTAssertEqual(sent, parsed?.createAt)
+        XCTAssertFalse(parsed?.isFromCurrentUser() ?? true)
+    }
+
+    func testReceiptsAndPositionsAreNotChat() {
+        let receipt = Data("<event uid='x' type='b-t-f-d' time='2023-11-14T22:13:20Z'><detail/></event>".utf8)
+        let position = Data("<event uid='x' type='a-f-G-U-C' time='2023-11-14T22:13:20Z'><point lat='1' lon='2'/></event>".utf8)
+        XCTAssertFalse(GeoChatParser.isChat(receipt))
+        XCTAssertFalse(GeoChatParser.isChat(position))
+    }
+
+    func testParsesReceipts() {
+        let delivered = """
+        <event version='2.0' uid='4d2f' type='b-t-f-d' time='2023-11-14T22:13:20.000Z' start='2023-11-14T22:13:20.000Z' stale='2023-11-15T22:13:20.000Z' how='h-g-i-g-o'>
+          <point lat='0.0' lon='0.0' hae='9999999.0' ce='9999999.0' le='9999999.0'/>
+          <detail>
+            <__chatreceipt parent='RootContactGroup' groupOwner='false' messageId='4d2f' chatroom='HAMMER' id='ANDROID-99' senderCallsign='HAMMER'>
+              <chatgrp uid0='ANDROID-99' uid1='ANDROID-1234' id='ANDROID-99'/>
+            </__chatreceipt>
+          </detail>
+        </event>
+        """
+        let read = "<event uid='9a1c' type='b-t-f-r' time='2023-11-14T22:13:20Z'><detail/></event>"
+
+        XCTAssertTrue(GeoChatParser.isReceipt(Data(delivered.utf8)))
+        XCTAssertFalse(GeoChatParser.isChat(Data(delivered.utf8)))
+        XCTAssertEqual(ChatDeliveryUpdate(id: "4d2f", status: .delivered), GeoChatParser.parseReceipt(data: Data(delivered.utf8)))
+        XCTAssertEqual(ChatDeliveryUpdate(id: "9a1c", status: .read), GeoChatParser.parseReceipt(data: Data(read.utf8)))
+        XCTAssertNil(GeoChatParser.parseReceipt(data: Data(GeoChatMessage.generateChatXml(message: ChatFixtures.outgoing(0, text: "hi")).utf8)))
+    }
+}
@@ -0,0 +1,191 @@
+//
+//  GeofenceEngineTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import sf_ios
+import XCTest
+
+final class GeofenceEngineTests: TAKTrackerTestCase {
+    // Irregular star-shaped ring around a center, in degrees
+    func starRing(centerX: Double, centerY: Double, radius: Double, vertices: Int, generator: inout SeededGenerator) -> [(x: Double, y: Double)] {
+        return (0..<vertices).map { index in
+            let angle = Double(index) / Double(vertices) * 2.0 * Double.pi
+            let r = radius * Double.random(in: 0.4...1.0, using: &generator)
+            return (centerX + r * cos(angle), centerY + r * sin(angle))
+        }
+    }
+
+    func square(_ minX: Double, _ minY: Double, _ size: Double) -> [(x: Double, y: Double)] {
+        return [(minX, minY), (minX + size, minY), (minX + size, minY + size), (minX, minY + size), (minX, minY)]
+    }
+
+    // Plain even-odd ray cast over every edge, for comparison
+    func naiveContains(_ rings: [[(x: Double, y: Double)]], x: Double, y: Double) -> Bool {
+        var inside = false
+        for ring in rings {
+            for index in 0..<ring.count {
+                let a = ring[index]
+                let b = ring[(index + 1) % ring.count]
+                if((a.y > y) != (b.y > y) && x < a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y)) {
+                    inside.toggle()
+                }
+            }
+        }
+        return inside
+    }
+
+    func testPreparedPolygonMatchesNaiveRayCast() {
+        var generator = SeededGenerator(seed: 1)
+        let outer = starRing(centerX: -77.0, centerY: 38.9, radius: 0.1, vertices: 200, generator: &generator)
+        let hole = square(-77.01, 38.89, 0.02)
+        let prepared = PreparedPolygon(rings: [outer, hole])
+
+        for _ in 0..<5_000 {
+            let x = Double.random(in: -77.12 ... -76.88, using: &generator)
+            let y = Double.random(in: 38.78...39.02, using: &generator)
+            XCTAssertEqual(naiveContains([outer, hole], x: x, y: y), prepared.contains(x: x, y: y))
+        }
+        XCTAssertFalse(prepared.contains(x: -77.0, y: 38.9))
+    }
+
+    func testPreparesSFPolygon() {
+        let ring = SFLineString()
+        for vertex in square(-77.1, 38.8, 0.2) {
+            ring.addPoint(SFPoint(xValue: vertex.x, andYValue: vertex.y))
+        }
+        let prepared = PreparedPolygon(polygon: SFPolygon(ring: ring))
+        XCTAssertEqual(GeofenceEnvelope(minX: -77.1, minY: 38.8, maxX: -76.9, maxY: 39.0), prepared.envelope)
+        XCTAssertTrue(prepared.contains(x: -77.0, y: 38.9))
+        XCTAssertFalse(prepared.contains(x: -77.2, y: 38.9))
+    }
+
+    func testRTreeFindsEveryContainingEnvelope() {
+        var generator = SeededGenerator(seed: 2)
+        let envelopes: [GeofenceEnvelope] = (0..<1_000).map { _ in
+            let x = Double.random(in: -80 ... -70, using: &generator)
+            let y = Double.random(in: 35...45, using: &generator)
+            return GeofenceEnvelope(minX: x, minY: y, maxX: x + Double.random(in: 0.01...1, using: &generator), maxY: y + Double.random(in: 0.01...1, using: &generator))
+        }
+        let tree = EnvelopeRTree(envelopes: envelopes)
+        for _ in 0..<500 {
+            let x = Double.random(in: -80 ... -69, using: &generator)
+            let y = Double.random(in: 35...46, using: &generator)
+            let expected = Set(envelopes.indices.filter { envelopes[$0].contains(x: x, y: y) })
+            XCTAssertEqual(expected, Set(tree.query(x: x, y: y)))
+        }
+    }
+
+    func testTransitionsNeedConsecutiveSamples() {
+        let fence = Geofence(id: "rally", name: "Rally Point", polygon: PreparedPolygon(rings: [square(-77.0, 38.9, 0.01)]))
+        var engine = GeofenceEngine(fences: [fence], hysteresisSamples: 2)
+
+        XCTAssertTrue(engine.update(subject: "self", latitude: 38.905, longitude: -76.995).isEmpty)
+        // A single sample back outside is just jitter
+        XCTAssertTrue(engine.update(subject: "self", latitude: 38.85, longitude: -76.995).isEmpty)
+        XCTAssertTrue(engine.update(subject: "self", latitude: 38.905, longitude: -76.995).isEmpty)
+        XCTAssertEqual(
+            [GeofenceEvent(subject: "self", fenceID: "rally", transition: .entered)],
+            engine.update(subject: "self", latitude: 38.906, longitude: -76.995)
+        )
+        XCTAssertTrue(engine.isInside(subject: "self", fenceID: "rally"))
+
+        XCTAssertTrue(engine.update(subject: "self", latitude: 38.85, longitude: -76.995).isEmpty)
+        XCTAssertEqual(
+            [GeofenceEvent(subject: "self", fenceID: "rally", transition: .exited)],
+            engine.update(subject: "self", latitude: 38.85, longitude: -76.995)
+        )
+        XCTAssertFalse(engine.isInside(subject: "self", fenceID: "rally"))
+    }
+
+    func testReloadKeepsStateForFencesThatRemain() {
+        let rally = Geofence(id: "rally", name: "Rally Point", polygon: PreparedPolygon(rings: [square(-77.0, 38.9, 0.01)]))
+        let landingZone = Geofence(id: "lz", name: "Landing Zone", polygon: PreparedPolygon(rings: [square(-77.0, 38.9, 0.02)]))
+        var engine = GeofenceEngine(fences: [landingZone, rally], hysteresisSamples: 1)
+        XCTAssertEqual(2, engine.update(subject: "self", latitude: 38.905, longitude: -76.995).count)
+
+        // Same rally point, now at another index, and the landing zone removed
+        let overlay = Geofence(id: "overlay", name: "Overlay", polygon: PreparedPolygon(rings: [square(-76.0, 38.0, 0.01)]))
+        engine.setFences([overlay, rally])
+
+        XCTAssertTrue(engine.update(subject: "self", latitude: 38.905, longitude: -76.995).isEmpty)
+        XCTAssertTrue(engine.isInside(subject: "self", fenceID: "rally"))
+        XCTAssertFalse(engine.isInside(subject: "self", fenceID: "lz"))
+        XCTAssertEqual(
+            [GeofenceEvent(subject: "self", fenceID: "rally", transition: .exited)],
+            engine.update(subject: "self", latitude: 38.85, longitude: -76.995)
+        )
+    }
+
+    func testFencesFromKMLPlacemarks() {
+        let kml = """
+        <?xml version="1.0" encoding="UTF-8"?>
+        <kml xmlns="http://www.opengis.net/kml/2.2">
+        <Document>
+          <Placemark id="boundary">
+            <name>Boundary</name>
+            <Polygon>
+              <outerBoundaryIs><LinearRing><coordinates>
+                -80.0,35.0,0 -79.0,35.0,0 -79.0,36.0,0 -80.0,36.0,0 -80.0,35.0,0
+              </coordinates></LinearRing></outerBoundaryIs>
+              <innerBoundaryIs><LinearRing><coordinates>
+                -79.6,35.4 -79.4,35.4 -79.4,35.6 -79.6,35.6 -79.6,35.4
+              </coordinates></LinearRing></innerBoundaryIs>
+            </Polygon>
+          </Placemark>
+          <Placemark>
+            <name>Route</name>
+            <LineString><coordinates>-78.5,34.5 -78.0,34.75 -77.5,34.6</coordinates></LineString>
+          </Placemark>
+          <Placemark id="islands">
+            <name>Islands</name>
+            <MultiGeometry>
+              <Polygon><outerBoundaryIs><LinearRing><coordinates>
+                0,0 1,0 1,1 0,1 0,0
+              </coordinates></LinearRing></outerBoundaryIs></Polygon>
+              <Polygon><outerBoundaryIs><LinearRing><coordinates>
+                2,2 3,2 3,3 2,3 2,2
+              </coordinates></LinearRing></outerBoundaryIs></Polygon>
+            </MultiGeometry>
+          </Placemark>
+        </Document>
+        </kml>
+        """
+        let fences = Geofence.fences(from: KMLParser.parse(data: Data(kml.utf8)))
+        XCTAssertEqual(["boundary", "islands"], fences.map { $0.id })
+        XCTAssertEqual(["Boundary", "Islands"], fences.map { $0.name })
+
+        let engine = GeofenceEngine(fences: fences)
+        XCTAssertEqual([0], engine.fences(containingLatitude: 35.2, longitude: -79.8))
+        // In the hole
+        XCTAssertEqual([], engine.fences(containingLatitude: 35.5, longitude: -79.5))
+        XCTAssertEqual([1], engine.fences(containingLatitude: 0.5, longitude: 0.5))
+        XCTAssertEqual([1], engine.fences(containingLatitude: 2.5, longitude: 2.5))
+        XCTAssertEqual([], engine.fences(containingLatitude: 1.5, longitude: 1.5))
+    }
+
+    // 10k contacts against 500 fences, one 1 Hz evaluation per iteration
+    func testTenThousandContactsAgainstFiveHundredFences() {
+        var generator = SeededGenerator(seed: 3)
+        let fences: [Geofence] = (0..<500).map { index in
+            let ring = starRing(centerX: Double.random(in: -78 ... -76, using: &generator), centerY: Double.random(in: 38...40, using: &generator), radius: 0.05, vertices: 64, generator: &generator)
+            return Geofence(id: "fence-\(index)", name: "Fence \(index)", polygon: PreparedPolygon(rings: [ring]))
+        }
+        let contacts: [(Double, Double)] = (0..<10_000).map { _ in
+            (Double.random(in: 38...40, using: &generator), Double.random(in: -78 ... -76, using: &generator))
+        }
+        var engine = GeofenceEngine(fences: fences)
+        var events: [GeofenceEvent] = []
+        var offset = 0.0
+        measure {
+            offset += 0.001
+            for (index, contact) in contacts.enumerated() {
+                engine.update(subject: "contact-\(index)", latitude: contact.0 + offset, longitude: contact.1, events: &events)
+            }
+        }
+        XCTAssertFalse(events.isEmpty)
+    }
+}
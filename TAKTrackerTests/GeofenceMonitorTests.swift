@@ -0,0 +1,117 @@
+//
+//  GeofenceMonitorTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Combine
+import CoreLocation
+import Foundation
+import XCTest
+
+final class GeofenceMonitorTests: TAKTrackerTestCase {
+    var cancellables = Set<AnyCancellable>()
+
+    override func tearDownWithError() throws {
+        cancellables.removeAll()
+    }
+
+    let fence = Geofence(id: "rally", name: "Rally Point", polygon: PreparedPolygon(rings: [[(-77.0, 38.8), (-76.9, 38.8), (-76.9, 38.9), (-77.0, 38.9)]]))
+
+    func location(latitude: Double, longitude: Double, second: Double) -> CLLocation {
+        return CLLocation(
+            coordinate: CLLocationCoordinate2D(latitude: latitude, longitude: longitude),
+            altitude: 0,
+            horizontalAccuracy: 5,
+            verticalAccuracy: 5,
+            timestamp: Date(timeIntervalSince1970: second)
+        )
+    }
+
+    func contact(uid: String, callsign: String, latitude: Double, longitude: Double) -> ContactRecord {
+        let now = Date()
+        return ContactRecord(uid: uid, type: "a-f-G-U-C", callsign: callsign, group: "Cyan", role: "Team Member", latitude: latitude, longitude: longitude, heightAboveEllipsoid: 0, speed: 0, course: 0, time: now, stale: now.addingTimeInterval(600))
+    }
+
+    func testReportsOurOwnPositionFromLocationUpdates() {
+        let source = LocationReplaySource(locations: [
+            location(latitude: 38.7, longitude: -77.1, second: 0),
+            location(latitude: 38.85, longitude: -76.95, second: 1)
+        ])
+        let monitor = GeofenceMonitor()
+        let entered = expectation(description: "Entered the fence")
+        monitor.alerts.sink { alert in
+            XCTAssertTrue(alert.isSelf)
+            XCTAssertEqual(.entered, alert.event.transition)
+            XCTAssertEqual("Rally Point", alert.fenceName)
+            XCTAssertEqual("\(SettingsStore.global.callSign) entered Rally Point", alert.message)
+            entered.fulfill()
+        }.store(in: &cancellables)
+
+        monitor.setFences([fence])
+        source.advance(by: 0)
+        monitor.start(contactStore: ContactStore(), locationSource: source)
+        // Only updates that arrive after start move us into the fence
+        source.advance(by: 1)
+
+        wait(for: [entered], timeout: 5.0)
+        monitor.stop()
+    }
+
+    func testNamesContactsByCallsign() {
+        let store = ContactStore()
+        store.upsert(contact(uid: "alpha", callsign: "ALPHA", latitude: 38.85, longitude: -76.95))
+        store.upsert(contact(uid: "bravo", callsign: "BRAVO", latitude: 38.7, longitude: -77.1))
+        let monitor = GeofenceMonitor()
+        let entered = expectation(description: "Contact entered the fence")
+        monitor.alerts.sink { alert in
+            XCTAssertFalse(alert.isSelf)
+            XCTAssertEqual("alpha", alert.event.subject)
+            XCTAssertEqual("ALPHA entered Rally Point", alert.message)
+            entered.fulfill()
+        }.store(in: &cancellables)
+
+        monitor.setFences([fence])
+        monitor.start(contactStore: store, locationSource: LocationReplaySource(locations: []))
+
+        wait(for: [entered], timeout: 5.0)
+        monitor.stop()
+    }
+
+    func testLoadsFencesWhenADataPackageIsImported() throws {
+        let root = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+        defer { try? FileManager.default.removeItem(at: root) }
+        let fenceStore = DataPackageContentStore(rootURL: root)
+        let contactStore = ContactStore()
+        contactStore.upsert(contact(uid: "alpha", callsign: "ALPHA", latitude: 38.85, longitude: -76.95))
+
+        let monitor = GeofenceMonitor()
+        let entered = expectation(description: "Contact entered the imported fence")
+        monitor.alerts.sink { alert in
+            XCTAssertEqual("ALPHA entered Imported Rally Point", alert.message)
+            entered.fulfill()
+        }.store(in: &cancellables)
+        monitor.start(contactStore: contactStore, locationSource: LocationReplaySource(locations: []), fenceStore: fenceStore)
+
+        let kml = """
+        <?xml version="1.0" encoding="UTF-8"?>
+        <kml xmlns="http://www.opengis.net/kml/2.2"><Document><Placemark id="imported-rally">
+          <name>Imported Rally Point</name>
+          <Polygon><outerBoundaryIs><LinearRing><coordinates>
+            -77.0,38.8 -76.9,38.8 -76.9,38.9 -77.0,38.9 -77.0,38.8
+          </coordinates></LinearRing></outerBoundaryIs></Polygon>
+        </Placemark></Document></kml>
+        """
+        let staging = fenceStore.stagingDirectory(uid: "fences")
+        try FileManager.default.createDirectory(at: staging, withIntermediateDirectories: true)
+        try Data(kml.utf8).write(to: staging.appendingPathComponent("fences.kml"))
+        try fenceStore.commit(DataPackageContentIndex(uid: "fences", name: "Fences", importedAt: Date(), entries: [
+            DataPackageContentEntry(path: "fences.kml", storedPath: "fences.kml", type: .kml, size: UInt64(kml.utf8.count), sha256: "")
+        ]))
+        XCTAssertEqual(["imported-rally"], Geofence.fences(from: fenceStore).map { $0.id })
+
+        wait(for: [entered], timeout: 5.0)
+        monitor.stop()
+    }
+}
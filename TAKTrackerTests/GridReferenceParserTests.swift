@@ -0,0 +1,210 @@
+//
+//  GridReferenceParserTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import grid_ios
+import mgrs_ios
+import XCTest
+
+final class GridReferenceParserTests: TAKTrackerTestCase {
+
+    func randomMGRS(count: Int, seed: UInt64) -> [String] {
+        var generator = SeededGenerator(seed: seed)
+        return (0..<count).map { _ in
+            let reference = MGRSEncoder.string(latitude: Double.random(in: -80.0...84.0, using: &generator), longitude: Double.random(in: -180.0...180.0, using: &generator))
+            // Every precision from 10km down to 1m
+            let precision = Int.random(in: 1...5, using: &generator)
+            let parts = reference.split(separator: " ")
+            return "\(parts[0]) \(parts[1]) \(parts[2].prefix(precision)) \(parts[3].prefix(precision))"
+        }
+    }
+
+    func randomUTM(count: Int, seed: UInt64) -> [String] {
+        var generator = SeededGenerator(seed: seed)
+        return (0..<count).map { _ in
+            let zone = Int.random(in: 1...60, using: &generator)
+            let utm = UTMProjection.forward(latitude: Double.random(in: -80.0...84.0, using: &generator),
+                                            longitude: UTMProjection.centralMeridian(zone: zone) + Double.random(in: -3.0...3.0, using: &generator),
+                                            zone: zone)
+            return String(format: "%d%@ %.2f %.2f", utm.zone, utm.isNorthern ? "N" : "S", utm.easting, utm.northing)
+        }
+    }
+
+    func assertMatchesMGRSParse(_ text: String, file: StaticString = #filePath, line: UInt = #line) {
+        let expected = MGRS.parse(text)
+        guard let actual = GridReferenceParser.mgrs(text) else {
+            XCTFail("Unable to parse \(text)", file: file, line: line)
+            return
+        }
+        XCTAssertEqual(expected.zone, actual.zone, text, file: file, line: line)
+        XCTAssertEqual(String(expected.band), String(decoding: [actual.band], as: UTF8.self), text, file: file, line: line)
+        XCTAssertEqual(String(expected.column), actual.column.map { String(decoding: [$0], as: UTF8.self) }, text, file: file, line: line)
+        XCTAssertEqual(String(expected.row), actual.row.map { String(decoding: [$0], as: UTF8.self) }, text, file: file, line: line)
+        XCTAssertEqual(expected.easting, actual.easting, text, file: file, line: line)
+        XCTAssertEqual(expected.northing, actual.northing, text, file: file, line: line)
+    }
+
+    func testParsesMGRS() throws {
+        let reference = try GridReferenceParser.parseMGRS("18S UJ 26938 05973")
+        XCTAssertEqual(MGRSReference(zone: 18, band: UInt8(ascii: "S"), column: UInt8(ascii: "U"), row: UInt8(ascii: "J"), easting: 26938, northing: 5973, precision: 5), reference)
+        XCTAssertEqual(reference, GridReferenceParser.mgrs("18suj2693805973"))
+        XCTAssertEqual(reference, GridReferenceParser.mgrs(" 1 8 S\tUJ 26938\n05973 "))
+    }
+
+    func testParsesMGRSPrecisions() throws {
+        XCTAssertEqual(23000, try GridReferenceParser.parseMGRS("18SUJ2305").easting)
+        XCTAssertEqual(5000, try GridReferenceParser.parseMGRS("18SUJ2305").northing)
+        XCTAssertEqual(2, try GridReferenceParser.parseMGRS("18SUJ2305").precision)
+        XCTAssertEqual(90000, try GridReferenceParser.parseMGRS("4QFJ91").easting)
+        XCTAssertEqual(10000, try GridReferenceParser.parseMGRS("4QFJ91").northing)
+
+        let square = try GridReferenceParser.parseMGRS("18SUJ")
+        XCTAssertEqual(0, square.precision)
+        XCTAssertEqual(UInt8(ascii: "U"), square.column)
+
+        let zone = try GridReferenceParser.parseMGRS("31X")
+        XCTAssertNil(zone.column)
+        XCTAssertNil(zone.row)
+        XCTAssertEqual(31, zone.zone)
+    }
+
+    func testMGRSMatchesMGRSParse() {
+        for text in randomMGRS(count: 5_000, seed: 31) {
+            assertMatchesMGRSParse(text)
+            assertMatchesMGRSParse(text.lowercased())
+            assertMatchesMGRSParse(text.replacingOccurrences(of: " ", with: ""))
+        }
+    }
+
+    func testRejectsInvalidMGRS() {
+        let cases: [(String, GridReferenceParseError)] = [
+            ("", .empty),
+            ("   ", .empty),
+            ("S UJ 26938 05973", .invalidZone),
+            ("0S UJ 26938 05973", .invalidZone),
+            ("61S UJ 26938 05973", .invalidZone),
+            ("32X NL 12345 12345", .invalidZone),
+            ("36X", .invalidZone),
+            ("183S UJ 26938 05973", .invalidBand),
+            ("18I UJ 26938 05973", .invalidBand),
+            ("18Y UJ 26938 05973", .invalidBand),
+            ("18", .invalidBand),
+            ("18S OJ 26938 05973", .invalidSquare),
+            ("18S UW 26938 05973", .invalidSquare),
+            ("18S U", .invalidSquare),
+            ("18S UJ 26938 0597", .invalidDigits),
+            ("18S UJ 269380 059730", .invalidDigits),
+            ("18S UJ 26938-05973", .unexpectedCharacter(offset: 12)),
+            ("18S UJ 26938 05973é", .unexpectedCharacter(offset: 18))
+        ]
+        for (text, error) in cases {
+            XCTAssertThrowsError(try GridReferenceParser.parseMGRS(text), text) { thrown in
+                XCTAssertEqual(error, thrown as? GridReferenceParseError, text)
+            }
+            XCTAssertNil(GridReferenceParser.mgrs(text))
+        }
+    }
+
+    func testAgreesWithIsMGRS() {
+        // Zones 1-60 only; MGRS.isMGRS passes zone 0 and 61+ and parse then traps
+        let texts = ["18S UJ 26938 05973", "18SUJ2693805973", "18suj", "18S", "31X", "33X EG 123 456",
+                     "32X", "34X AB", "18S UJ 2693 05973", "18S IJ 26938 05973", "18 UJ 26938 05973",
+                     "18S UJ 26938 05973 1", "18S UJ 26938 0597A", "18S UJ 26938 05973 00"]
+        for text in texts {
+            XCTAssertEqual(MGRS.isMGRS(text), GridReferenceParser.mgrs(text) != nil, text)
+        }
+    }
+
+    func testParsesUTM() throws {
+        XCTAssertEqual(UTMCoordinate(zone: 18, isNorthern: true, easting: 326938.11, northing: 4305973.74), try GridReferenceParser.parseUTM("18N 326938.11 4305973.74"))
+        XCTAssertEqual(UTMCoordinate(zone: 18, isNorthern: true, easting: 326938, northing: 4305973), GridReferenceParser.utm("18n326938 4305973"))
+        XCTAssertEqual(UTMCoordinate(zone: 1, isNorthern: false, easting: 500000, northing: 10000000), GridReferenceParser.utm("  1 S 500000. 10000000\n"))
+        XCTAssertEqual(123456.123456789012345678, GridReferenceParser.utm("1N 123456.123456789012345678 0")?.easting)
+    }
+
+    func testUTMMatchesUTMParse() {
+        for text in randomUTM(count: 5_000, seed: 32) {
+            let expected = UTM.parse(text)
+            guard let actual = GridReferenceParser.utm(text) else {
+                XCTFail("Unable to parse \(text)")
+                continue
+            }
+            XCTAssertEqual(expected.zone, actual.zone, text)
+            XCTAssertEqual(expected.hemisphere == Hemisphere.NORTH, actual.isNorthern, text)
+            XCTAssertEqual(expected.easting, actual.easting, text)
+            XCTAssertEqual(expected.northing, actual.northing, text)
+        }
+    }
+
+    func testRejectsInvalidUTM() {
+        let cases: [(String, GridReferenceParseError)] = [
+            ("", .empty),
+            ("N 326938 4305973", .invalidZone),
+            ("0N 326938 4305973", .invalidZone),
+            ("61N 326938 4305973", .invalidZone),
+            ("118N 326938 4305973", .invalidZone),
+            ("18E 326938 4305973", .invalidHemisphere),
+            ("18", .invalidHemisphere),
+            ("18N", .invalidNumber),
+            ("18N 326938", .invalidNumber),
+            ("18N .5 4305973", .invalidNumber),
+            ("18N 326938,4305973", .unexpectedCharacter(offset: 10)),
+            ("18N 326938 4305973 12", .unexpectedCharacter(offset: 18)),
+            ("18N 326938.1.2 4305973", .unexpectedCharacter(offset: 12))
+        ]
+        for (text, error) in cases {
+            XCTAssertThrowsError(try GridReferenceParser.parseUTM(text), text) { thrown in
+                XCTAssertEqual(error, thrown as? GridReferenceParseError, text)
+            }
+            XCTAssertNil(GridReferenceParser.utm(text))
+        }
+    }
+
+    func testBulkParsing() {
+        let results = GridReferenceParser.parseMGRS(["18S UJ 26938 05973", "nonsense", "4Q FJ 1 9"])
+        XCTAssertEqual(3, results.count)
+        XCTAssertEqual(26938, try results[0].get().easting)
+        XCTAssertEqual(.failure(.invalidZone), results[1])
+        XCTAssertEqual(90000, try results[2].get().northing)
+
+        let utms = GridReferenceParser.parseUTM(randomUTM(count: 100, seed: 33) + ["18X 1 2"])
+        XCTAssertEqual(101, utms.count)
+        XCTAssertEqual(100, utms.filter { (try? $0.get()) != nil }.count)
+        XCTAssertEqual(.failure(.invalidHemisphere), utms.last)
+    }
+
+    func testMGRSParsePerformance() {
+        let texts = randomMGRS(count: 10_000, seed: 34)
+        measure {
+            for text in texts {
+                _ = MGRS.parse(text)
+            }
+        }
+    }
+
+    func testMGRSParserPerformance() {
+        let texts = randomMGRS(count: 10_000, seed: 34)
+        measure {
+            _ = GridReferenceParser.parseMGRS(texts)
+        }
+    }
+
+    func testUTMParsePerformance() {
+        let texts = randomUTM(count: 10_000, seed: 35)
+        measure {
+            for text in texts {
+                _ = UTM.parse(text)
+            }
+        }
+    }
+
+    func testUTMParserPerformance() {
+        let texts = randomUTM(count: 10_000, seed: 35)
+        measure {
+            _ = GridReferenceParser.parseUTM(texts)
+        }
+    }
+}
@@ -0,0 +1,148 @@
+//
+//  GridZoneTableTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import grid_ios
+import mgrs_ios
+import XCTest
+
+final class GridZoneTableTests: TAKTrackerTestCase {
+
+    func letter(_ byte: UInt8) -> Character {
+        return Character(UnicodeScalar(byte))
+    }
+
+    func randomBounds(count: Int, seed: UInt64) -> [CoordinateBounds] {
+        var generator = SeededGenerator(seed: seed)
+        return (0..<count).map { _ in
+            let south = Double.random(in: -80.0...80.0, using: &generator)
+            let west = Double.random(in: -180.0...170.0, using: &generator)
+            return CoordinateBounds(minLatitude: south,
+                                    maxLatitude: min(south + Double.random(in: 0.0...20.0, using: &generator), 84.0),
+                                    minLongitude: west,
+                                    maxLongitude: min(west + Double.random(in: 0.0...30.0, using: &generator), 180.0))
+        }
+    }
+
+    func testMatchesGridZonesOverGlobalSweep() {
+        for latitude in stride(from: -80.0, through: 84.0, by: 0.5) {
+            for longitude in stride(from: -180.0, through: 180.0, by: 0.25) {
+                let gridZone = GridZoneTable.gridZone(latitude: latitude, longitude: longitude)
+                XCTAssertEqual(GridZones.zoneNumber(longitude, latitude), gridZone.zone, "\(latitude), \(longitude)")
+                XCTAssertEqual(GridZones.bandLetter(latitude), letter(gridZone.band), "\(latitude), \(longitude)")
+                XCTAssertEqual(gridZone.zone, GridZoneTable.zoneNumber(latitude: latitude, longitude: longitude))
+            }
+        }
+    }
+
+    func testNorwayAndSvalbard() {
+        XCTAssertEqual(31, GridZoneTable.zoneNumber(latitude: 60.0, longitude: 2.9))
+        XCTAssertEqual(32, GridZoneTable.zoneNumber(latitude: 60.0, longitude: 3.0))
+        XCTAssertEqual(32, GridZoneTable.zoneNumber(latitude: 60.0, longitude: 11.9))
+        XCTAssertEqual(31, GridZoneTable.zoneNumber(latitude: 78.0, longitude: 8.9))
+        XCTAssertEqual(33, GridZoneTable.zoneNumber(latitude: 78.0, longitude: 9.0))
+        XCTAssertEqual(35, GridZoneTable.zoneNumber(latitude: 78.0, longitude: 21.0))
+        XCTAssertEqual(37, GridZoneTable.zoneNumber(latitude: 78.0, longitude: 33.0))
+        XCTAssertEqual(38, GridZoneTable.zoneNumber(latitude: 78.0, longitude: 42.0))
+
+        for zone in [32, 34, 36] {
+            XCTAssertFalse(GridZoneTable.contains(GridZoneID(zone: zone, bandIndex: GridZoneTable.SVALBARD_BAND_INDEX)))
+            XCTAssertNil(GridZoneTable.bounds(of: GridZoneID(zone: zone, bandIndex: GridZoneTable.SVALBARD_BAND_INDEX)))
+        }
+        XCTAssertFalse(GridZoneTable.contains(GridZoneID(zone: 0, bandIndex: 0)))
+        XCTAssertFalse(GridZoneTable.contains(GridZoneID(zone: 61, bandIndex: 0)))
+    }
+
+    func testBoundsMatchGridZones() {
+        for zone in 1...GridZoneTable.ZONE_COUNT {
+            for bandIndex in 0..<GridZoneTable.BAND_COUNT {
+                let id = GridZoneID(zone: zone, bandIndex: bandIndex)
+                let expected = GridZones.gridZone(zone, letter(id.band))
+                let actual = GridZoneTable.bounds(of: id)
+                XCTAssertEqual(expected == nil, actual == nil, "\(zone)\(letter(id.band))")
+                guard let expected = expected?.bounds, let actual = actual else { continue }
+                XCTAssertEqual(expected.west, actual.minLongitude, "\(zone)\(letter(id.band))")
+                XCTAssertEqual(expected.east, actual.maxLongitude, "\(zone)\(letter(id.band))")
+                XCTAssertEqual(expected.south, actual.minLatitude, "\(zone)\(letter(id.band))")
+                XCTAssertEqual(expected.north, actual.maxLatitude, "\(zone)\(letter(id.band))")
+            }
+        }
+    }
+
+    func testRangeMatchesGridZonesZones() {
+        for bounds in randomBounds(count: 500, seed: 41) {
+            let actual = Set(GridZoneTable.gridZones(in: bounds).map { "\($0.zone)\(letter($0.band))" })
+            // GridZones.zones also hands back zones next to the bounds
+            // when a Norway or Svalbard zone is involved
+            let expected = Set(GridZones.zones(Bounds.degrees(bounds.minLongitude, bounds.minLatitude, bounds.maxLongitude, bounds.maxLatitude))
+                .filter { zone in
+                    zone.bounds.west <= bounds.maxLongitude && zone.bounds.east >= bounds.minLongitude
+                        && zone.bounds.south <= bounds.maxLatitude && zone.bounds.north >= bounds.minLatitude
+                }
+                .map { $0.name() })
+            XCTAssertEqual(expected, actual, "\(bounds)")
+        }
+    }
+
+    func testRangeAcrossAntimeridian() {
+        let bounds = CoordinateBounds(minLatitude: -10.0, maxLatitude: -5.0, minLongitude: 175.0, maxLongitude: -175.0)
+        let zones = Array(GridZoneTable.gridZones(in: bounds))
+        XCTAssertEqual([60, 1, 60, 1], zones.map { $0.zone })
+        XCTAssertEqual(["L", "L", "M", "M"], zones.map { String(letter($0.band)) })
+    }
+
+    func testRangeOverNorwayAndSvalbard() {
+        let norway = Array(GridZoneTable.gridZones(in: CoordinateBounds(minLatitude: 60.0, maxLatitude: 61.0, minLongitude: 3.5, maxLongitude: 4.0)))
+        XCTAssertEqual([GridZoneID(zone: 32, bandIndex: GridZoneTable.NORWAY_BAND_INDEX)], norway)
+
+        let svalbard = Array(GridZoneTable.gridZones(in: CoordinateBounds(minLatitude: 78.0, maxLatitude: 79.0, minLongitude: 10.0, maxLongitude: 22.0)))
+        XCTAssertEqual([33, 35], svalbard.map { $0.zone })
+
+        let world = Array(GridZoneTable.gridZones(in: CoordinateBounds(minLatitude: -80.0, maxLatitude: 84.0, minLongitude: -180.0, maxLongitude: 180.0)))
+        XCTAssertEqual(60 * 20 - 3, world.count)
+    }
+
+    func testGridZonesLookupPerformance() {
+        var generator = SeededGenerator(seed: 42)
+        let coordinates = (0..<10_000).map { _ in (Double.random(in: -80.0...84.0, using: &generator), Double.random(in: -180.0...180.0, using: &generator)) }
+        measure {
+            for (latitude, longitude) in coordinates {
+                _ = GridZones.zoneNumber(longitude, latitude)
+                _ = GridZones.bandLetter(latitude)
+            }
+        }
+    }
+
+    func testTableLookupPerformance() {
+        var generator = SeededGenerator(seed: 42)
+        let coordinates = (0..<10_000).map { _ in (Double.random(in: -80.0...84.0, using: &generator), Double.random(in: -180.0...180.0, using: &generator)) }
+        measure {
+            for (latitude, longitude) in coordinates {
+                _ = GridZoneTable.gridZone(latitude: latitude, longitude: longitude)
+            }
+        }
+    }
+
+    func testGridZonesRangePerformance() {
+        let bounds = randomBounds(count: 1_000, seed: 43)
+        measure {
+            for bounds in bounds {
+                _ = GridZones.zones(Bounds.degrees(bounds.minLongitude, bounds.minLatitude, bounds.maxLongitude, bounds.maxLatitude))
+            }
+        }
+    }
+
+    func testTableRangePerformance() {
+        let bounds = randomBounds(count: 1_000, seed: 43)
+        measure {
+            for bounds in bounds {
+                for gridZone in GridZoneTable.gridZones(in: bounds) {
+                    _ = gridZone
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,96 @@
+//
+//  HeadingSmootherTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import CoreLocation
+import XCTest
+
+final class HeadingSmootherTests: TAKTrackerTestCase {
+
+    func addReading(_ smoother: inout HeadingSmoother, trueHeading: Double, magneticHeading: Double) -> HeadingReading {
+        return smoother.add(trueHeading: trueHeading, magneticHeading: magneticHeading, headingAccuracy: 5, timestamp: Date())
+    }
+
+    func testFirstReadingPassesThrough() {
+        var smoother = HeadingSmoother(smoothingFactor: 0.3)
+        let reading = addReading(&smoother, trueHeading: 90, magneticHeading: 80)
+        XCTAssertEqual(90, reading.trueHeading, accuracy: 0.0001)
+        XCTAssertEqual(80, reading.magneticHeading, accuracy: 0.0001)
+    }
+
+    func testSmoothingAcrossNorthStaysNearNorth() {
+        var smoother = HeadingSmoother(smoothingFactor: 0.5)
+        _ = addReading(&smoother, trueHeading: 359, magneticHeading: 359)
+        let reading = addReading(&smoother, trueHeading: 1, magneticHeading: 1)
+        XCTAssertLessThan(HeadingSmoother.angularDifference(0, reading.trueHeading), 0.01)
+        XCTAssertLessThan(HeadingSmoother.angularDifference(0, reading.magneticHeading), 0.01)
+    }
+
+    func testSmoothingDampsJitter() {
+        var smoother = HeadingSmoother(smoothingFactor: 0.2)
+        _ = addReading(&smoother, trueHeading: 100, magneticHeading: 100)
+        let reading = addReading(&smoother, trueHeading: 120, magneticHeading: 120)
+        XCTAssertGreaterThan(reading.trueHeading, 100)
+        XCTAssertLessThan(reading.trueHeading, 110)
+    }
+
+    func testInvalidTrueHeadingIsPassedThrough() {
+        var smoother = HeadingSmoother()
+        let reading = addReading(&smoother, trueHeading: -1, magneticHeading: 45)
+        XCTAssertFalse(reading.hasTrueHeading)
+        XCTAssertEqual(45, reading.course, accuracy: 0.0001)
+    }
+
+    func testResetDropsHistory() {
+        var smoother = HeadingSmoother(smoothingFactor: 0.1)
+        _ = addReading(&smoother, trueHeading: 0, magneticHeading: 0)
+        smoother.reset()
+        let reading = addReading(&smoother, trueHeading: 90, magneticHeading: 90)
+        XCTAssertEqual(90, reading.trueHeading, accuracy: 0.0001)
+    }
+
+    func testStepChangeThenSilenceSettlesOnRawHeading() {
+        var smoother = HeadingSmoother(smoothingFactor: 0.3)
+        for _ in 0..<10 {
+            _ = addReading(&smoother, trueHeading: 10, magneticHeading: 0)
+        }
+        // A turn, then Core Location goes quiet under its heading filter
+        let lagging = addReading(&smoother, trueHeading: 100, magneticHeading: 90)
+        XCTAssertGreaterThan(HeadingSmoother.angularDifference(100, lagging.trueHeading), 10)
+
+        var settled = lagging
+        var steps = 0
+        while let reading = smoother.settle(timestamp: Date()) {
+            settled = reading
+            steps += 1
+            XCTAssertLessThan(steps, 100)
+        }
+
+        XCTAssertEqual(100, settled.trueHeading, accuracy: 0.2)
+        XCTAssertEqual(90, settled.magneticHeading, accuracy: 0.2)
+        XCTAssertNil(smoother.settle(timestamp: Date()))
+    }
+
+    func testNothingToSettleWithoutReadings() {
+        var smoother = HeadingSmoother()
+        XCTAssertNil(smoother.settle(timestamp: Date()))
+        _ = addReading(&smoother, trueHeading: 45, magneticHeading: 40)
+        smoother.reset()
+        XCTAssertNil(smoother.settle(timestamp: Date()))
+    }
+
+    func testDirectionUnitSelection() {
+        let reading = HeadingReading(trueHeading: 24, magneticHeading: 18, headingAccuracy: 5, timestamp: Date())
+        XCTAssertEqual(24, reading.direction(unit: DirectionUnit.TN))
+        XCTAssertEqual(18, reading.direction(unit: DirectionUnit.MN))
+    }
+
+    func testAngularDifferenceWrapsAroundNorth() {
+        XCTAssertEqual(2, HeadingSmoother.angularDifference(359, 1), accuracy: 0.0001)
+        XCTAssertEqual(180, HeadingSmoother.angularDifference(90, 270), accuracy: 0.0001)
+        XCTAssertEqual(10, HeadingSmoother.angularDifference(5, 355), accuracy: 0.0001)
+    }
+}
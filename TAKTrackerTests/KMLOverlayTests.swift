@@ -0,0 +1,122 @@
+//
+//  KMLOverlayTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import MapKit
+import sf_ios
+import XCTest
+
+final class KMLOverlayTests: TAKTrackerTestCase {
+    // A jagged ring roughly 100km across, closed on its first vertex
+    func boundary(vertices: Int) -> KMLPlacemark {
+        var generator = SeededGenerator(seed: 7)
+        let ring = SFLineString()
+        for index in 0..<vertices {
+            let angle = 2 * Double.pi * Double(index) / Double(vertices)
+            let jitter = Double(generator.next() % 1000) / 1000.0 * 0.002
+            let radius = 0.5 + jitter
+            ring.addPoint(SFPoint(xValue: -79.0 + radius * cos(angle), andYValue: 35.0 + radius * sin(angle)))
+        }
+        ring.addPoint(ring.points[0] as? SFPoint)
+        let polygon: SFPolygon = SFPolygon(ring: ring)
+        return KMLPlacemark(id: "boundary", name: "Boundary", geometry: polygon, envelope: SFGeometryEnvelopeBuilder.buildEnvelope(with: polygon))
+    }
+
+    func testLevelsThinOut() {
+        let overlay = KMLOverlay(placemark: boundary(vertices: 50_000))
+
+        XCTAssertEqual(KMLOverlay.SIMPLIFIED_ZOOM_LEVELS.count + 1, overlay.levels.count)
+        XCTAssertEqual(50_001, overlay.levels[0].vertexCount)
+        let counts = overlay.levels.map { $0.vertexCount }
+        XCTAssertEqual(counts.sorted(by: >), counts)
+        XCTAssertLessThan(overlay.levels.last!.vertexCount, 500)
+    }
+
+    func testCoarseLevelAtLowZoom() {
+        let overlay = KMLOverlay(placemark: boundary(vertices: 50_000))
+        // Whole world on a 256pt wide screen
+        let worldScale = MKZoomScale(256.0 / MKMapSize.world.width)
+        let streetScale = MKZoomScale(1.0 / KMLOverlay.mapPointsPerPoint(zoomLevel: 18))
+
+        XCTAssertLessThan(overlay.level(forZoomScale: worldScale).vertexCount, 500)
+        XCTAssertEqual(50_001, overlay.level(forZoomScale: streetScale).vertexCount)
+    }
+
+    func testTileWalksOnlyNearbyVertices() {
+        let overlay = KMLOverlay(placemark: boundary(vertices: 50_000))
+        let level = overlay.levels[0]
+        // A small tile on the ring's eastern edge
+        let edge = MKMapPoint(CLLocationCoordinate2D(latitude: 35.0, longitude: -78.5))
+        let tile = MKMapRect(x: edge.x - 2000, y: edge.y - 2000, width: 4000, height: 4000)
+
+        let visible = level.visibleVertexCount(in: tile)
+        XCTAssertGreaterThan(visible, 0)
+        XCTAssertLessThan(visible, level.vertexCount / 20)
+        XCTAssertEqual(0, level.visibleVertexCount(in: MKMapRect(x: 0, y: 0, width: 1000, height: 1000)))
+    }
+
+    func testBoundingRectFromEnvelope() {
+        let overlay = KMLOverlay(placemark: boundary(vertices: 1_000))
+        let center = MKMapPoint(CLLocationCoordinate2D(latitude: 35.0, longitude: -79.0))
+
+        XCTAssertTrue(overlay.boundingMapRect.contains(center))
+        XCTAssertTrue(overlay.isFilled)
+        XCTAssertEqual(35.0, overlay.coordinate.latitude, accuracy: 0.01)
+    }
+
+    func testPointsAreNotOverlays() {
+        let point = SFPoint(xValue: 1, andYValue: 2)!
+        let placemark = KMLPlacemark(id: "p", name: "Point", geometry: point, envelope: SFGeometryEnvelopeBuilder.buildEnvelope(with: point))
+
+        XCTAssertFalse(KMLOverlay.canDisplay(placemark))
+    }
+
+    func testVisibleRangesMergeNeighbouringChunks() {
+        let points = ContiguousArray((0...300).map { MKMapPoint(x: Double($0), y: Double($0 % 2)) })
+        let part = KMLShapePart(points: points, isClosed: false)
+
+        XCTAssertEqual(3, part.chunkBounds.count)
+        XCTAssertEqual([0...256], part.visibleRanges(in: MKMapRect(x: 100, y: -1, width: 50, height: 2).union(MKMapRect(x: 200, y: -1, width: 10, height: 2))))
+        XCTAssertEqual([256...300], part.visibleRanges(in: MKMapRect(x: 280, y: -1, width: 5, height: 2)))
+    }
+
+    func testFillWalksOnlyNearbyVerticesAndKeepsTheRing() {
+        let overlay = KMLOverlay(placemark: boundary(vertices: 50_000))
+        let part = overlay.levels[0].parts[0]
+        let center = MKMapPoint(CLLocationCoordinate2D(latitude: 35.0, longitude: -79.0))
+        let inside = MKMapRect(x: center.x - 2000, y: center.y - 2000, width: 4000, height: 4000)
+        let edge = MKMapPoint(CLLocationCoordinate2D(latitude: 35.0, longitude: -78.5))
+        let onEdge = MKMapRect(x: edge.x - 2000, y: edge.y - 2000, width: 4000, height: 4000)
+
+        // One vertex per run for a tile nowhere near the ring
+        XCTAssertEqual(part.chunkBounds.count + 1, part.fillPoints(in: inside).count)
+        XCTAssertLessThan(part.fillPoints(in: onEdge).count, part.points.count / 20)
+
+        var generator = SeededGenerator(seed: 11)
+        for tile in [inside, onEdge] {
+            let fill = part.fillPoints(in: tile)
+            for _ in 0..<200 {
+                let x = tile.minX + Double(generator.next() % 10_000) / 10_000.0 * tile.width
+                let y = tile.minY + Double(generator.next() % 10_000) / 10_000.0 * tile.height
+                XCTAssertEqual(contains(part.points, x: x, y: y), contains(fill, x: x, y: y))
+            }
+        }
+    }
+
+    // Even-odd ray cast
+    func contains(_ ring: ContiguousArray<MKMapPoint>, x: Double, y: Double) -> Bool {
+        var inside = false
+        for index in 0..<ring.count {
+            let a = ring[index]
+            let b = ring[(index + 1) % ring.count]
+            if((a.y > y) != (b.y > y) && x < a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y)) {
+                inside.toggle()
+            }
+        }
+        return inside
+    }
+}
@@ -0,0 +1,126 @@
+//
+//  KMLParserTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import sf_ios
+import XCTest
+import ZIPFoundation
+
+final class KMLParserTests: TAKTrackerTestCase {
+    let document = """
+    <?xml version="1.0" encoding="UTF-8"?>
+    <kml xmlns="http://www.opengis.net/kml/2.2">
+    <Document>
+      <name>Operations</name>
+      <Placemark id="boundary">
+        <name>Boundary</name>
+        <Polygon>
+          <outerBoundaryIs><LinearRing><coordinates>
+            -80.0,35.0,0 -79.0,35.0,0 -79.0,36.0,0 -80.0,36.0,0 -80.0,35.0,0
+          </coordinates></LinearRing></outerBoundaryIs>
+          <innerBoundaryIs><LinearRing><coordinates>
+            -79.6,35.4 -79.4,35.4 -79.4,35.6 -79.6,35.6 -79.6,35.4
+          </coordinates></LinearRing></innerBoundaryIs>
+        </Polygon>
+      </Placemark>
+      <Placemark>
+        <name>Route</name>
+        <LineString><coordinates>-78.5,34.5 -78.0,34.75 -77.5,34.6</coordinates></LineString>
+      </Placemark>
+      <Placemark>
+        <name>Rally Point</name>
+        <Point><coordinates>-77.25,34.25,10</coordinates></Point>
+      </Placemark>
+      <Placemark id="islands">
+        <name>Islands</name>
+        <MultiGeometry>
+          <Polygon><outerBoundaryIs><LinearRing><coordinates>
+            0,0 1,0 1,1 0,0
+          </coordinates></LinearRing></outerBoundaryIs></Polygon>
+          <Polygon><outerBoundaryIs><LinearRing><coordinates>
+            2,2 3,2 3,3 2,2
+          </coordinates></LinearRing></outerBoundaryIs></Polygon>
+        </MultiGeometry>
+      </Placemark>
+    </Document>
+    </kml>
+    """
+
+    var workDirectory: URL!
+
+    override func setUpWithError() throws {
+        workDirectory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+        try FileManager.default.createDirectory(at: workDirectory, withIntermediateDirectories: true)
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: workDirectory)
+    }
+
+    func testParsesPlacemarks() {
+        let placemarks = KMLParser.parse(data: Data(document.utf8))
+
+        XCTAssertEqual(["Boundary", "Route", "Rally Point", "Islands"], placemarks.map { $0.name })
+        XCTAssertEqual("boundary", placemarks[0].id)
+        XCTAssertEqual("placemark-1", placemarks[1].id)
+    }
+
+    func testPolygonKeepsHoles() throws {
+        let placemarks = KMLParser.parse(data: Data(document.utf8))
+        let polygon = try XCTUnwrap(placemarks[0].geometry as? SFPolygon)
+
+        XCTAssertEqual(2, polygon.rings.count)
+        XCTAssertEqual(5, (polygon.rings[0] as? SFLineString)?.points.count)
+        XCTAssertEqual(-79.6, ((polygon.rings[1] as? SFLineString)?.points[0] as? SFPoint)?.x.doubleValue)
+    }
+
+    func testEnvelopeIsBuiltWithPlacemark() {
+        let envelope = KMLParser.parse(data: Data(document.utf8))[0].envelope
+
+        XCTAssertEqual(-80.0, envelope.minX.doubleValue)
+        XCTAssertEqual(-79.0, envelope.maxX.doubleValue)
+        XCTAssertEqual(35.0, envelope.minY.doubleValue)
+        XCTAssertEqual(36.0, envelope.maxY.doubleValue)
+    }
+
+    func testLinesPointsAndMultiGeometry() throws {
+        let placemarks = KMLParser.parse(data: Data(document.utf8))
+
+        XCTAssertEqual(3, (placemarks[1].geometry as? SFLineString)?.points.count)
+        let point = try XCTUnwrap(placemarks[2].geometry as? SFPoint)
+        XCTAssertEqual(-77.25, point.x.doubleValue)
+        XCTAssertEqual(34.25, point.y.doubleValue)
+        XCTAssertEqual(2, (placemarks[3].geometry as? SFMultiPolygon)?.geometries.count)
+    }
+
+    func testParseCoordinatesSkipsMalformedTuples() {
+        let points = KMLParser.parseCoordinates(" 1,2,3\n\t4,5 bad 6 7,x ")
+
+        XCTAssertEqual([1, 4], points.map { $0.x.doubleValue })
+        XCTAssertEqual([2, 5], points.map { $0.y.doubleValue })
+    }
+
+    func testParsesKMZ() throws {
+        let sourceDirectory = workDirectory.appendingPathComponent("source", isDirectory: true)
+        try FileManager.default.createDirectory(at: sourceDirectory.appendingPathComponent("files"), withIntermediateDirectories: true)
+        try Data("<kml/>".utf8).write(to: sourceDirectory.appendingPathComponent("files/other.kml"))
+        try Data(document.utf8).write(to: sourceDirectory.appendingPathComponent("doc.kml"))
+        let kmzURL = workDirectory.appendingPathComponent("operations.kmz")
+        let archive = try Archive(url: kmzURL, accessMode: .create)
+        try archive.addEntry(with: "files/other.kml", relativeTo: sourceDirectory, compressionMethod: .deflate)
+        try archive.addEntry(with: "doc.kml", relativeTo: sourceDirectory, compressionMethod: .deflate)
+
+        XCTAssertEqual(4, KMLParser.parse(url: kmzURL).count)
+    }
+
+    func testParsesFileFromDisk() throws {
+        let kmlURL = workDirectory.appendingPathComponent("operations.kml")
+        try Data(document.utf8).write(to: kmlURL)
+
+        XCTAssertEqual(4, KMLParser.parse(url: kmlURL).count)
+    }
+}
@@ -0,0 +1,158 @@
+//
+//  LocalTLSServer.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import Network
+import Security
+import XCTest
+
+// A real HTTPS server on the loopback interface, for what MockTAKServer
+// can't show, like whether two requests shared a TLS connection. It
+// presents the test user certificate and answers every request with a 200
+// and `body`, keeping the connection alive.
+final class LocalTLSServer {
+    let body: Data
+
+    private let listener: NWListener
+    private let queue = DispatchQueue(label: "com.flighttactics.TAKTrackerTests.LocalTLSServer")
+    private let lock = NSLock()
+    private var connections: [NWConnection] = []
+    private var receivedPaths: [String] = []
+
+    var port: UInt16 {
+        listener.port?.rawValue ?? 0
+    }
+
+    var requests: [String] {
+        lock.lock()
+        defer { lock.unlock() }
+        return receivedPaths
+    }
+
+    init(body: String) throws {
+        self.body = Data(body.utf8)
+
+        let serverIdentity = try LocalTLSServer.testIdentity()
+        let tlsOptions = NWProtocolTLS.Options()
+        guard let identity = sec_identity_create(serverIdentity) else {
+            throw XCTestError(.failureWhileWaiting, userInfo: ["TLSError": "Could not create the server identity"])
+        }
+        sec_protocol_options_set_local_identity(tlsOptions.securityProtocolOptions, identity)
+        listener = try NWListener(using: NWParameters(tls: tlsOptions, tcp: .init()), on: .any)
+    }
+
+    static func testIdentity() throws -> SecIdentity {
+        let bundle = Bundle(for: LocalTLSServer.self)
+        guard let certificateURL = bundle.url(forResource: TestConstants.USER_CERTIFICATE_NAME, withExtension: TestConstants.CERTIFICATE_FILE_EXTENSION) else {
+            throw XCTestError(.failureWhileWaiting, userInfo: ["FileError": "Could not open test user certificate"])
+        }
+        let certData = try Data(contentsOf: certificateURL)
+        let options = [kSecImportExportPassphrase as String: TestConstants.DEFAULT_CERT_PASSWORD]
+        var items: CFArray?
+        let status = SecPKCS12Import(certData as CFData, options as CFDictionary, &items)
+        guard status == errSecSuccess,
+              let item = (items as? [[String: Any]])?.first,
+              let identity = item[kSecImportItemIdentity as String] else {
+            throw XCTestError(.failureWhileWaiting, userInfo: ["CertificateError": "Could not import test user certificate (\(status))"])
+        }
+        return identity as! SecIdentity
+    }
+
+    func url(_ path: String) -> URL {
+        return URL(string: "https://127.0.0.1:\(port)\(path)")!
+    }
+
+    // Returns once the listener has a port
+    func start() throws {
+        let ready = DispatchSemaphore(value: 0)
+        var failure: NWError?
+        listener.stateUpdateHandler = { state in
+            switch state {
+            case .ready:
+                ready.signal()
+            case .failed(let error):
+                failure = error
+                ready.signal()
+            default:
+                break
+            }
+        }
+        listener.newConnectionHandler = { [weak self] connection in
+            self?.accept(connection)
+        }
+        listener.start(queue: queue)
+        if(ready.wait(timeout: .now() + 5.0) == .timedOut) {
+            throw XCTestError(.timeoutWhileWaiting)
+        }
+        if let failure = failure {
+            throw failure
+        }
+    }
+
+    // Call from outside the server's queue
+    func stop() {
+        listener.cancel()
+        queue.sync {
+            connections.forEach { $0.cancel() }
+            connections.removeAll()
+        }
+    }
+
+    private func accept(_ connection: NWConnection) {
+        connections.append(connection)
+        connection.start(queue: queue)
+        receive(on: connection, buffered: Data())
+    }
+
+    private func receive(on connection: NWConnection, buffered: Data) {
+        connection.receive(minimumIncompleteLength: 1, maximumLength: 65536) { [weak self] content, _, isComplete, error in
+            guard let self = self else { return }
+            var buffer = buffered
+            if let content = content {
+                buffer.append(content)
+            }
+            while let path = LocalTLSServer.takeRequest(from: &buffer) {
+                self.lock.lock()
+                self.receivedPaths.append(path)
+                self.lock.unlock()
+                self.respond(on: connection)
+            }
+            if(isComplete || error != nil) {
+                connection.cancel()
+                return
+            }
+            self.receive(on: connection, buffered: buffer)
+        }
+    }
+
+    private func respond(on connection: NWConnection) {
+        let header = "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: \(body.count)\r\nConnection: keep-alive\r\n\r\n"
+        connection.send(content: Data(header.utf8) + body, completion: .idempotent)
+    }
+
+    // Removes one complete request from the front of buffer and returns its path
+    static func takeRequest(from buffer: inout Data) -> String? {
+        guard let headerEnd = buffer.range(of: Data("\r\n\r\n".utf8)) else {
+            return nil
+        }
+        let lines = String(decoding: buffer[buffer.startIndex..<headerEnd.lowerBound], as: UTF8.self).components(separatedBy: "\r\n")
+        var contentLength = 0
+        for line in lines.dropFirst() {
+            let parts = line.split(separator: ":", maxSplits: 1)
+            if(parts.count == 2 && parts[0].lowercased() == "content-length") {
+                contentLength = Int(parts[1].trimmingCharacters(in: .whitespaces)) ?? 0
+            }
+        }
+        let requestEnd = headerEnd.upperBound + contentLength
+        if(buffer.endIndex < requestEnd) {
+            return nil
+        }
+        let requestLine = lines.first?.split(separator: " ") ?? []
+        buffer = Data(buffer[requestEnd...])
+        return requestLine.count > 1 ? String(requestLine[1]) : ""
+    }
+}
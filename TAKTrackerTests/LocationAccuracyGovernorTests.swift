@@ -0,0 +1,118 @@
+//
+//  LocationAccuracyGovernorTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import CoreLocation
+import XCTest
+
+final class LocationAccuracyGovernorTests: TAKTrackerTestCase {
+
+    struct TraceSegment {
+        let name: String
+        let hours: Double
+        let speed: CLLocationSpeed
+        let broadcastInterval: TimeInterval
+        let expectedAccuracy: CLLocationAccuracy
+    }
+
+    // A field day: overnight at rest, a drive out, working on foot,
+    // a slow-interval patrol, and a drive home on a draining battery
+    let dayTrace = [
+        TraceSegment(name: "Overnight, stationary", hours: 6, speed: 0, broadcastInterval: 60, expectedAccuracy: kCLLocationAccuracyHundredMeters),
+        TraceSegment(name: "Drive to site", hours: 1, speed: 25, broadcastInterval: 10, expectedAccuracy: kCLLocationAccuracyBest),
+        TraceSegment(name: "Working on foot", hours: 4, speed: 1.4, broadcastInterval: 10, expectedAccuracy: kCLLocationAccuracyNearestTenMeters),
+        TraceSegment(name: "Rapid updates on foot", hours: 1, speed: 1.4, broadcastInterval: 5, expectedAccuracy: kCLLocationAccuracyBest),
+        TraceSegment(name: "Foot patrol, slow interval", hours: 3, speed: 1.4, broadcastInterval: 60, expectedAccuracy: kCLLocationAccuracyHundredMeters),
+        TraceSegment(name: "Standing by", hours: 2, speed: 0, broadcastInterval: 10, expectedAccuracy: kCLLocationAccuracyNearestTenMeters),
+        TraceSegment(name: "Drive home", hours: 1, speed: 25, broadcastInterval: 10, expectedAccuracy: kCLLocationAccuracyBest),
+        TraceSegment(name: "Evening, stationary", hours: 6, speed: 0, broadcastInterval: 60, expectedAccuracy: kCLLocationAccuracyHundredMeters),
+    ]
+
+    func testSettingsOverADayWithAFullBattery() {
+        var minutesAtBest = 0
+        var totalMinutes = 0
+
+        for segment in dayTrace {
+            let settings = LocationAccuracyGovernor.settings(broadcastInterval: segment.broadcastInterval, speed: segment.speed, batteryLevel: 1.0)
+            XCTAssertEqual(segment.expectedAccuracy, settings.desiredAccuracy, segment.name)
+            XCTAssertGreaterThanOrEqual(settings.distanceFilter, LocationAccuracyGovernor.MIN_DISTANCE_FILTER, segment.name)
+            XCTAssertLessThanOrEqual(settings.distanceFilter, LocationAccuracyGovernor.MAX_DISTANCE_FILTER, segment.name)
+
+            let minutes = Int(segment.hours * 60)
+            totalMinutes += minutes
+            if(settings.desiredAccuracy == kCLLocationAccuracyBest) {
+                minutesAtBest += minutes
+            }
+        }
+
+        XCTAssertEqual(24 * 60, totalMinutes)
+        // Previously this was the full 24 hours
+        XCTAssertEqual(3 * 60, minutesAtBest)
+    }
+
+    func testBatteryDrainingThroughTheDayStepsAccuracyDown() {
+        // Battery runs from full to 5% over the day, minute by minute
+        let totalMinutes = dayTrace.reduce(0) { $0 + Int($1.hours * 60) }
+        var minute = 0
+
+        for segment in dayTrace {
+            for _ in 0..<Int(segment.hours * 60) {
+                let battery = Float(1.0 - 0.95 * Double(minute) / Double(totalMinutes))
+                let settings = LocationAccuracyGovernor.settings(broadcastInterval: segment.broadcastInterval, speed: segment.speed, batteryLevel: battery)
+                let tier = LocationAccuracyGovernor.ACCURACY_TIERS.firstIndex(of: settings.desiredAccuracy)!
+                let fullBatteryTier = LocationAccuracyGovernor.ACCURACY_TIERS.firstIndex(of: segment.expectedAccuracy)!
+
+                if(battery <= LocationAccuracyGovernor.CRITICAL_BATTERY_LEVEL) {
+                    XCTAssertEqual(min(fullBatteryTier + 2, LocationAccuracyGovernor.ACCURACY_TIERS.count - 1), tier, "\(segment.name) at \(battery)")
+                } else if(battery <= LocationAccuracyGovernor.LOW_BATTERY_LEVEL) {
+                    XCTAssertEqual(fullBatteryTier + 1, tier, "\(segment.name) at \(battery)")
+                } else {
+                    XCTAssertEqual(fullBatteryTier, tier, "\(segment.name) at \(battery)")
+                }
+                minute += 1
+            }
+        }
+    }
+
+    func testUnknownBatteryLevelIsIgnored() {
+        let unknown = LocationAccuracyGovernor.settings(broadcastInterval: 10, speed: 1.4, batteryLevel: -1.0)
+        let disabled = LocationAccuracyGovernor.settings(broadcastInterval: 10, speed: 1.4, batteryLevel: 0.0)
+        let full = LocationAccuracyGovernor.settings(broadcastInterval: 10, speed: 1.4, batteryLevel: 1.0)
+        XCTAssertEqual(full, unknown)
+        XCTAssertEqual(full, disabled)
+    }
+
+    func testDistanceFilterScalesWithSpeedAndInterval() {
+        let walking = LocationAccuracyGovernor.settings(broadcastInterval: 10, speed: 1.4, batteryLevel: 1.0)
+        let driving = LocationAccuracyGovernor.settings(broadcastInterval: 10, speed: 25, batteryLevel: 1.0)
+        let invalidSpeed = LocationAccuracyGovernor.settings(broadcastInterval: 10, speed: -1, batteryLevel: 1.0)
+        XCTAssertEqual(7.0, walking.distanceFilter, accuracy: 0.0001)
+        XCTAssertEqual(100.0, driving.distanceFilter, accuracy: 0.0001)
+        XCTAssertEqual(LocationAccuracyGovernor.MIN_DISTANCE_FILTER, invalidSpeed.distanceFilter)
+    }
+
+    func testStepsDownWhenFixesStopComing() {
+        let parkedAt = Date(timeIntervalSince1970: 1_000_000)
+        let lastFix = CLLocation(
+            coordinate: CLLocationCoordinate2D(latitude: 38.9, longitude: -77.0),
+            altitude: 0,
+            horizontalAccuracy: 5,
+            verticalAccuracy: 5,
+            course: 90,
+            speed: 25,
+            timestamp: parkedAt
+        )
+
+        let justParked = LocationAccuracyGovernor.settings(broadcastInterval: 10, lastFix: lastFix, now: parkedAt.addingTimeInterval(30), batteryLevel: 1.0)
+        XCTAssertEqual(kCLLocationAccuracyBest, justParked.desiredAccuracy)
+
+        // No fixes since, so the distance filter has been holding them back
+        let parked = LocationAccuracyGovernor.settings(broadcastInterval: 10, lastFix: lastFix, now: parkedAt.addingTimeInterval(LocationAccuracyGovernor.STATIONARY_AFTER_SECONDS), batteryLevel: 1.0)
+        XCTAssertEqual(kCLLocationAccuracyNearestTenMeters, parked.desiredAccuracy)
+        XCTAssertEqual(LocationAccuracyGovernor.MIN_DISTANCE_FILTER, parked.distanceFilter)
+        XCTAssertEqual(LocationAccuracyGovernor.settings(broadcastInterval: 10, speed: 0, batteryLevel: 1.0), parked)
+    }
+}
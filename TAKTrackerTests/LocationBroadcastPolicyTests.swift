@@ -0,0 +1,123 @@
+//
+//  LocationBroadcastPolicyTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import CoreLocation
+import Foundation
+import SwiftTAK
+import XCTest
+
+final class LocationBroadcastPolicyTests: TAKTrackerTestCase {
+    static let REPLAY_RATE = 100.0
+    static let TICK_INTERVAL = 0.05
+
+    let cotMessage = COTMessage(staleTimeMinutes: 5.0, deviceID: "replay-device", phoneModel: "iPhone", phoneOS: "17.0", appPlatform: AppConstants.TAK_PLATFORM, appVersion: "1.0")
+
+    // An hour on foot at one fix a second, round a square with a turn
+    // every quarter hour
+    func squareTrackGPX(seconds: Int) -> Data {
+        let formatter = ISO8601DateFormatter()
+        let legLength = seconds / 4
+        let step = 0.00001
+        var latitude = 38.8895
+        var longitude = -77.0353
+        var gpx = "<?xml version=\"1.0\" encoding=\"UTF-8\"?><gpx version=\"1.1\" xmlns=\"http://www.topografix.com/GPX/1/1\"><trk><trkseg>"
+        for second in 0..<seconds {
+            switch(min(second / legLength, 3)) {
+            case 0: longitude += step
+            case 1: latitude += step
+            case 2: longitude -= step
+            default: latitude -= step
+            }
+            let time = formatter.string(from: Date(timeIntervalSince1970: 1_693_569_600 + Double(second)))
+            gpx += "<trkpt lat=\"\(latitude)\" lon=\"\(longitude)\"><ele>12.0</ele><time>\(time)</time></trkpt>"
+        }
+        gpx += "</trkseg></trk></gpx>"
+        return Data(gpx.utf8)
+    }
+
+    // Steps the replay and the policy together on the replay's virtual
+    // clock, REPLAY_RATE times faster than real time
+    @discardableResult
+    func runReplay(_ source: LocationReplaySource, policy: LocationBroadcastPolicy) -> Int {
+        let step = LocationBroadcastPolicyTests.TICK_INTERVAL * source.rate
+        source.advance(by: 0)
+        policy.start(locationSource: source, interval: 10)
+        while(!source.isFinished) {
+            source.advance(by: step)
+            policy.advance(by: step)
+        }
+        policy.stop()
+        return policy.broadcastCount
+    }
+
+    func testBroadcastsOnStartAndEveryInterval() {
+        let source = LocationReplaySource(locations: [])
+        let policy = LocationBroadcastPolicy()
+        policy.start(locationSource: source, interval: 10)
+        XCTAssertEqual(1, policy.broadcastCount)
+
+        policy.advance(by: 9)
+        XCTAssertEqual(1, policy.broadcastCount)
+        policy.advance(by: 1)
+        XCTAssertEqual(2, policy.broadcastCount)
+        policy.advance(by: 35)
+        XCTAssertEqual(5, policy.broadcastCount)
+    }
+
+    func testBroadcastsOnSignificantHeadingChange() {
+        let source = LocationReplaySource(locations: [])
+        let policy = LocationBroadcastPolicy()
+        var broadcasts = 0
+        policy.onBroadcast = { _ in broadcasts += 1 }
+        policy.start(locationSource: source, interval: 10)
+
+        source.significantHeadingChanges.send(HeadingReading(trueHeading: 90, magneticHeading: 90, headingAccuracy: 0, timestamp: Date()))
+        XCTAssertEqual(2, broadcasts)
+
+        policy.stop()
+        source.significantHeadingChanges.send(HeadingReading(trueHeading: 180, magneticHeading: 180, headingAccuracy: 0, timestamp: Date()))
+        policy.advance(by: 60)
+        XCTAssertEqual(2, broadcasts)
+    }
+
+    func testZeroIntervalIsClamped() {
+        let policy = LocationBroadcastPolicy()
+        policy.start(locationSource: LocationReplaySource(locations: []), interval: 0)
+        XCTAssertEqual(1.0, policy.interval)
+        policy.advance(by: 3)
+        XCTAssertEqual(4, policy.broadcastCount)
+    }
+
+    func testReplayedTrackDrivesBroadcasts() throws {
+        let source = LocationReplaySource(gpxData: squareTrackGPX(seconds: 3_600), rate: LocationBroadcastPolicyTests.REPLAY_RATE)
+        let policy = LocationBroadcastPolicy()
+        var messages: [String] = []
+        policy.onBroadcast = { locationSource in
+            let positionInfo = TAKManager.generatePositionInfo(location: locationSource.currentLocation, heading: locationSource.currentHeading)
+            messages.append(self.cotMessage.generateCOTXml(positionInfo: positionInfo, callSign: "REPLAY", group: "Cyan", role: "Team Member"))
+        }
+
+        runReplay(source, policy: policy)
+
+        // Start, every 10 seconds over the hour, and the three turns
+        XCTAssertEqual(1 + 360 + 3, messages.count)
+        XCTAssertTrue(messages.allSatisfy { $0.contains("REPLAY") })
+    }
+
+    func testReplayedBroadcastPerformance() {
+        let gpx = squareTrackGPX(seconds: 3_600)
+        measure {
+            let source = LocationReplaySource(gpxData: gpx, rate: LocationBroadcastPolicyTests.REPLAY_RATE)
+            let policy = LocationBroadcastPolicy()
+            policy.onBroadcast = { locationSource in
+                let positionInfo = TAKManager.generatePositionInfo(location: locationSource.currentLocation, heading: locationSource.currentHeading)
+                _ = self.cotMessage.generateCOTXml(positionInfo: positionInfo, callSign: "REPLAY", group: "Cyan", role: "Team Member")
+            }
+            runReplay(source, policy: policy)
+        }
+    }
+}
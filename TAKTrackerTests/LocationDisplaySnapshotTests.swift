@@ -0,0 +1,131 @@
+//
+//  LocationDisplaySnapshotTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import CoreLocation
+import XCTest
+
+final class LocationDisplaySnapshotTests: TAKTrackerTestCase {
+
+    static let METERS_PER_DEGREE = 111_320.0
+    static let KPH = DisplayUIState(currentSpeedUnit: .KmPerHour)
+    static let MGRS = DisplayUIState(currentLocationUnit: .MGRS)
+    static let DECIMAL = DisplayUIState(currentLocationUnit: .Decimal)
+
+    func mockLocation(latitude: Double = 38.8856, longitude: Double = -76.9953, speed: Double = 3.0) -> CLLocation {
+        return CLLocation(coordinate: CLLocationCoordinate2D(latitude: latitude, longitude: longitude), altitude: 0, horizontalAccuracy: 5, verticalAccuracy: 5, course: 0, speed: speed, timestamp: Date())
+    }
+
+    // A stationary device's fixes, scattered up to `jitter` meters
+    func jitteredFixes(count: Int, jitter: Double, seed: UInt64) -> [CLLocation] {
+        var generator = SeededGenerator(seed: seed)
+        let degrees = jitter / LocationDisplaySnapshotTests.METERS_PER_DEGREE
+        return (0..<count).map { _ in
+            mockLocation(latitude: 38.8856 + Double.random(in: -degrees...degrees, using: &generator),
+                         longitude: -76.9953 + Double.random(in: -degrees...degrees, using: &generator),
+                         speed: 0)
+        }
+    }
+
+    // How many of the fixes removeDuplicates would let through
+    func redraws(_ fixes: [CLLocation], units: DisplayUIState) -> Int {
+        var redraws = 0
+        var previous: LocationDisplaySnapshot?
+        for fix in fixes {
+            let snapshot = LocationDisplaySnapshot(location: fix, heading: nil, units: units)
+            if(snapshot != previous) {
+                redraws += 1
+                previous = snapshot
+            }
+        }
+        return redraws
+    }
+
+    func testIdenticalFixesAreEqual() {
+        let first = LocationDisplaySnapshot(location: mockLocation(), heading: nil)
+        let second = LocationDisplaySnapshot(location: mockLocation(), heading: nil)
+        XCTAssertEqual(first, second)
+    }
+
+    func testMovementBelowDisplayPrecisionIsEqual() {
+        // A tenth of a thousandth of an arc second is not visible in DMS
+        let nudge = 0.0001 / 3600.0
+        let first = LocationDisplaySnapshot(location: mockLocation(), heading: nil)
+        let second = LocationDisplaySnapshot(location: mockLocation(latitude: 38.8856 + nudge), heading: nil)
+        XCTAssertEqual(first, second)
+    }
+
+    func testMovementAtDisplayPrecisionIsNotEqual() {
+        let nudge = 0.002 / 3600.0
+        let first = LocationDisplaySnapshot(location: mockLocation(), heading: nil)
+        let second = LocationDisplaySnapshot(location: mockLocation(longitude: -76.9953 + nudge), heading: nil)
+        XCTAssertNotEqual(first, second)
+    }
+
+    func testMovementWithinAMeterIsEqualInMGRS() {
+        // 4305973.76m north, so 20cm more stays in the same meter
+        let nudge = 0.2 / LocationDisplaySnapshotTests.METERS_PER_DEGREE
+        let units = LocationDisplaySnapshotTests.MGRS
+        XCTAssertEqual(LocationDisplaySnapshot(location: mockLocation(), heading: nil, units: units),
+                       LocationDisplaySnapshot(location: mockLocation(latitude: 38.8856 + nudge), heading: nil, units: units))
+        XCTAssertNotEqual(LocationDisplaySnapshot(location: mockLocation(), heading: nil),
+                          LocationDisplaySnapshot(location: mockLocation(latitude: 38.8856 + nudge), heading: nil))
+    }
+
+    func testMovementWithinTheFourthDecimalIsEqualInDecimal() {
+        let nudge = 3.0 / LocationDisplaySnapshotTests.METERS_PER_DEGREE
+        let units = LocationDisplaySnapshotTests.DECIMAL
+        XCTAssertEqual(LocationDisplaySnapshot(location: mockLocation(), heading: nil, units: units),
+                       LocationDisplaySnapshot(location: mockLocation(latitude: 38.8856 + nudge, longitude: -76.9953 - nudge), heading: nil, units: units))
+    }
+
+    func testChangingUnitsIsNotEqual() {
+        XCTAssertNotEqual(LocationDisplaySnapshot(location: mockLocation(), heading: nil),
+                          LocationDisplaySnapshot(location: mockLocation(), heading: nil, units: LocationDisplaySnapshotTests.MGRS))
+    }
+
+    func testSpeedChangeBelowOneKphIsEqual() {
+        let units = LocationDisplaySnapshotTests.KPH
+        let first = LocationDisplaySnapshot(location: mockLocation(speed: 3.0), heading: nil, units: units)
+        let second = LocationDisplaySnapshot(location: mockLocation(speed: 3.05), heading: nil, units: units)
+        XCTAssertEqual(first, second)
+    }
+
+    func testSpeedChangeOfOneKphIsNotEqual() {
+        let units = LocationDisplaySnapshotTests.KPH
+        let first = LocationDisplaySnapshot(location: mockLocation(speed: 3.0), heading: nil, units: units)
+        let second = LocationDisplaySnapshot(location: mockLocation(speed: 3.3), heading: nil, units: units)
+        XCTAssertNotEqual(first, second)
+    }
+
+    func testInvalidSpeedsDisplayTheSame() {
+        let first = LocationDisplaySnapshot(location: mockLocation(speed: -1), heading: nil)
+        let second = LocationDisplaySnapshot(location: mockLocation(speed: -5), heading: nil)
+        XCTAssertEqual(first, second)
+    }
+
+    func testGainingAFixIsNotEqual() {
+        let first = LocationDisplaySnapshot(location: nil, heading: nil)
+        let second = LocationDisplaySnapshot(location: mockLocation(), heading: nil)
+        XCTAssertNotEqual(first, second)
+    }
+
+    func testStationaryJitterOnlyRedrawsInDMS() {
+        let fixes = jitteredFixes(count: 1_000, jitter: 0.3, seed: 31)
+        XCTAssertGreaterThan(redraws(fixes, units: DisplayUIState()), 500)
+        XCTAssertEqual(1, redraws(fixes, units: LocationDisplaySnapshotTests.DECIMAL))
+    }
+
+    // The snapshot is built and compared on the main thread for every
+    // throttled update
+    func testMainThreadCostOfDedupingMGRS() {
+        XCTAssertTrue(Thread.isMainThread)
+        let fixes = jitteredFixes(count: 1_000, jitter: 3.0, seed: 32)
+        measure {
+            _ = redraws(fixes, units: LocationDisplaySnapshotTests.MGRS)
+        }
+    }
+}
@@ -0,0 +1,147 @@
+//
+//  LocationReplaySourceTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Combine
+import CoreLocation
+import Foundation
+import XCTest
+
+final class LocationReplaySourceTests: TAKTrackerTestCase {
+    var cancellables = Set<AnyCancellable>()
+
+    override func tearDownWithError() throws {
+        cancellables.removeAll()
+    }
+
+    func sampleData(withExtension fileExtension: String) throws -> Data {
+        let bundle = Bundle(for: Self.self)
+        guard let url = bundle.url(forResource: TestConstants.SAMPLE_TRACK_NAME, withExtension: fileExtension) else {
+            throw XCTestError(.failureWhileWaiting, userInfo: ["FileError": "Could not open sample track"])
+        }
+        return try Data(contentsOf: url)
+    }
+
+    func syntheticTrack(count: Int) -> [CLLocation] {
+        return (0..<count).map { index in
+            CLLocation(
+                coordinate: CLLocationCoordinate2D(latitude: 38.0 + Double(index) * 0.00001, longitude: -77.0),
+                altitude: 10,
+                horizontalAccuracy: 5,
+                verticalAccuracy: 5,
+                course: -1,
+                speed: -1,
+                timestamp: Date(timeIntervalSince1970: 1_000_000 + Double(index))
+            )
+        }
+    }
+
+    func testGPXParserReadsTimedPoints() throws {
+        let locations = GPXTrackParser.parse(data: try sampleData(withExtension: "gpx"))
+        // The final point has no time and can't be replayed
+        XCTAssertEqual(6, locations.count)
+        XCTAssertEqual(38.8895, locations[0].coordinate.latitude, accuracy: 0.000001)
+        XCTAssertEqual(-77.0353, locations[0].coordinate.longitude, accuracy: 0.000001)
+        XCTAssertEqual(12.0, locations[0].altitude)
+        XCTAssertEqual(15.5, locations[3].timestamp.timeIntervalSince(locations[0].timestamp), accuracy: 0.001)
+        XCTAssertEqual(6.5, locations[5].speed)
+    }
+
+    func testNMEAParserMergesRMCAndGGA() throws {
+        let locations = NMEATrackParser.parse(data: try sampleData(withExtension: "nmea"))
+        // Void and bad checksum sentences are dropped
+        XCTAssertEqual(4, locations.count)
+        XCTAssertEqual(38.88950, locations[0].coordinate.latitude, accuracy: 0.00001)
+        XCTAssertEqual(-77.03530, locations[0].coordinate.longitude, accuracy: 0.00001)
+        XCTAssertEqual(5.0 * NMEATrackParser.METERS_PER_SECOND_PER_KNOT, locations[0].speed, accuracy: 0.0001)
+        XCTAssertEqual(90.0, locations[0].course)
+        XCTAssertEqual(15.2, locations[0].altitude)
+        XCTAssertEqual(0.9 * NMEATrackParser.METERS_PER_HDOP, locations[0].horizontalAccuracy, accuracy: 0.0001)
+        // GGA after the RMC for the same epoch
+        XCTAssertEqual(15.4, locations[1].altitude)
+        // GGA before the RMC for the same epoch
+        XCTAssertEqual(15.6, locations[2].altitude)
+        XCTAssertEqual(4.0, locations[3].timestamp.timeIntervalSince(locations[0].timestamp), accuracy: 0.001)
+    }
+
+    func testNMEAChecksum() {
+        XCTAssertTrue(NMEATrackParser.hasValidChecksum("$GPRMC,120000.00,A,3853.370,N,07702.118,W,5.0,090.0,010923,,,A*49"))
+        XCTAssertFalse(NMEATrackParser.hasValidChecksum("$GPRMC,120000.00,A,3853.370,N,07702.118,W,5.0,090.0,010923,,,A*48"))
+    }
+
+    func testReplayIsDeterministicOnVirtualClock() throws {
+        let clock = VirtualClock(start: Date(timeIntervalSince1970: 500))
+        let source = LocationReplaySource(gpxData: try sampleData(withExtension: "gpx"), rate: 100, clock: clock)
+        var received: [CLLocation] = []
+        source.locationUpdates.sink { received.append($0) }.store(in: &cancellables)
+
+        source.advance(by: 0)
+        XCTAssertEqual(1, received.count)
+        source.advance(by: 4)
+        XCTAssertEqual(1, received.count)
+        source.advance(by: 1)
+        XCTAssertEqual(2, received.count)
+        XCTAssertEqual(Date(timeIntervalSince1970: 505), source.currentLocation?.timestamp)
+
+        source.advance(by: 100)
+        XCTAssertEqual(6, received.count)
+        XCTAssertTrue(source.isFinished)
+        XCTAssertEqual(Date(timeIntervalSince1970: 525), received.last?.timestamp)
+    }
+
+    func testReplayFillsMissingSpeedAndCourse() throws {
+        let source = LocationReplaySource(gpxData: try sampleData(withExtension: "gpx"))
+        var received: [CLLocation] = []
+        source.locationUpdates.sink { received.append($0) }.store(in: &cancellables)
+        source.runToEnd()
+
+        XCTAssertLessThan(received[0].speed, 0)
+        // About 26m east in 5 seconds
+        XCTAssertEqual(90.0, received[1].course, accuracy: 0.5)
+        XCTAssertEqual(5.2, received[1].speed, accuracy: 0.2)
+        XCTAssertEqual(0.0, received[4].course, accuracy: 0.5)
+        // Recorded speed is kept
+        XCTAssertEqual(6.5, received[5].speed)
+        XCTAssertEqual(received[4].course, source.currentHeading?.trueHeading)
+    }
+
+    func testReplayReportsSignificantHeadingChanges() throws {
+        let source = LocationReplaySource(gpxData: try sampleData(withExtension: "gpx"))
+        var changes: [HeadingReading] = []
+        source.significantHeadingChanges.sink { changes.append($0) }.store(in: &cancellables)
+        source.runToEnd()
+
+        // East then north is a single turn
+        XCTAssertEqual(1, changes.count)
+        XCTAssertEqual(0.0, changes[0].course, accuracy: 0.5)
+    }
+
+    func testTimerDrivenReplayAtHighRate() throws {
+        let source = LocationReplaySource(nmeaData: try sampleData(withExtension: "nmea"), rate: 100)
+        let finished = expectation(description: "Replay emits every fix")
+        var count = 0
+        source.locationUpdates.sink { _ in
+            count += 1
+            if(count == 4) {
+                finished.fulfill()
+            }
+        }.store(in: &cancellables)
+
+        source.start(tickInterval: 0.01)
+        wait(for: [finished], timeout: 5.0)
+        source.stop()
+        XCTAssertTrue(source.isFinished)
+    }
+
+    func testReplayPerformanceOnLongTrack() {
+        let track = syntheticTrack(count: 10_000)
+        measure {
+            let source = LocationReplaySource(locations: track, rate: 100)
+            source.runToEnd()
+            XCTAssertEqual(10_000, source.emittedFixCount)
+        }
+    }
+}
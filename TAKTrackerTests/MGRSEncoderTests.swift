@@ -0,0 +1,163 @@
+//
+//  MGRSEncoderTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import grid_ios
+import mgrs_ios
+import XCTest
+
+final class MGRSEncoderTests: TAKTrackerTestCase {
+    // The older UTM formula behind MGRS.from is off by a few centimeters,
+    // so where that straddles a meter the last digits are one apart.
+    // Both references are the corner of a 1m square holding the point.
+    static let LEGACY_TOLERANCE_METERS = 1.5
+    static let METERS_PER_DEGREE = 111_320.0
+
+    // Converter.LatLongToMGRS before MGRSEncoder
+    func legacyMGRS(latitude: Double, longitude: Double) -> String {
+        let mgrsPoint = MGRS.from(longitude, latitude)
+        let accuracy = 5 - Int(log10(Double(GridType.METER.precision())))
+        let easting = String(format: "%05d", mgrsPoint.easting)
+        let northing = String(format: "%05d", mgrsPoint.northing)
+
+        return "\(mgrsPoint.zone)\(mgrsPoint.band) \(mgrsPoint.column)\(mgrsPoint.row) \(String(easting.prefix(accuracy))) \(String(northing.prefix(accuracy)))"
+    }
+
+    // How far apart, in meters, the squares the two references name are.
+    // nil when they're in different grid zones.
+    func distanceFromLegacy(latitude: Double, longitude: Double) -> Double? {
+        let expected = legacyMGRS(latitude: latitude, longitude: longitude)
+        let actual = MGRSEncoder.string(latitude: latitude, longitude: longitude)
+        if(expected == actual) {
+            return 0
+        }
+        if(expected.split(separator: " ").first != actual.split(separator: " ").first) {
+            return nil
+        }
+        let expectedPoint = MGRS.parse(expected).toPoint()
+        let actualPoint = MGRS.parse(actual).toPoint()
+        let north = (expectedPoint.latitude - actualPoint.latitude) * MGRSEncoderTests.METERS_PER_DEGREE
+        let east = (expectedPoint.longitude - actualPoint.longitude) * MGRSEncoderTests.METERS_PER_DEGREE * cos(expectedPoint.latitude * Double.pi / 180)
+        return sqrt(north * north + east * east)
+    }
+
+    func assertMatchesLegacy(latitude: Double, longitude: Double, file: StaticString = #filePath, line: UInt = #line) {
+        let message = "\(latitude), \(longitude): \(legacyMGRS(latitude: latitude, longitude: longitude)) != \(MGRSEncoder.string(latitude: latitude, longitude: longitude))"
+        guard let distance = distanceFromLegacy(latitude: latitude, longitude: longitude) else {
+            return XCTFail(message, file: file, line: line)
+        }
+        XCTAssertLessThanOrEqual(distance, MGRSEncoderTests.LEGACY_TOLERANCE_METERS, message, file: file, line: line)
+    }
+
+    func randomCoordinates(count: Int, seed: UInt64) -> [(Double, Double)] {
+        var generator = SeededGenerator(seed: seed)
+        return (0..<count).map { _ in
+            (Double.random(in: -80.0...84.0, using: &generator), Double.random(in: -180.0...180.0, using: &generator))
+        }
+    }
+
+    func testKnownCoordinate() {
+        XCTAssertEqual("18S UJ 26938 05973", MGRSEncoder.string(latitude: 38.8856, longitude: -76.9953))
+        XCTAssertEqual("18S UJ 26938 05973", Converter.LatLongToMGRS(latitude: 38.8856, longitude: -76.9953))
+    }
+
+    func testMatchesMGRSFromOverGlobalSweep() {
+        var mismatches: [String] = []
+        for latitude in stride(from: -80.0, through: 84.0, by: 0.73) {
+            for longitude in stride(from: -180.0, through: 180.0, by: 0.91) {
+                let distance = distanceFromLegacy(latitude: latitude, longitude: longitude)
+                if(distance == nil || distance! > MGRSEncoderTests.LEGACY_TOLERANCE_METERS) {
+                    mismatches.append("\(latitude), \(longitude): \(legacyMGRS(latitude: latitude, longitude: longitude)) != \(MGRSEncoder.string(latitude: latitude, longitude: longitude))")
+                }
+            }
+        }
+        XCTAssertEqual([], mismatches.prefix(20))
+    }
+
+    func testMatchesMGRSFromAtRandomCoordinates() {
+        var exact = 0
+        let coordinates = randomCoordinates(count: 20_000, seed: 11)
+        for (latitude, longitude) in coordinates {
+            assertMatchesLegacy(latitude: latitude, longitude: longitude)
+            if(legacyMGRS(latitude: latitude, longitude: longitude) == MGRSEncoder.string(latitude: latitude, longitude: longitude)) {
+                exact += 1
+            }
+        }
+        // A few centimeters against a meter, so the digits rarely differ
+        XCTAssertGreaterThan(Double(exact) / Double(coordinates.count), 0.9)
+    }
+
+    func testMatchesMGRSFromOnZoneAndBandEdges() {
+        var coordinates: [(Double, Double)] = []
+        for latitude in stride(from: -80.0, through: 84.0, by: 8.0) {
+            for longitude in stride(from: -180.0, through: 180.0, by: 6.0) {
+                coordinates.append((latitude, longitude))
+                coordinates.append((latitude - 0.000001, longitude - 0.000001))
+            }
+        }
+        // Outside the MGRS latitudes, and longitudes that need wrapping
+        coordinates += [(-89.0, 10.0), (90.0, -45.0), (0.0, 0.0), (-0.000001, 0.0), (12.0, 190.0), (-12.0, -190.0)]
+        for (latitude, longitude) in coordinates {
+            assertMatchesLegacy(latitude: latitude, longitude: longitude)
+        }
+    }
+
+    func testNorwayAndSvalbardZones() {
+        XCTAssertEqual(32, MGRSEncoder.encode(latitude: 60.0, longitude: 4.0).zone)
+        XCTAssertEqual(31, MGRSEncoder.encode(latitude: 60.0, longitude: 2.5).zone)
+        XCTAssertEqual(33, MGRSEncoder.encode(latitude: 78.0, longitude: 10.0).zone)
+        XCTAssertEqual(31, MGRSEncoder.encode(latitude: 78.0, longitude: 8.0).zone)
+        XCTAssertEqual(37, MGRSEncoder.encode(latitude: 78.0, longitude: 40.0).zone)
+        for (latitude, longitude) in [(60.0, 4.0), (60.0, 2.5), (78.0, 10.0), (78.0, 8.0), (78.0, 21.0), (78.0, 40.0), (83.9, 20.0)] {
+            assertMatchesLegacy(latitude: latitude, longitude: longitude)
+        }
+    }
+
+    func testWritesIntoCallerBuffer() {
+        var bytes = [UInt8](repeating: 0, count: MGRSEncoder.MAX_LENGTH)
+        let length = bytes.withUnsafeMutableBufferPointer { buffer in
+            MGRSEncoder.write(latitude: 38.8856, longitude: -76.9953, into: buffer)
+        }
+        XCTAssertEqual(18, length)
+        XCTAssertEqual("18S UJ 26938 05973", String(decoding: bytes[0..<length], as: UTF8.self))
+
+        let shortLength = bytes.withUnsafeMutableBufferPointer { buffer in
+            MGRSEncoder.write(latitude: 0.5, longitude: -177.0, into: buffer)
+        }
+        XCTAssertEqual(17, shortLength)
+        XCTAssertEqual(MGRSEncoder.string(latitude: 0.5, longitude: -177.0), String(decoding: bytes[0..<shortLength], as: UTF8.self))
+    }
+
+    func testLegacyPerformance() {
+        let coordinates = randomCoordinates(count: 10_000, seed: 12)
+        measure {
+            for (latitude, longitude) in coordinates {
+                _ = legacyMGRS(latitude: latitude, longitude: longitude)
+            }
+        }
+    }
+
+    func testEncoderStringPerformance() {
+        let coordinates = randomCoordinates(count: 10_000, seed: 12)
+        measure {
+            for (latitude, longitude) in coordinates {
+                _ = MGRSEncoder.string(latitude: latitude, longitude: longitude)
+            }
+        }
+    }
+
+    func testEncoderBufferPerformance() {
+        let coordinates = randomCoordinates(count: 10_000, seed: 12)
+        var bytes = [UInt8](repeating: 0, count: MGRSEncoder.MAX_LENGTH)
+        measure {
+            bytes.withUnsafeMutableBufferPointer { buffer in
+                for (latitude, longitude) in coordinates {
+                    MGRSEncoder.write(latitude: latitude, longitude: longitude, into: buffer)
+                }
+            }
+        }
+    }
+}
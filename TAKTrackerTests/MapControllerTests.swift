@@ -0,0 +1,83 @@
+//
+//  MapControllerTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import MapKit
+import SwiftUI
+import XCTest
+
+final class MapControllerTests: TAKTrackerTestCase {
+    let region = MKCoordinateRegion(center: CLLocationCoordinate2D(latitude: 38.8895, longitude: -77.0353), span: MKCoordinateSpan(latitudeDelta: 0.05, longitudeDelta: 0.05))
+
+    func testMapViewIsAllocatedOnceAcrossViewUpdates() {
+        let controller = MapController()
+        let mapView = controller.mapView
+        let settings = HostedMapSettings()
+        let host = UIHostingController(rootView: HostedMap(settings: settings, region: region, contactStore: ContactStore(), controller: controller))
+        let window = UIWindow(frame: CGRect(x: 0, y: 0, width: 390, height: 844))
+        window.rootViewController = host
+        window.makeKeyAndVisible()
+        defer { window.isHidden = true }
+
+        // What MainScreen does on every body evaluation at GPS rate
+        for update in 1...20 {
+            settings.mapType = UInt(update % 3)
+            RunLoop.main.run(until: Date().addingTimeInterval(0.01))
+            host.view.layoutIfNeeded()
+            XCTAssertEqual(UInt(update % 3), controller.currentState?.mapType, "update \(update)")
+        }
+
+        let hosted = mapViews(in: host.view)
+        XCTAssertEqual(1, hosted.count)
+        XCTAssertTrue(hosted.first === mapView)
+        XCTAssertTrue(controller.mapView === mapView)
+        // MapView's coordinator is the controller that owns the map
+        XCTAssertTrue(hosted.first?.delegate === controller)
+    }
+
+    func mapViews(in view: UIView) -> [MKMapView] {
+        if let mapView = view as? MKMapView {
+            return [mapView]
+        }
+        return view.subviews.flatMap { mapViews(in: $0) }
+    }
+
+    func testApplyOnlyTouchesTheMapWhenStateChanges() {
+        let controller = MapController()
+        controller.apply(MapViewState(mapType: MKMapType.satellite.rawValue, isHidden: false))
+        XCTAssertEqual(.satellite, controller.mapView.mapType)
+
+        // Changed behind the controller's back; the same state is a no-op
+        controller.mapView.mapType = .standard
+        controller.apply(MapViewState(mapType: MKMapType.satellite.rawValue, isHidden: false))
+        XCTAssertEqual(.standard, controller.mapView.mapType)
+
+        controller.apply(MapViewState(mapType: MKMapType.satellite.rawValue, isHidden: true))
+        XCTAssertEqual(.standard, controller.mapView.mapType)
+        XCTAssertTrue(controller.mapView.isHidden)
+    }
+}
+
+private final class HostedMapSettings: ObservableObject {
+    @Published var mapType: UInt = 0
+}
+
+// Re-creates MapView on each settings change, like MainScreen's body
+private struct HostedMap: View {
+    @ObservedObject var settings: HostedMapSettings
+    let region: MKCoordinateRegion
+    let contactStore: ContactStore
+    let controller: MapController
+
+    var body: some View {
+        MapView(
+            region: .constant(region),
+            mapType: $settings.mapType,
+            contactStore: contactStore,
+            controller: controller
+        )
+    }
+}
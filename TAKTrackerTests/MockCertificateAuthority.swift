@@ -0,0 +1,93 @@
+//
+//  MockCertificateAuthority.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Crypto
+import Foundation
+import SwiftASN1
+import X509
+
+// A throwaway CA for MockTAKServer's signClient endpoint. It signs whatever
+// CSR it's sent with certificates valid for `lifetime`, and answers the way
+// a TAK server does: the signed certificate plus the CA chain, as PEM
+// bodies in JSON.
+final class MockCertificateAuthority {
+    private let lock = NSLock()
+    private let key = P256.Signing.PrivateKey()
+    let certificate: Certificate
+    var lifetime: TimeInterval
+    private var issuedCertificates: [Certificate] = []
+
+    var issued: [Certificate] {
+        lock.lock()
+        defer { lock.unlock() }
+        return issuedCertificates
+    }
+
+    init(lifetime: TimeInterval) throws {
+        self.lifetime = lifetime
+        let name = try DistinguishedName {
+            CommonName("Mock TAK CA")
+            OrganizationName("FLIGHTTACTICS")
+        }
+        certificate = try Certificate(
+            version: .v3,
+            serialNumber: Certificate.SerialNumber(),
+            publicKey: Certificate.PublicKey(key.publicKey),
+            notValidBefore: Date().addingTimeInterval(-60),
+            notValidAfter: Date().addingTimeInterval(24 * 60 * 60),
+            issuer: name,
+            subject: name,
+            signatureAlgorithm: .ecdsaWithSHA256,
+            extensions: try Certificate.Extensions {
+                Critical(BasicConstraints.isCertificateAuthority(maxPathLength: nil))
+            },
+            issuerPrivateKey: Certificate.PrivateKey(key)
+        )
+    }
+
+    // The reply for a signClient request
+    func reply(to request: MockTAKServer.ReceivedRequest) -> MockTAKServer.Reply {
+        do {
+            guard let der = Data(base64Encoded: request.body) else {
+                return MockTAKServer.text("Bad CSR", status: 400)
+            }
+            let csr = try CertificateSigningRequest(derEncoded: Array(der))
+            let signed = try Certificate(
+                version: .v3,
+                serialNumber: Certificate.SerialNumber(),
+                publicKey: csr.publicKey,
+                notValidBefore: Date().addingTimeInterval(-60),
+                notValidAfter: Date().addingTimeInterval(lifetime),
+                issuer: certificate.subject,
+                subject: csr.subject,
+                signatureAlgorithm: .ecdsaWithSHA256,
+                extensions: Certificate.Extensions(),
+                issuerPrivateKey: Certificate.PrivateKey(key)
+            )
+            lock.lock()
+            issuedCertificates.append(signed)
+            lock.unlock()
+
+            let body = try JSONSerialization.data(withJSONObject: [
+                "signedCert": try MockCertificateAuthority.pemBody(signed),
+                "ca0": try MockCertificateAuthority.pemBody(certificate)
+            ])
+            return .http(status: 200, mimeType: "application/json", body: body)
+        } catch {
+            return MockTAKServer.text("\(error)", status: 500)
+        }
+    }
+
+    // Base64 DER in 64 character lines, without the BEGIN/END wrapper
+    static func pemBody(_ certificate: Certificate) throws -> String {
+        var serializer = DER.Serializer()
+        try serializer.serialize(certificate)
+        return Data(serializer.serializedBytes)
+            .base64EncodedString(options: .lineLength64Characters)
+            .replacingOccurrences(of: "\r\n", with: "\n")
+    }
+}
@@ -0,0 +1,133 @@
+//
+//  MockTAKServer.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+
+// Answers a TAK server's HTTPS endpoints in-process, for sessions built
+// from MockTAKServer.configuration(). Replies are queued per path; the last
+// one keeps being used once the rest are spent.
+final class MockTAKServer: URLProtocol {
+    enum Reply {
+        case http(status: Int, mimeType: String, body: Data)
+        case failure(URLError.Code)
+        // Holds the request open until it's cancelled
+        case noReply
+        // Worked out from the request
+        case respond((ReceivedRequest) -> Reply)
+    }
+
+    struct ReceivedRequest {
+        var method: String
+        var path: String
+        var headers: [String: String]
+        var body: Data
+    }
+
+    private static let lock = NSLock()
+    private static var replies: [String: [Reply]] = [:]
+    private static var received: [ReceivedRequest] = []
+
+    static var requests: [ReceivedRequest] {
+        lock.lock()
+        defer { lock.unlock() }
+        return received
+    }
+
+    static func configuration() -> URLSessionConfiguration {
+        let configuration = EnrollmentHTTPClient.defaultConfiguration()
+        configuration.protocolClasses = [MockTAKServer.self]
+        return configuration
+    }
+
+    static func reset() {
+        lock.lock()
+        defer { lock.unlock() }
+        replies = [:]
+        received = []
+    }
+
+    static func reply(to path: String, with queued: Reply...) {
+        lock.lock()
+        defer { lock.unlock() }
+        replies[path] = queued
+    }
+
+    static func text(_ string: String, status: Int = 200) -> Reply {
+        return .http(status: status, mimeType: "text/plain", body: Data(string.utf8))
+    }
+
+    static func json(_ string: String, status: Int = 200) -> Reply {
+        return .http(status: status, mimeType: "application/json", body: Data(string.utf8))
+    }
+
+    private static func nextReply(for request: URLRequest) -> (reply: Reply, request: ReceivedRequest) {
+        lock.lock()
+        defer { lock.unlock() }
+        let path = request.url?.path ?? ""
+        let receivedRequest = ReceivedRequest(
+            method: request.httpMethod ?? "GET",
+            path: path,
+            headers: request.allHTTPHeaderFields ?? [:],
+            body: request.httpBody ?? readAll(request.httpBodyStream)
+        )
+        received.append(receivedRequest)
+        guard var queued = replies[path], let reply = queued.first else {
+            return (text("Not Found", status: 404), receivedRequest)
+        }
+        if(queued.count > 1) {
+            queued.removeFirst()
+            replies[path] = queued
+        }
+        return (reply, receivedRequest)
+    }
+
+    private static func readAll(_ stream: InputStream?) -> Data {
+        guard let stream = stream else { return Data() }
+        var data = Data()
+        var buffer = [UInt8](repeating: 0, count: 4096)
+        stream.open()
+        defer { stream.close() }
+        while(stream.hasBytesAvailable) {
+            let count = stream.read(&buffer, maxLength: buffer.count)
+            if(count <= 0) {
+                break
+            }
+            data.append(buffer, count: count)
+        }
+        return data
+    }
+
+    override class func canInit(with request: URLRequest) -> Bool {
+        return true
+    }
+
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest {
+        return request
+    }
+
+    override func startLoading() {
+        let next = MockTAKServer.nextReply(for: request)
+        var reply = next.reply
+        if case .respond(let respond) = reply {
+            reply = respond(next.request)
+        }
+        switch reply {
+        case .http(let status, let mimeType, let body):
+            let response = HTTPURLResponse(url: request.url!, statusCode: status, httpVersion: "HTTP/1.1", headerFields: ["Content-Type": mimeType])!
+            client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+            client?.urlProtocol(self, didLoad: body)
+            client?.urlProtocolDidFinishLoading(self)
+        case .failure(let code):
+            client?.urlProtocol(self, didFailWithError: URLError(code))
+        case .noReply, .respond:
+            return
+        }
+    }
+
+    override func stopLoading() {
+    }
+}
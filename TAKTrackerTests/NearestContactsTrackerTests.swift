@@ -0,0 +1,136 @@
+//
+//  NearestContactsTrackerTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import CoreLocation
+import Foundation
+import XCTest
+
+final class NearestContactsTrackerTests: TAKTrackerTestCase {
+    func randomPositions(count: Int, seed: UInt64) -> [(Double, Double)] {
+        var generator = SeededGenerator(seed: seed)
+        return (0..<count).map { _ in
+            (Double.random(in: 38.7...39.1, using: &generator), Double.random(in: -77.3 ... -76.9, using: &generator))
+        }
+    }
+
+    func bruteForceNearest(_ positions: [String: (Double, Double)], latitude: Double, longitude: Double, k: Int) -> [String] {
+        return positions
+            .map { ($0.key, RangeBearingKernel.range(fromLatitude: latitude, longitude: longitude, toLatitude: $0.value.0, longitude: $0.value.1)) }
+            .sorted { $0.1 < $1.1 }
+            .prefix(k)
+            .map { $0.0 }
+    }
+
+    func testKernelMatchesCoreLocation() {
+        var kernel = RangeBearingKernel()
+        let points = randomPositions(count: 100, seed: 1)
+        for point in points {
+            kernel.append(latitude: point.0, longitude: point.1)
+        }
+        var ranges: [Double] = []
+        kernel.ranges(fromLatitude: 38.9, longitude: -77.1, into: &ranges)
+
+        let origin = CLLocation(latitude: 38.9, longitude: -77.1)
+        for (index, point) in points.enumerated() {
+            let expected = origin.distance(from: CLLocation(latitude: point.0, longitude: point.1))
+            // Spherical vs ellipsoidal earth
+            XCTAssertEqual(expected, ranges[index], accuracy: expected * 0.005 + 0.01)
+        }
+    }
+
+    func testBearings() {
+        var kernel = RangeBearingKernel()
+        kernel.append(latitude: 39.0, longitude: -77.0)
+        kernel.append(latitude: 38.0, longitude: -77.0)
+        kernel.append(latitude: 38.5, longitude: -76.0)
+        kernel.append(latitude: 38.5, longitude: -78.0)
+        XCTAssertEqual(0.0, kernel.bearing(fromLatitude: 38.5, longitude: -77.0, to: 0), accuracy: 0.001)
+        XCTAssertEqual(180.0, kernel.bearing(fromLatitude: 38.5, longitude: -77.0, to: 1), accuracy: 0.001)
+        XCTAssertEqual(90.0, kernel.bearing(fromLatitude: 38.5, longitude: -77.0, to: 2), accuracy: 0.5)
+        XCTAssertEqual(270.0, kernel.bearing(fromLatitude: 38.5, longitude: -77.0, to: 3), accuracy: 0.5)
+    }
+
+    func testNearestStaysExactAsEveryoneMoves() {
+        var tracker = NearestContactsTracker(k: 5, slack: 200)
+        var positions: [String: (Double, Double)] = [:]
+        for (index, point) in randomPositions(count: 1_000, seed: 2).enumerated() {
+            positions["contact-\(index)"] = point
+            tracker.upsertContact(uid: "contact-\(index)", latitude: point.0, longitude: point.1)
+        }
+
+        var generator = SeededGenerator(seed: 3)
+        var latitude = 38.9
+        var longitude = -77.1
+        for step in 0..<300 {
+            // Walking ~10m per fix
+            latitude += 0.00009
+            longitude += 0.00005
+            tracker.updateSelf(latitude: latitude, longitude: longitude)
+
+            // A few contacts report, one drops out, one joins
+            for _ in 0..<5 {
+                let uid = "contact-\(Int.random(in: 0..<1_000, using: &generator))"
+                guard let position = positions[uid] else { continue }
+                let moved = (position.0 + Double.random(in: -0.002...0.002, using: &generator), position.1 + Double.random(in: -0.002...0.002, using: &generator))
+                positions[uid] = moved
+                tracker.upsertContact(uid: uid, latitude: moved.0, longitude: moved.1)
+            }
+            if(step % 10 == 0) {
+                let removed = "contact-\(Int.random(in: 0..<1_000, using: &generator))"
+                positions.removeValue(forKey: removed)
+                tracker.removeContact(uid: removed)
+                let added = "new-\(step)"
+                positions[added] = (latitude + 0.0003, longitude)
+                tracker.upsertContact(uid: added, latitude: latitude + 0.0003, longitude: longitude)
+            }
+
+            XCTAssertEqual(bruteForceNearest(positions, latitude: latitude, longitude: longitude, k: 5), tracker.nearest().map { $0.uid }, "step \(step)")
+        }
+        // 300 fixes over ~3km with 200m of slack
+        XCTAssertLessThan(tracker.fullPassCount, 60)
+    }
+
+    func testFewerContactsThanK() {
+        var tracker = NearestContactsTracker(k: 10)
+        tracker.updateSelf(latitude: 38.9, longitude: -77.1)
+        XCTAssertTrue(tracker.nearest().isEmpty)
+        tracker.upsertContact(uid: "a", latitude: 38.91, longitude: -77.1)
+        tracker.upsertContact(uid: "b", latitude: 38.90, longitude: -77.1)
+        XCTAssertEqual(["b", "a"], tracker.nearest().map { $0.uid })
+        tracker.removeContact(uid: "b")
+        XCTAssertEqual(["a"], tracker.nearest().map { $0.uid })
+    }
+
+    func testBatchRangePerformanceWithTenThousandContacts() {
+        var kernel = RangeBearingKernel()
+        for point in randomPositions(count: 10_000, seed: 4) {
+            kernel.append(latitude: point.0, longitude: point.1)
+        }
+        var ranges: [Double] = []
+        measure {
+            for _ in 0..<100 {
+                kernel.ranges(fromLatitude: 38.9, longitude: -77.1, into: &ranges)
+            }
+        }
+    }
+
+    func testIncrementalNearestPerformanceWithTenThousandContacts() {
+        var tracker = NearestContactsTracker(k: 10)
+        for (index, point) in randomPositions(count: 10_000, seed: 5).enumerated() {
+            tracker.upsertContact(uid: "contact-\(index)", latitude: point.0, longitude: point.1)
+        }
+        var latitude = 38.9
+        measure {
+            // A minute of 1 Hz fixes at walking pace
+            for _ in 0..<60 {
+                latitude += 0.00001
+                tracker.updateSelf(latitude: latitude, longitude: -77.1)
+                _ = tracker.nearest()
+            }
+        }
+    }
+}
@@ -0,0 +1,96 @@
+//
+//  PrivateKeyPoolTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Crypto
+import _CryptoExtras
+import Foundation
+import SwiftASN1
+import X509
+import XCTest
+
+final class PrivateKeyPoolTests: TAKTrackerTestCase {
+    let privateKeyTag = "tak.flighttactics.com-pool-test-pk"
+
+    override func tearDownWithError() throws {
+        let dictionary = [kSecClass as String: kSecClassKey]
+        SecItemDelete(dictionary as CFDictionary)
+    }
+
+    func testPreparedKeyIsHandedOutOnce() throws {
+        let pool = PrivateKeyPool()
+        pool.prepare(keyType: .ecdsaP256)
+
+        XCTAssertTrue(pool.hasPreparedKey(keyType: .ecdsaP256))
+        XCTAssertNotNil(pool.lastGenerationTime(keyType: .ecdsaP256))
+        let first = try pool.takeKey(keyType: .ecdsaP256)
+        XCTAssertFalse(pool.hasPreparedKey(keyType: .ecdsaP256))
+        let second = try pool.takeKey(keyType: .ecdsaP256)
+        XCTAssertNotEqual(SecKeyCopyExternalRepresentation(first, nil) as Data?, SecKeyCopyExternalRepresentation(second, nil) as Data?)
+    }
+
+    func testKeysAreKeptPerType() throws {
+        let pool = PrivateKeyPool()
+        pool.prepare(keyType: .rsa2048)
+
+        XCTAssertFalse(pool.hasPreparedKey(keyType: .ecdsaP256))
+        let key = try pool.takeKey(keyType: .rsa2048)
+        let attributes = SecKeyCopyAttributes(key) as? [String: Any]
+        XCTAssertEqual(2048, attributes?[kSecAttrKeySizeInBits as String] as? Int)
+    }
+
+    func testStoredKeyIsNotPermanentUntilStored() throws {
+        let key = try CertificateManager.generatePrivateKey(keyType: .ecdsaP256)
+        let query: [NSString: Any] = [
+            kSecClass: kSecClassKey,
+            kSecAttrApplicationTag: privateKeyTag.data(using: .utf8)!,
+            kSecReturnRef: true ]
+        var resultRef: AnyObject?
+        XCTAssertEqual(errSecItemNotFound, SecItemCopyMatching(query as CFDictionary, &resultRef))
+
+        _ = try CertificateManager.storePrivateKey(key, privateKeyTag: privateKeyTag)
+        XCTAssertEqual(errSecSuccess, SecItemCopyMatching(query as CFDictionary, &resultRef))
+    }
+
+    func testECDSASigningRequest() throws {
+        let key = try CertificateManager.generatePrivateKey(keyType: .ecdsaP256)
+        let keyData = try CertificateManager.storePrivateKey(key, privateKeyTag: privateKeyTag)
+        let swiftCryptoKey = try P256.Signing.PrivateKey(x963Representation: keyData)
+
+        let requestor = CSRRequestor()
+        requestor.generateSigningRequest(commonName: "foyc", hostName: "tak.example.com", organizationName: "TAK", organizationUnitName: "Tracker", privateKey: swiftCryptoKey)
+
+        let csr = try CertificateSigningRequest(derEncoded: requestor.derEncodedCertificate)
+        XCTAssertEqual(.ecdsaWithSHA256, csr.signatureAlgorithm)
+        XCTAssertEqual(Certificate.PublicKey(swiftCryptoKey.publicKey), csr.publicKey)
+        XCTAssertEqual(swiftCryptoKey.derRepresentation, requestor.derEncodedPrivateKey)
+    }
+
+    func testRSASigningRequestFromTaggedKey() throws {
+        let keyData = try CertificateManager.generateTaggedPrivateKey(privateKeyTag: privateKeyTag)
+        let swiftCryptoKey = try _RSA.Signing.PrivateKey(derRepresentation: keyData)
+
+        let requestor = CSRRequestor()
+        requestor.generateSigningRequest(commonName: "foyc", hostName: "tak.example.com", organizationName: "TAK", organizationUnitName: "Tracker", privateKey: swiftCryptoKey)
+
+        let csr = try CertificateSigningRequest(derEncoded: requestor.derEncodedCertificate)
+        XCTAssertEqual(.sha256WithRSAEncryption, csr.signatureAlgorithm)
+    }
+
+    // Key generation timings, one per key type
+
+    func testRSAKeyGenerationTime() {
+        measure {
+            XCTAssertNoThrow(try CertificateManager.generatePrivateKey(keyType: .rsa2048))
+        }
+    }
+
+    func testECDSAKeyGenerationTime() {
+        measure {
+            XCTAssertNoThrow(try CertificateManager.generatePrivateKey(keyType: .ecdsaP256))
+        }
+    }
+}
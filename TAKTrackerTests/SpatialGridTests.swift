@@ -0,0 +1,123 @@
+//
+//  SpatialGridTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import MapKit
+import XCTest
+
+final class SpatialGridTests: TAKTrackerTestCase {
+    let viewport = CoordinateBounds(minLatitude: 38.8, maxLatitude: 38.9, minLongitude: -77.1, maxLongitude: -77.0)
+
+    // Scattered over roughly a 200km square around the viewport
+    func randomPoints(count: Int, seed: UInt64) -> [(Double, Double)] {
+        var generator = SeededGenerator(seed: seed)
+        return (0..<count).map { _ in
+            (Double.random(in: 38.0...40.0, using: &generator), Double.random(in: -78.0 ... -76.0, using: &generator))
+        }
+    }
+
+    func bruteForce(_ points: [(Double, Double)], in bounds: CoordinateBounds) -> Set<Int> {
+        return Set(points.indices.filter { bounds.contains(latitude: points[$0].0, longitude: points[$0].1) })
+    }
+
+    func testQueryMatchesLinearScan() {
+        var points = randomPoints(count: 2_000, seed: 1)
+        var grid = SpatialGrid()
+        for point in points {
+            _ = grid.append(latitude: point.0, longitude: point.1)
+        }
+        XCTAssertEqual(bruteForce(points, in: viewport), Set(grid.query(viewport)))
+
+        // Move some, remove some, and check again
+        var generator = SeededGenerator(seed: 2)
+        for id in stride(from: 0, to: points.count, by: 3) {
+            points[id] = (points[id].0 + Double.random(in: -0.2...0.2, using: &generator), points[id].1 + Double.random(in: -0.2...0.2, using: &generator))
+            grid.move(id, latitude: points[id].0, longitude: points[id].1)
+        }
+        for id in stride(from: points.count - 1, to: 0, by: -7) {
+            grid.swapRemove(id)
+            points.swapAt(id, points.count - 1)
+            points.removeLast()
+        }
+        XCTAssertEqual(points.count, grid.count)
+        XCTAssertEqual(bruteForce(points, in: viewport), Set(grid.query(viewport)))
+
+        // Zoomed far out covers more cells than are occupied
+        let wide = CoordinateBounds(minLatitude: -60, maxLatitude: 60, minLongitude: -170, maxLongitude: 170)
+        XCTAssertEqual(Set(points.indices), Set(grid.query(wide)))
+    }
+
+    func testQueryAcrossAntimeridian() {
+        var grid = SpatialGrid()
+        let east = grid.append(latitude: -17.7, longitude: 179.9)
+        let west = grid.append(latitude: -17.7, longitude: -179.9)
+        _ = grid.append(latitude: -17.7, longitude: 170.0)
+
+        let region = MKCoordinateRegion(center: CLLocationCoordinate2D(latitude: -17.7, longitude: 180.0), span: MKCoordinateSpan(latitudeDelta: 1.0, longitudeDelta: 1.0))
+        let bounds = CoordinateBounds(region: region)
+        XCTAssertTrue(bounds.crossesAntimeridian)
+        XCTAssertEqual(Set([east, west]), Set(grid.query(bounds)))
+    }
+
+    func testContactStoreViewportQuery() {
+        let start = Date(timeIntervalSince1970: 1_000_000)
+        let store = ContactStore(start: start)
+        let points = randomPoints(count: 1_000, seed: 3)
+        store.upsert(points.enumerated().map { index, point in
+            ContactRecord(uid: "contact-\(index)", type: "a-f-G", callsign: "C\(index)", group: "Cyan", role: "Team Member", latitude: point.0, longitude: point.1, heightAboveEllipsoid: 0, speed: 0, course: 0, time: start, stale: start.addingTimeInterval(60 + Double(index)))
+        })
+        // Expire a few hundred so the grid has been through swap removals
+        store.expire(now: start.addingTimeInterval(400))
+
+        let expected = store.snapshot().contacts.filter { viewport.contains(latitude: $0.latitude, longitude: $0.longitude) }
+        XCTAssertEqual(Set(expected.map { $0.uid }), Set(store.contacts(in: viewport).map { $0.uid }))
+    }
+
+    func measureQueries(count: Int) {
+        var grid = SpatialGrid()
+        for point in randomPoints(count: count, seed: 4) {
+            _ = grid.append(latitude: point.0, longitude: point.1)
+        }
+        measure {
+            for step in 0..<100 {
+                let offset = Double(step) * 0.01
+                _ = grid.query(CoordinateBounds(minLatitude: 38.8 + offset, maxLatitude: 38.9 + offset, minLongitude: -77.1 + offset, maxLongitude: -77.0 + offset))
+            }
+        }
+    }
+
+    func measureUpdates(count: Int) {
+        var grid = SpatialGrid()
+        var points = randomPoints(count: count, seed: 5)
+        for point in points {
+            _ = grid.append(latitude: point.0, longitude: point.1)
+        }
+        measure {
+            // One position report from every contact, each moving ~50m
+            for id in 0..<points.count {
+                points[id] = (points[id].0 + 0.0005, points[id].1 - 0.0005)
+                grid.move(id, latitude: points[id].0, longitude: points[id].1)
+            }
+        }
+    }
+
+    func testViewportQueryPerformanceWithTenThousandContacts() {
+        measureQueries(count: 10_000)
+    }
+
+    func testViewportQueryPerformanceWithFiftyThousandContacts() {
+        measureQueries(count: 50_000)
+    }
+
+    func testUpdatePerformanceWithTenThousandContacts() {
+        measureUpdates(count: 10_000)
+    }
+
+    func testUpdatePerformanceWithFiftyThousandContacts() {
+        measureUpdates(count: 50_000)
+    }
+}
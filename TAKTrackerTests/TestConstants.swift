@@ -15,4 +15,5 @@ struct TestConstants {
     static let CERTIFICATE_FILE_EXTENSION = "p12"
     static let DEFAULT_CERT_PASSWORD = "atakatak"
     static let TEST_HOST = "tak.flighttactics.com"
+    static let SAMPLE_TRACK_NAME = "sample-track"
 }
@@ -0,0 +1,69 @@
+//
+//  TimingWheelTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import XCTest
+
+final class TimingWheelTests: TAKTrackerTestCase {
+    let start = Date(timeIntervalSince1970: 1_000_000)
+
+    func testEntriesExpireAtTheirDeadline() {
+        var wheel = TimingWheel<String>(start: start)
+        wheel.schedule("a", at: start.addingTimeInterval(5))
+        wheel.schedule("b", at: start.addingTimeInterval(2.5))
+        XCTAssertEqual(2, wheel.count)
+
+        XCTAssertTrue(wheel.advance(to: start.addingTimeInterval(2)).isEmpty)
+        XCTAssertEqual(["b"], wheel.advance(to: start.addingTimeInterval(3)).map { $0.key })
+        XCTAssertTrue(wheel.advance(to: start.addingTimeInterval(4.9)).isEmpty)
+        XCTAssertEqual(["a"], wheel.advance(to: start.addingTimeInterval(5)).map { $0.key })
+        XCTAssertTrue(wheel.isEmpty)
+    }
+
+    func testPastDeadlinesExpireOnNextAdvance() {
+        var wheel = TimingWheel<String>(start: start)
+        wheel.schedule("late", at: start.addingTimeInterval(-10))
+        XCTAssertEqual(["late"], wheel.advance(to: start).map { $0.key })
+    }
+
+    func testEntriesCascadeFromUpperLevels() {
+        var wheel = TimingWheel<Int>(start: start)
+        // One entry per level, plus one beyond the top level
+        let offsets: [TimeInterval] = [10, 100, 5_000, 300_000, 20_000_000]
+        for (index, offset) in offsets.enumerated() {
+            wheel.schedule(index, at: start.addingTimeInterval(offset))
+        }
+
+        var expired: [Int] = []
+        var time = start
+        while(!wheel.isEmpty) {
+            time = time.addingTimeInterval(3_600)
+            for entry in wheel.advance(to: time) {
+                XCTAssertLessThanOrEqual(entry.deadline, time)
+                XCTAssertGreaterThan(entry.deadline, time.addingTimeInterval(-3_600))
+                expired.append(entry.key)
+            }
+        }
+        XCTAssertEqual([0, 1, 2, 3, 4], expired)
+    }
+
+    func testEmptyWheelSkipsAhead() {
+        var wheel = TimingWheel<String>(start: start)
+        XCTAssertTrue(wheel.advance(to: start.addingTimeInterval(86_400 * 365)).isEmpty)
+        XCTAssertEqual(start.addingTimeInterval(86_400 * 365), wheel.currentTime)
+    }
+
+    func testSchedulingPerformance() {
+        measure {
+            var wheel = TimingWheel<Int>(start: start)
+            for index in 0..<100_000 {
+                wheel.schedule(index, at: start.addingTimeInterval(TimeInterval(index % 600)))
+            }
+            XCTAssertEqual(100_000, wheel.advance(to: start.addingTimeInterval(600)).count)
+        }
+    }
+}
@@ -0,0 +1,108 @@
+//
+//  TrackStoreTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import Foundation
+import XCTest
+
+final class TrackStoreTests: TAKTrackerTestCase {
+    var fileURL: URL!
+
+    override func setUpWithError() throws {
+        fileURL = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString, isDirectory: true)
+            .appendingPathComponent("track.bin")
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: fileURL.deletingLastPathComponent())
+    }
+
+    func fix(at time: TimeInterval) -> TrackFix {
+        return TrackFix(time: time, latitude: 38.0 + time / 1000.0, longitude: -77.0, heightAboveEllipsoid: 10, speed: 1.5, course: 90, horizontalAccuracy: 5)
+    }
+
+    func testAppendAndReadBack() throws {
+        let store = try TrackStore(fileURL: fileURL, capacity: 16)
+        XCTAssertTrue(store.append(fix(at: 100)))
+        XCTAssertTrue(store.append(fix(at: 101)))
+        XCTAssertEqual(2, store.count)
+        XCTAssertEqual(fix(at: 100), store[0])
+        XCTAssertEqual(fix(at: 101), store[1])
+    }
+
+    func testOutOfOrderAndTooSoonFixesAreDropped() throws {
+        let store = try TrackStore(fileURL: fileURL, capacity: 16, minimumInterval: 1.0)
+        XCTAssertTrue(store.append(fix(at: 100)))
+        XCTAssertFalse(store.append(fix(at: 99)))
+        XCTAssertFalse(store.append(fix(at: 100.5)))
+        XCTAssertTrue(store.append(fix(at: 101)))
+        XCTAssertEqual(2, store.count)
+    }
+
+    func testTimeRangeQuery() throws {
+        let store = try TrackStore(fileURL: fileURL, capacity: 128)
+        for time in stride(from: 0.0, to: 100.0, by: 1.0) {
+            store.append(fix(at: 1000 + time))
+        }
+        let range = store.indices(from: Date(timeIntervalSince1970: 1010), to: Date(timeIntervalSince1970: 1019))
+        XCTAssertEqual(10..<20, range)
+
+        let fixes = store.fixes(from: Date(timeIntervalSince1970: 1010.5), to: Date(timeIntervalSince1970: 1012))
+        XCTAssertEqual([fix(at: 1011), fix(at: 1012)], fixes)
+
+        XCTAssertTrue(store.indices(from: Date(timeIntervalSince1970: 0), to: Date(timeIntervalSince1970: 999)).isEmpty)
+        XCTAssertTrue(store.indices(from: Date(timeIntervalSince1970: 1020), to: Date(timeIntervalSince1970: 1010)).isEmpty)
+    }
+
+    func testRingOverwritesOldestFixes() throws {
+        let store = try TrackStore(fileURL: fileURL, capacity: 8)
+        for time in 0..<20 {
+            store.append(fix(at: TimeInterval(time)))
+        }
+        XCTAssertEqual(8, store.count)
+        XCTAssertEqual(fix(at: 12), store[0])
+        XCTAssertEqual(fix(at: 19), store[7])
+        XCTAssertEqual(2..<5, store.indices(from: Date(timeIntervalSince1970: 14), to: Date(timeIntervalSince1970: 16)))
+    }
+
+    func testTrackSurvivesReopening() throws {
+        var store: TrackStore? = try TrackStore(fileURL: fileURL, capacity: 8)
+        for time in 0..<12 {
+            store!.append(fix(at: TimeInterval(time)))
+        }
+        store = nil
+
+        // A different requested capacity keeps the existing file's layout
+        let reopened = try TrackStore(fileURL: fileURL, capacity: 1024)
+        XCTAssertEqual(8, reopened.capacity)
+        XCTAssertEqual(8, reopened.count)
+        XCTAssertEqual(fix(at: 4), reopened[0])
+        XCTAssertEqual(fix(at: 11), reopened[7])
+        XCTAssertTrue(reopened.append(fix(at: 12)))
+        XCTAssertEqual(fix(at: 12), reopened[7])
+    }
+
+    func testCorruptFileIsReplaced() throws {
+        try FileManager.default.createDirectory(at: fileURL.deletingLastPathComponent(), withIntermediateDirectories: true)
+        try Data("not a track".utf8).write(to: fileURL)
+        let store = try TrackStore(fileURL: fileURL, capacity: 4)
+        XCTAssertEqual(0, store.count)
+        XCTAssertEqual(4, store.capacity)
+    }
+
+    func testAppendPerformanceOverAShift() throws {
+        let store = try TrackStore(fileURL: fileURL, capacity: 43_200, minimumInterval: 0)
+        var time = 0.0
+        measure {
+            store.removeAll()
+            for _ in 0..<43_200 {
+                store.append(fix(at: time))
+                time += 1
+            }
+        }
+    }
+}
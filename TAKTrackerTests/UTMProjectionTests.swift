@@ -0,0 +1,86 @@
+//
+//  UTMProjectionTests.swift
+//  TAKTrackerTests
+//
+//  Created by Cory Foy on 10/19/26.
+//
+
+import grid_ios
+import mgrs_ios
+import XCTest
+
+final class UTMProjectionTests: TAKTrackerTestCase {
+    // The older formula in UTM.from is good to a few centimeters
+    // within 3 degrees of the central meridian
+    static let PARITY_TOLERANCE_METERS = 0.05
+    // Norway and Svalbard zones run further from their meridians
+    static let WIDE_ZONE_TOLERANCE_METERS = 0.1
+    static let METERS_PER_DEGREE = 111_320.0
+
+    // Latitude, longitude and zone, within `offset` degrees of the zone's meridian
+    func randomPoints(count: Int, seed: UInt64, latitudes: ClosedRange<Double> = -80.0...84.0, zones: [Int] = Array(1...60), offset: Double = 3.0) -> [(Double, Double, Int)] {
+        var generator = SeededGenerator(seed: seed)
+        return (0..<count).map { _ in
+            let zone = zones.randomElement(using: &generator)!
+            return (Double.random(in: latitudes, using: &generator),
+                    UTMProjection.centralMeridian(zone: zone) + Double.random(in: -offset...offset, using: &generator),
+                    zone)
+        }
+    }
+
+    func assertForwardParity(_ points: [(Double, Double, Int)], tolerance: Double) {
+        for (latitude, longitude, zone) in points {
+            let expected = UTM.from(GridPoint(longitude, latitude), zone)
+            let actual = UTMProjection.forward(latitude: latitude, longitude: longitude, zone: zone)
+            XCTAssertEqual(expected.zone, actual.zone)
+            XCTAssertEqual(expected.hemisphere == Hemisphere.NORTH, actual.isNorthern)
+            XCTAssertEqual(expected.easting, actual.easting, accuracy: tolerance, "\(latitude), \(longitude)")
+            XCTAssertEqual(expected.northing, actual.northing, accuracy: tolerance, "\(latitude), \(longitude)")
+        }
+    }
+
+    func testKnownCoordinate() {
+        let utm = UTMProjection.forward(latitude: 38.8856, longitude: -76.9953, zone: 18)
+        XCTAssertEqual(18, utm.zone)
+        XCTAssertTrue(utm.isNorthern)
+        XCTAssertEqual(326938.107, utm.easting, accuracy: 0.001)
+        XCTAssertEqual(4305973.759, utm.northing, accuracy: 0.001)
+    }
+
+    func testCentralMeridianAndEquator() {
+        let utm = UTMProjection.forward(latitude: 0.0, longitude: 3.0, zone: 31)
+        XCTAssertEqual(500000.0, utm.easting, accuracy: 1e-9)
+        XCTAssertEqual(0.0, utm.northing, accuracy: 1e-9)
+
+        let south = UTMProjection.forward(latitude: -0.000001, longitude: 3.0, zone: 31)
+        XCTAssertFalse(south.isNorthern)
+        XCTAssertEqual(10000000.0, south.northing, accuracy: 1.0)
+    }
+
+    func testForwardMatchesUTMFrom() {
+        assertForwardParity(randomPoints(count: 20_000, seed: 21), tolerance: UTMProjectionTests.PARITY_TOLERANCE_METERS)
+    }
+
+    func testForwardMatchesUTMFromInNorwayAndSvalbard() {
+        assertForwardParity(randomPoints(count: 2_000, seed: 22, latitudes: 56.0...64.0, zones: [32], offset: 3.0), tolerance: UTMProjectionTests.WIDE_ZONE_TOLERANCE_METERS)
+        assertForwardParity(randomPoints(count: 2_000, seed: 23, latitudes: 72.0...84.0, zones: [31, 33, 35, 37], offset: 9.0), tolerance: UTMProjectionTests.WIDE_ZONE_TOLERANCE_METERS)
+    }
+
+    func testUTMFromPerformance() {
+        let points = randomPoints(count: 10_000, seed: 27)
+        measure {
+            for (latitude, longitude, zone) in points {
+                _ = UTM.from(GridPoint(longitude, latitude), zone)
+            }
+        }
+    }
+
+    func testForwardPerformance() {
+        let points = randomPoints(count: 10_000, seed: 27)
+        measure {
+            for (latitude, longitude, zone) in points {
+                _ = UTMProjection.forward(latitude: latitude, longitude: longitude, zone: zone)
+            }
+        }
+    }
+}